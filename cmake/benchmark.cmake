@@ -0,0 +1,51 @@
+function(download_benchmark)
+  find_package(benchmark QUIET)
+  if(benchmark_FOUND)
+    message(STATUS "Found google benchmark ${benchmark_VERSION}")
+    return()
+  endif()
+
+  include(FetchContent)
+
+  set(benchmark_URL  "https://github.com/google/benchmark/archive/refs/tags/v1.8.3.tar.gz")
+  set(benchmark_HASH "SHA256=6bc180a57d23d4d9515519f92b0c83d61b05b5bab188961f36ac7b06b0d9e9ce")
+
+  # If you don't have access to the Internet,
+  # please pre-download google benchmark
+  set(possible_file_locations
+    $ENV{HOME}/Downloads/benchmark-1.8.3.tar.gz
+    ${PROJECT_SOURCE_DIR}/benchmark-1.8.3.tar.gz
+    ${PROJECT_BINARY_DIR}/benchmark-1.8.3.tar.gz
+    /tmp/benchmark-1.8.3.tar.gz
+  )
+
+  foreach(f IN LISTS possible_file_locations)
+    if(EXISTS ${f})
+      set(benchmark_URL  "${f}")
+      file(TO_CMAKE_PATH "${benchmark_URL}" benchmark_URL)
+      break()
+    endif()
+  endforeach()
+
+  set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_GTEST_TESTS OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+  set(BENCHMARK_INSTALL_DOCS OFF CACHE BOOL "" FORCE)
+
+  FetchContent_Declare(benchmark
+    URL               ${benchmark_URL}
+    URL_HASH          ${benchmark_HASH}
+  )
+
+  FetchContent_GetProperties(benchmark)
+  if(NOT benchmark_POPULATED)
+    message(STATUS "Downloading google benchmark from ${benchmark_URL}")
+    FetchContent_Populate(benchmark)
+  endif()
+  message(STATUS "google benchmark is downloaded to ${benchmark_SOURCE_DIR}")
+  message(STATUS "google benchmark's binary dir is ${benchmark_BINARY_DIR}")
+
+  add_subdirectory(${benchmark_SOURCE_DIR} ${benchmark_BINARY_DIR} EXCLUDE_FROM_ALL)
+endfunction()
+
+download_benchmark()
@@ -0,0 +1,198 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/async-online-feature.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/log.h"
+
+namespace knf {
+
+template <class C>
+AsyncOnlineFeature<C>::AsyncOnlineFeature(
+    const FeatureExtractorConfig<C> &config, ThreadPool *pool,
+    const AsyncOnlineFeatureOptions &opts /*= {}*/,
+    Callback callback /*= nullptr*/)
+    : feature_(config),
+      pool_(pool),
+      callback_(std::move(callback)),
+      dim_(feature_.Dim()),
+      frame_shift_in_seconds_(feature_.FrameShiftInSeconds()),
+      queue_(opts.max_pending_chunks) {
+  KNF_CHECK(pool_ != nullptr);
+}
+
+template <class C>
+AsyncOnlineFeature<C>::~AsyncOnlineFeature() {
+  Wait();
+}
+
+template <class C>
+bool AsyncOnlineFeature<C>::AcceptWaveformAsync(float sampling_rate,
+                                                const float *waveform,
+                                                int32_t n) {
+  if (n == 0) {
+    return true;  // Nothing to do.
+  }
+
+  Chunk chunk;
+  chunk.sampling_rate = sampling_rate;
+  chunk.samples.assign(waveform, waveform + n);
+  return Push(std::move(chunk));
+}
+
+template <class C>
+bool AsyncOnlineFeature<C>::InputFinishedAsync() {
+  Chunk chunk;
+  chunk.input_finished = true;
+  return Push(std::move(chunk));
+}
+
+template <class C>
+bool AsyncOnlineFeature<C>::Push(Chunk &&chunk) {
+  if (!queue_.TryPush(std::move(chunk))) {
+    return false;
+  }
+
+  // It pairs with the fence in Process(). Either we see scheduled_ == false
+  // and schedule a task, or the running task sees the chunk we just pushed.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  Schedule();
+  return true;
+}
+
+template <class C>
+void AsyncOnlineFeature<C>::Schedule() {
+  bool expected = false;
+  if (!scheduled_.compare_exchange_strong(expected, true)) {
+    return;  // the running task will process the queue
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    ++num_running_tasks_;
+  }
+
+  pool_->Submit([this]() { Process(); });
+}
+
+template <class C>
+void AsyncOnlineFeature<C>::Process() {
+  while (true) {
+    bool processed = false;
+    int32_t num_frames;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      Chunk chunk;
+      while (queue_.TryPop(&chunk)) {
+        if (!chunk.samples.empty()) {
+          feature_.AcceptWaveform(chunk.sampling_rate, chunk.samples.data(),
+                                  chunk.samples.size());
+        }
+
+        if (chunk.input_finished) {
+          feature_.InputFinished();
+        }
+        processed = true;
+      }
+
+      num_frames = feature_.NumFramesReady();
+    }
+
+    num_frames_ready_.store(num_frames, std::memory_order_release);
+
+    if (processed && callback_) {
+      callback_(num_frames);
+    }
+
+    scheduled_.store(false);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    // A producer may have pushed a chunk after we drained the queue but
+    // before we cleared scheduled_, in which case it did not schedule a task.
+    if (queue_.Empty()) {
+      break;
+    }
+
+    bool expected = false;
+    if (!scheduled_.compare_exchange_strong(expected, true)) {
+      break;  // a new task has been scheduled by a producer
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(wait_mutex_);
+  --num_running_tasks_;
+  wait_cv_.notify_all();
+}
+
+template <class C>
+void AsyncOnlineFeature<C>::Wait() {
+  std::unique_lock<std::mutex> lock(wait_mutex_);
+  wait_cv_.wait(lock,
+                [this]() { return num_running_tasks_ == 0 && queue_.Empty(); });
+}
+
+template <class C>
+bool AsyncOnlineFeature<C>::IsLastFrame(int32_t frame) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return feature_.IsLastFrame(frame);
+}
+
+template <class C>
+void AsyncOnlineFeature<C>::GetFrame(int32_t frame, float *out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const float *p = feature_.GetFrame(frame);
+  std::copy(p, p + dim_, out);
+}
+
+template <class C>
+void AsyncOnlineFeature<C>::GetHalfFrame(int32_t frame, uint16_t *out) const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const uint16_t *p = feature_.GetHalfFrame(frame);
+  std::copy(p, p + dim_, out);
+}
+
+template <class C>
+void AsyncOnlineFeature<C>::Pop(int32_t n) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  feature_.Pop(n);
+}
+
+template <class C>
+ProfileStats AsyncOnlineFeature<C>::GetStats() const {
+#if KNF_ENABLE_PROFILING
+  ProfileStats stats;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats = feature_.GetStats();
+  }
+  stats.queue_depth = queue_.Size();
+  return stats;
+#else
+  return {};
+#endif
+}
+
+template class AsyncOnlineFeature<FbankComputer>;
+template class AsyncOnlineFeature<MfccComputer>;
+template class AsyncOnlineFeature<WhisperFeatureComputer>;
+
+}  // namespace knf
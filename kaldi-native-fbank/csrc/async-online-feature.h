@@ -0,0 +1,181 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_ASYNC_ONLINE_FEATURE_H_
+#define KALDI_NATIVE_FBANK_CSRC_ASYNC_ONLINE_FEATURE_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/bounded-queue.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/thread-pool.h"
+
+namespace knf {
+
+struct AsyncOnlineFeatureOptions {
+  // Maximum number of chunks of a stream that are queued but not processed
+  // yet. AcceptWaveformAsync() returns false once it is reached.
+  // It is rounded up to a power of 2.
+  int32_t max_pending_chunks = 64;
+
+  std::string ToString() const {
+    std::ostringstream os;
+    os << "AsyncOnlineFeatureOptions(";
+    os << "max_pending_chunks=" << max_pending_chunks << ")";
+    return os.str();
+  }
+};
+
+/// A stream whose features are computed asynchronously by a ThreadPool.
+///
+/// AcceptWaveformAsync() copies the samples into a bounded lock-free queue
+/// and returns immediately. A task is scheduled on the pool to process the
+/// queue. At most one task of a stream runs at a time, so the order of the
+/// input and of the frames is preserved. Different streams can share the
+/// same pool.
+///
+/// When new frames are ready, the callback (if any) is invoked on the worker
+/// thread with the number of frames ready. Alternatively, use Wait() to block
+/// until all queued input has been processed.
+///
+/// All methods are thread-safe. AcceptWaveformAsync() and
+/// InputFinishedAsync() can be called from multiple threads, though the order
+/// of the samples is then the order in which the calls are made.
+template <class C>
+class AsyncOnlineFeature {
+ public:
+  using Callback = std::function<void(int32_t num_frames_ready)>;
+
+  /// @param config  It is used to construct the underlying stream.
+  /// @param pool  Not owned. It must outlive this object.
+  /// @param opts  Options for the queue.
+  /// @param callback  If not empty, it is called on a worker thread after
+  ///                  some input has been processed. It must not destroy
+  ///                  this object.
+  AsyncOnlineFeature(const FeatureExtractorConfig<C> &config, ThreadPool *pool,
+                     const AsyncOnlineFeatureOptions &opts = {},
+                     Callback callback = nullptr);
+
+  // It waits until all queued input is processed
+  ~AsyncOnlineFeature();
+
+  AsyncOnlineFeature(const AsyncOnlineFeature &) = delete;
+  AsyncOnlineFeature &operator=(const AsyncOnlineFeature &) = delete;
+
+  int32_t Dim() const { return dim_; }
+
+  float FrameShiftInSeconds() const { return frame_shift_in_seconds_; }
+
+  /// Queue samples for feature computation.
+  ///
+  /// @return Return false if the queue is full. Nothing is queued in this
+  ///         case and the caller can retry later, e.g., after Wait().
+  bool AcceptWaveformAsync(float sampling_rate, const float *waveform,
+                           int32_t n);
+
+  /// Like OnlineGenericBaseFeature::InputFinished(), but it is processed
+  /// after all previously queued input.
+  ///
+  /// @return Return false if the queue is full.
+  bool InputFinishedAsync();
+
+  /// Block until all input queued before this call has been processed.
+  void Wait();
+
+  /// Number of frames computed so far. It does not include frames of input
+  /// that is still in the queue.
+  int32_t NumFramesReady() const {
+    return num_frames_ready_.load(std::memory_order_acquire);
+  }
+
+  // Note: It returns true only if InputFinishedAsync() has been processed
+  // and this frame is the last frame.
+  bool IsLastFrame(int32_t frame) const;
+
+  /// Copy a frame to out, which is of size Dim(). The frame
+  /// must be < NumFramesReady(). It is valid only if
+  /// frame_opts.output_dtype is "float32".
+  void GetFrame(int32_t frame, float *out) const;
+
+  /// Like GetFrame(), but valid only if frame_opts.output_dtype is
+  /// "float16" or "bfloat16". See OnlineGenericBaseFeature::GetHalfFrame()
+  void GetHalfFrame(int32_t frame, uint16_t *out) const;
+
+  // discard the first n frames
+  void Pop(int32_t n);
+
+  // Like OnlineGenericBaseFeature::GetStats(), with queue_depth set to
+  // the number of queued chunks. See profiling.h
+  ProfileStats GetStats() const;
+
+ private:
+  struct Chunk {
+    // The input is resampled by feature_ if it differs from the one
+    // in the options
+    float sampling_rate = 0;
+    std::vector<float> samples;
+    bool input_finished = false;
+  };
+
+  // Push a chunk and schedule a task if needed
+  bool Push(Chunk &&chunk);
+
+  void Schedule();
+
+  // The task running on the pool
+  void Process();
+
+ private:
+  // Guarded by mutex_
+  OnlineGenericBaseFeature<C> feature_;
+  mutable std::mutex mutex_;
+
+  ThreadPool *pool_;  // not owned
+  Callback callback_;
+
+  int32_t dim_;
+  float frame_shift_in_seconds_;
+
+  BoundedQueue<Chunk> queue_;
+
+  // true if a task of this stream is running or is in the pool's queue
+  std::atomic<bool> scheduled_{false};
+
+  std::atomic<int32_t> num_frames_ready_{0};
+
+  // Number of tasks that have been submitted to the pool but not finished.
+  // Guarded by wait_mutex_.
+  int32_t num_running_tasks_ = 0;
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cv_;
+};
+
+using AsyncOnlineFbank = AsyncOnlineFeature<FbankComputer>;
+using AsyncOnlineMfcc = AsyncOnlineFeature<MfccComputer>;
+using AsyncOnlineWhisperFbank = AsyncOnlineFeature<WhisperFeatureComputer>;
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_ASYNC_ONLINE_FEATURE_H_
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_BOUNDED_QUEUE_H_
+#define KALDI_NATIVE_FBANK_CSRC_BOUNDED_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "kaldi-native-fbank/csrc/log.h"
+
+namespace knf {
+
+// A bounded lock-free queue with multiple producers and a single consumer.
+//
+// It is Dmitry Vyukov's bounded MPMC queue. See
+// https://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue
+//
+// Each slot has a sequence number that tells whether the slot is ready to be
+// written by a producer (seq == pos) or read by the consumer (seq == pos + 1).
+// Producers claim a position with a CAS on tail_. Since there is only one
+// consumer, head_ is advanced without a CAS.
+template <class T>
+class BoundedQueue {
+ public:
+  // @param capacity It is rounded up to a power of 2.
+  explicit BoundedQueue(int32_t capacity) {
+    KNF_CHECK_GT(capacity, 0);
+
+    size_t n = 1;
+    while (n < static_cast<size_t>(capacity)) {
+      n <<= 1;
+    }
+
+    mask_ = n - 1;
+    slots_ = std::make_unique<Slot[]>(n);
+    for (size_t i = 0; i != n; ++i) {
+      slots_[i].seq.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  BoundedQueue(const BoundedQueue &) = delete;
+  BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+  int32_t Capacity() const { return static_cast<int32_t>(mask_ + 1); }
+
+  // Thread-safe. Return false if the queue is full, in which case
+  // value is not moved.
+  bool TryPush(T &&value) {
+    size_t pos = tail_.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+      slot = &slots_[pos & mask_];
+      size_t seq = slot->seq.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (tail_.compare_exchange_weak(pos, pos + 1,
+                                        std::memory_order_relaxed)) {
+          break;
+        }
+      } else if (diff < 0) {
+        return false;  // full
+      } else {
+        pos = tail_.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->value = std::move(value);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Must be called only by the consumer. Return false if the queue is empty.
+  bool TryPop(T *value) {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    Slot *slot = &slots_[pos & mask_];
+    size_t seq = slot->seq.load(std::memory_order_acquire);
+    if (seq != pos + 1) {
+      return false;  // empty, or a producer has not finished writing
+    }
+
+    *value = std::move(slot->value);
+    head_.store(pos + 1, std::memory_order_relaxed);
+    slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Thread-safe but approximate if there are concurrent operations
+  int32_t Size() const {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    return tail > head ? static_cast<int32_t>(tail - head) : 0;
+  }
+
+  // Thread-safe but approximate if there are concurrent operations
+  bool Empty() const {
+    size_t pos = head_.load(std::memory_order_relaxed);
+    size_t seq = slots_[pos & mask_].seq.load(std::memory_order_acquire);
+    return seq != pos + 1;
+  }
+
+ private:
+  struct Slot {
+    std::atomic<size_t> seq{0};
+    T value;
+  };
+
+  std::unique_ptr<Slot[]> slots_;
+  size_t mask_ = 0;
+
+  // Put them on different cache lines to avoid false sharing between
+  // producers and the consumer
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_BOUNDED_QUEUE_H_
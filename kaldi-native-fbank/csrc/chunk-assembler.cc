@@ -0,0 +1,176 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/chunk-assembler.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/log.h"
+
+namespace knf {
+
+std::ostream &operator<<(std::ostream &os,
+                         const ChunkAssemblerOptions &opts) {
+  os << opts.ToString();
+  return os;
+}
+
+template <class C>
+ChunkAssembler<C>::ChunkAssembler(const ChunkAssemblerOptions &opts,
+                                  const OnlineGenericBaseFeature<C> *src)
+    : opts_(opts),
+      src_(src),
+      dim_(src->Dim()),
+      padding_(dim_, opts.padding_value) {
+  if (opts.chunk_size < 1 || opts.left_context < 0) {
+    fprintf(stderr, "Invalid chunk options:\n%s\n", opts.ToString().c_str());
+    exit(-1);
+  }
+
+  if (src->OutputDtype() != FeatureDtype::kFloat32) {
+    fprintf(stderr,
+            "ChunkAssembler requires frame_opts.output_dtype to be "
+            "float32\n");
+    exit(-1);
+  }
+
+  capacity_ = ChunkFrames();
+  ring_.resize(static_cast<int64_t>(capacity_) * dim_);
+}
+
+template <class C>
+int32_t ChunkAssembler<C>::FirstFrame() const {
+  return std::max(num_popped_chunks_ * opts_.chunk_size - opts_.left_context,
+                  0);
+}
+
+template <class C>
+void ChunkAssembler<C>::Grow() {
+  int32_t capacity = 2 * capacity_;
+  std::vector<float> ring(static_cast<int64_t>(capacity) * dim_);
+  for (int32_t f = FirstFrame(); f < num_frames_; ++f) {
+    memcpy(ring.data() + static_cast<int64_t>(f % capacity) * dim_, Row(f),
+           dim_ * sizeof(float));
+  }
+
+  capacity_ = capacity;
+  ring_.swap(ring);
+}
+
+template <class C>
+void ChunkAssembler<C>::Update() {
+  if (input_finished_) {
+    return;
+  }
+
+  int32_t n = src_->NumFramesReady();
+  for (; num_frames_ < n; ++num_frames_) {
+    int32_t f = num_frames_;
+    int32_t first = FirstFrame();
+    if (f < first) {
+      // Its chunks are already popped
+      continue;
+    }
+
+    // Only if the caller does not pop the chunks it has read
+    if (f - first == capacity_) {
+      Grow();
+    }
+
+    memcpy(ring_.data() + static_cast<int64_t>(f % capacity_) * dim_,
+           src_->GetFrame(f), dim_ * sizeof(float));
+  }
+
+  if (n > 0 && src_->IsLastFrame(n - 1)) {
+    input_finished_ = true;
+  }
+}
+
+template <class C>
+int32_t ChunkAssembler<C>::NumChunksReady() const {
+  int32_t chunk_size = opts_.chunk_size;
+  if (input_finished_) {
+    return (num_frames_ + chunk_size - 1) / chunk_size;
+  }
+
+  return num_frames_ / chunk_size;
+}
+
+template <class C>
+void ChunkAssembler<C>::GetChunk(
+    int32_t i, float *out, int32_t stride /*= 0*/,
+    FeatureLayout layout /*= FeatureLayout::kFrameMajor*/) const {
+  KNF_CHECK_GE(i, num_popped_chunks_);
+  KNF_CHECK_LT(i, NumChunksReady());
+
+  int32_t num_rows = ChunkFrames();
+  int32_t begin = i * opts_.chunk_size - opts_.left_context;
+
+  if (layout == FeatureLayout::kFeatureMajor) {
+    std::vector<const float *> frames(num_rows);
+    for (int32_t r = 0; r != num_rows; ++r) {
+      int32_t f = begin + r;
+      frames[r] = (f < 0 || f >= num_frames_) ? padding_.data() : Row(f);
+    }
+
+    WriteFrames(frames.data(), num_rows, dim_, layout, stride, out);
+    return;
+  }
+
+  if (stride == 0) {
+    stride = dim_;
+  }
+  KNF_CHECK_GE(stride, dim_);
+
+  int32_t r = 0;
+  while (r < num_rows) {
+    int32_t f = begin + r;
+    float *p = out + static_cast<int64_t>(r) * stride;
+    if (f < 0 || f >= num_frames_) {
+      std::copy(padding_.begin(), padding_.end(), p);
+      ++r;
+      continue;
+    }
+
+    // If rows of out are contiguous, copy all rows up to the end of the
+    // ring buffer at once
+    int32_t k = 1;
+    if (stride == dim_) {
+      k = std::min({num_rows - r, num_frames_ - f, capacity_ - f % capacity_});
+    }
+
+    memcpy(p, Row(f), static_cast<int64_t>(k) * dim_ * sizeof(float));
+    r += k;
+  }
+}
+
+template <class C>
+void ChunkAssembler<C>::Pop(int32_t n) {
+  num_popped_chunks_ += n;
+}
+
+template class ChunkAssembler<FbankComputer>;
+template class ChunkAssembler<MfccComputer>;
+template class ChunkAssembler<WhisperFeatureComputer>;
+
+}  // namespace knf
@@ -0,0 +1,164 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_CHUNK_ASSEMBLER_H_
+#define KALDI_NATIVE_FBANK_CSRC_CHUNK_ASSEMBLER_H_
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/feature-layout.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+struct ChunkAssemblerOptions {
+  // Number of new frames per chunk
+  int32_t chunk_size = 32;
+
+  // Number of frames of the previous chunk(s) that are repeated at the
+  // start of a chunk
+  int32_t left_context = 0;
+
+  // Value of the frames before the first frame and after the last frame,
+  // e.g., log(1e-10) = -23.0259 for the log mel features of silence.
+  float padding_value = 0;
+
+  std::string ToString() const {
+    std::ostringstream os;
+    os << "chunk_size: " << chunk_size << "\n";
+    os << "left_context: " << left_context << "\n";
+    os << "padding_value: " << padding_value << "\n";
+    return os.str();
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const ChunkAssemblerOptions &opts);
+
+/**
+ * It assembles the frames of an online feature extractor into the input
+ * chunks of a streaming model, e.g., a transducer.
+ *
+ * Chunk i covers frames [i * chunk_size - left_context,
+ * (i + 1) * chunk_size), i.e., ChunkFrames() frames. Frames are copied
+ * once from the source into a ring buffer by Update(), so the frames of
+ * the left context are shared by successive chunks instead of being read
+ * from the source again. GetChunk() writes a chunk directly into memory of
+ * the caller, e.g., an input tensor of the model, with at most two copies
+ * per chunk if the rows are contiguous, or transposed to [Dim(),
+ * ChunkFrames()].
+ *
+ * Usage:
+ *
+ *   OnlineFbank fbank(opts);
+ *   FbankChunkAssembler assembler(chunk_opts, &fbank);
+ *
+ *   fbank.AcceptWaveform(16000, samples, n);
+ *   assembler.Update();
+ *   fbank.Pop(fbank.NumFramesReady());  // optional
+ *   for (; i < assembler.NumChunksReady(); ++i) {
+ *     assembler.GetChunk(i, tensor_data);
+ *     assembler.Pop(1);
+ *     // run the model
+ *   }
+ */
+template <class C>
+class ChunkAssembler {
+ public:
+  /// @param src  Not owned. Its frame_opts.output_dtype must be "float32".
+  ChunkAssembler(const ChunkAssemblerOptions &opts,
+                 const OnlineGenericBaseFeature<C> *src);
+
+  /// Dimension of a frame
+  int32_t Dim() const { return dim_; }
+
+  /// Number of frames of a chunk, i.e., left_context + chunk_size
+  int32_t ChunkFrames() const {
+    return opts_.left_context + opts_.chunk_size;
+  }
+
+  /// Read the frames of src that have not been read yet. Call it after
+  /// src->AcceptWaveform() and src->InputFinished(). The source can pop
+  /// its frames after that.
+  void Update();
+
+  /// Number of chunks that GetChunk() accepts, including popped ones. A
+  /// chunk is ready once all of its frames are read. After the input of
+  /// src is finished, the last chunk can be partial and its missing frames
+  /// are filled with opts.padding_value.
+  int32_t NumChunksReady() const;
+
+  /**
+   * @param i  Index of the chunk. It should be less than NumChunksReady()
+   *           and it should not have been discarded by Pop().
+   * @param out  On return, frame r of the chunk, i.e., frame
+   *             i * chunk_size - left_context + r, for
+   *             0 <= r < ChunkFrames(). Its shape is [ChunkFrames(), Dim()]
+   *             for kFrameMajor and [Dim(), ChunkFrames()] for
+   *             kFeatureMajor.
+   * @param stride  Number of floats between two rows of out, e.g., to keep
+   *                each row aligned. 0 means no padding. Padding elements
+   *                of a row are not written.
+   * @param layout  Layout of out. See feature-layout.h
+   */
+  void GetChunk(int32_t i, float *out, int32_t stride = 0,
+                FeatureLayout layout = FeatureLayout::kFrameMajor) const;
+
+  /// Discard the frames used only by the first n remaining chunks.
+  /// Chunk indexes passed to GetChunk() are not changed.
+  void Pop(int32_t n);
+
+ private:
+  // Index of the first frame that is still needed
+  int32_t FirstFrame() const;
+
+  // Double the capacity of the ring buffer
+  void Grow();
+
+  const float *Row(int32_t frame) const {
+    return ring_.data() + static_cast<int64_t>(frame % capacity_) * dim_;
+  }
+
+  ChunkAssemblerOptions opts_;
+  const OnlineGenericBaseFeature<C> *src_;  // Not owned
+  int32_t dim_;
+
+  // A frame filled with opts_.padding_value
+  std::vector<float> padding_;
+
+  // Frame f is at row f % capacity_. It holds frames
+  // [FirstFrame(), num_frames_)
+  int32_t capacity_;
+  std::vector<float> ring_;
+
+  // Number of frames read from src_
+  int32_t num_frames_ = 0;
+
+  bool input_finished_ = false;
+
+  int32_t num_popped_chunks_ = 0;
+};
+
+using FbankChunkAssembler = ChunkAssembler<FbankComputer>;
+using MfccChunkAssembler = ChunkAssembler<MfccComputer>;
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_CHUNK_ASSEMBLER_H_
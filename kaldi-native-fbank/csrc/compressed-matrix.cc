@@ -0,0 +1,431 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file is modified from kaldi/src/matrix/compressed-matrix.cc
+
+#include "kaldi-native-fbank/csrc/compressed-matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/simd.h"
+
+namespace knf {
+
+namespace {
+
+// In the binary format, the header is written without the format, which is
+// given by the token instead.
+struct GlobalHeader {
+  float min_value;
+  float range;
+  int32_t num_rows;
+  int32_t num_cols;
+};
+
+// For the format "CM". The percentiles are quantized with the global header.
+struct PerColHeader {
+  uint16_t percentile_0;
+  uint16_t percentile_25;
+  uint16_t percentile_75;
+  uint16_t percentile_100;
+};
+
+static_assert(sizeof(GlobalHeader) == 16, "");
+static_assert(sizeof(PerColHeader) == 8, "");
+
+int32_t FormatOfToken(const char *token) {
+  if (strcmp(token, "CM") == 0) {
+    return 1;
+  } else if (strcmp(token, "CM2") == 0) {
+    return 2;
+  } else if (strcmp(token, "CM3") == 0) {
+    return 3;
+  }
+  return 0;
+}
+
+int64_t DataSize(int32_t format, int32_t num_rows, int32_t num_cols) {
+  int64_t n = static_cast<int64_t>(num_rows) * num_cols;
+  int64_t size = sizeof(GlobalHeader);
+  if (format == 1) {
+    size += num_cols * sizeof(PerColHeader) + n;
+  } else if (format == 2) {
+    size += n * sizeof(uint16_t);
+  } else {
+    size += n;
+  }
+  return size;
+}
+
+uint16_t FloatToUint16(const GlobalHeader &h, float value) {
+  float f = (value - h.min_value) / h.range;
+  if (f > 1.0f) f = 1.0f;  // Note: this should not happen.
+  if (f < 0.0f) f = 0.0f;  // Note: this should not happen.
+  return static_cast<int32_t>(f * 65535 + 0.499f);  // + 0.499 is to
+  // round to closest int; avoids bias.
+}
+
+float Uint16ToFloat(const GlobalHeader &h, uint16_t value) {
+  // the constant 1.52590218966964e-05 is 1/65535.
+  return h.min_value + h.range * 1.52590218966964e-05f * value;
+}
+
+uint8_t FloatToUint8(const GlobalHeader &h, float value) {
+  float f = (value - h.min_value) / h.range;
+  if (f > 1.0f) f = 1.0f;  // Note: this should not happen.
+  if (f < 0.0f) f = 0.0f;  // Note: this should not happen.
+  return static_cast<int32_t>(f * 255 + 0.499f);  // + 0.499 is to
+  // round to closest int; avoids bias.
+}
+
+uint8_t FloatToChar(float p0, float p25, float p75, float p100, float value) {
+  int32_t ans;
+  if (value < p25) {  // range [ p0 ... p25 ] mapped to [ 0 ... 64 ]
+    float f = (value - p0) / (p25 - p0);
+    ans = static_cast<int32_t>(f * 64 + 0.5f);
+    // Note: the checks on the next two lines
+    // are necessary in pathological cases when all the elements in a row
+    // are the same and the percentile_* values are therefore the same.
+    if (ans < 0) ans = 0;
+    if (ans > 64) ans = 64;
+  } else if (value < p75) {  // range [ p25 ... p75 ]mapped to [ 64 ... 192 ]
+    float f = (value - p25) / (p75 - p25);
+    ans = 64 + static_cast<int32_t>(f * 128 + 0.5f);
+    if (ans < 64) ans = 64;
+    if (ans > 192) ans = 192;
+  } else {  // range [ p75 ... p100 ] mapped to [ 192 ... 255 ]
+    float f = (value - p75) / (p100 - p75);
+    ans = 192 + static_cast<int32_t>(f * 63 + 0.5f);
+    if (ans < 192) ans = 192;
+    if (ans > 255) ans = 255;
+  }
+  return static_cast<uint8_t>(ans);
+}
+
+void ComputeColHeader(const GlobalHeader &h, std::vector<float> *sdata,
+                      PerColHeader *header) {
+  int32_t num_rows = sdata->size();
+  std::vector<float> &s = *sdata;
+
+  auto clamp = [](int32_t x, int32_t lo, int32_t hi) -> uint16_t {
+    return std::min(std::max(x, lo), hi);
+  };
+
+  if (num_rows >= 5) {
+    int32_t quarter_nr = num_rows / 4;
+    // The elements at positions 0, quarter_nr,
+    // 3*quarter_nr, and num_rows-1 need to be in sorted order.
+    std::nth_element(s.begin(), s.begin() + quarter_nr, s.end());
+    // Now, s[quarter_nr] is the value that would appear at
+    // index quarter_nr in a sorted array.
+    std::nth_element(s.begin(), s.begin(), s.begin() + quarter_nr);
+    // Now, s[0] is the lowest element.
+    std::nth_element(s.begin() + quarter_nr + 1, s.begin() + (3 * quarter_nr),
+                     s.end());
+    // Now, s[3*quarter_nr] is the value that would appear at
+    // index 3*quarter_nr in a sorted array.
+    std::nth_element(s.begin() + (3 * quarter_nr) + 1, s.end() - 1, s.end());
+    // Now, s[num_rows - 1] is the highest element.
+
+    header->percentile_0 = clamp(FloatToUint16(h, s[0]), 0, 65532);
+    header->percentile_25 =
+        clamp(FloatToUint16(h, s[quarter_nr]), header->percentile_0 + 1,
+              65533);
+    header->percentile_75 =
+        clamp(FloatToUint16(h, s[3 * quarter_nr]),
+              header->percentile_25 + 1, 65534);
+    header->percentile_100 = std::max<int32_t>(
+        FloatToUint16(h, s[num_rows - 1]), header->percentile_75 + 1);
+  } else {  // handle this pathological case.
+    std::sort(s.begin(), s.end());
+    // Note: we know num_rows is at least 1.
+    header->percentile_0 = clamp(FloatToUint16(h, s[0]), 0, 65532);
+    if (num_rows > 1) {
+      header->percentile_25 =
+          clamp(FloatToUint16(h, s[1]), header->percentile_0 + 1, 65533);
+    } else {
+      header->percentile_25 = header->percentile_0 + 1;
+    }
+
+    if (num_rows > 2) {
+      header->percentile_75 =
+          clamp(FloatToUint16(h, s[2]), header->percentile_25 + 1, 65534);
+    } else {
+      header->percentile_75 = header->percentile_25 + 1;
+    }
+
+    if (num_rows > 3) {
+      header->percentile_100 = std::max<int32_t>(
+          FloatToUint16(h, s[3]), header->percentile_75 + 1);
+    } else {
+      header->percentile_100 = header->percentile_75 + 1;
+    }
+  }
+}
+
+// The pieces of the map from bytes to floats of a column. See
+// SimdKernels::piecewise_uint8_to_float
+void GetColumnPieces(const GlobalHeader &h, const PerColHeader &c,
+                     float *base, float *scale, float *offset) {
+  float p0 = Uint16ToFloat(h, c.percentile_0);
+  float p25 = Uint16ToFloat(h, c.percentile_25);
+  float p75 = Uint16ToFloat(h, c.percentile_75);
+  float p100 = Uint16ToFloat(h, c.percentile_100);
+
+  base[0] = p0;
+  base[1] = p25;
+  base[2] = p75;
+  scale[0] = (p25 - p0) * (1 / 64.0f);
+  scale[1] = (p75 - p25) * (1 / 128.0f);
+  scale[2] = (p100 - p75) * (1 / 63.0f);
+  offset[0] = 0;
+  offset[1] = 64;
+  offset[2] = 192;
+}
+
+}  // namespace
+
+CompressedMatrix::CompressedMatrix() {
+  Compress(nullptr, 0, 0, CompressionMethod::kAutomatic);
+}
+
+CompressedMatrix::CompressedMatrix(
+    const float *data, int32_t num_rows, int32_t num_cols,
+    CompressionMethod method /*= CompressionMethod::kAutomatic*/) {
+  std::vector<const float *> rows(num_rows);
+  for (int32_t i = 0; i != num_rows; ++i) {
+    rows[i] = data + static_cast<int64_t>(i) * num_cols;
+  }
+  Compress(rows.data(), num_rows, num_cols, method);
+}
+
+CompressedMatrix::CompressedMatrix(
+    const float *const *rows, int32_t num_rows, int32_t num_cols,
+    CompressionMethod method /*= CompressionMethod::kAutomatic*/) {
+  Compress(rows, num_rows, num_cols, method);
+}
+
+const char *CompressedMatrix::Token() const {
+  switch (format_) {
+    case 2:
+      return "CM2";
+    case 3:
+      return "CM3";
+    default:
+      return "CM";
+  }
+}
+
+void CompressedMatrix::Compress(const float *const *rows, int32_t num_rows,
+                                int32_t num_cols, CompressionMethod method) {
+  if (num_rows == 0 || num_cols == 0) {
+    // Kaldi writes an empty matrix as "CM" with a header of zeros
+    format_ = 1;
+    num_rows_ = 0;
+    num_cols_ = 0;
+    data_.assign(sizeof(GlobalHeader), 0);
+    return;
+  }
+
+  if (method == CompressionMethod::kAutomatic) {
+    method = num_rows > 8 ? CompressionMethod::kSpeechFeature
+                          : CompressionMethod::kTwoByteAuto;
+  }
+
+  switch (method) {
+    case CompressionMethod::kSpeechFeature:
+      format_ = 1;
+      break;
+    case CompressionMethod::kTwoByteAuto:
+      format_ = 2;
+      break;
+    case CompressionMethod::kOneByteAuto:
+      format_ = 3;
+      break;
+    default:
+      fprintf(stderr, "Unsupported compression method: %d\n",
+              static_cast<int32_t>(method));
+      exit(-1);
+  }
+
+  float min_value = rows[0][0];
+  float max_value = rows[0][0];
+  for (int32_t r = 0; r != num_rows; ++r) {
+    const float *p = rows[r];
+    for (int32_t c = 0; c != num_cols; ++c) {
+      min_value = std::min(min_value, p[c]);
+      max_value = std::max(max_value, p[c]);
+    }
+  }
+
+  if (!std::isfinite(min_value) || !std::isfinite(max_value)) {
+    fprintf(stderr, "Cannot compress a matrix with NaN's or Inf's\n");
+    exit(-1);
+  }
+
+  // ensure that max_value is strictly greater than min_value, even if
+  // matrix is constant; this avoids crashes in ComputeColHeader when
+  // compressing speech features.
+  if (max_value == min_value) {
+    max_value = min_value + (1.0f + std::abs(min_value));
+  }
+
+  GlobalHeader h;
+  h.min_value = min_value;
+  h.range = max_value - min_value;
+  h.num_rows = num_rows;
+  h.num_cols = num_cols;
+
+  num_rows_ = num_rows;
+  num_cols_ = num_cols;
+  data_.resize(DataSize(format_, num_rows, num_cols));
+  memcpy(data_.data(), &h, sizeof(h));
+  uint8_t *p = data_.data() + sizeof(h);
+
+  if (format_ == 1) {
+    std::vector<PerColHeader> headers(num_cols);
+    uint8_t *byte_data = p + num_cols * sizeof(PerColHeader);
+    std::vector<float> column(num_rows);
+    for (int32_t c = 0; c != num_cols; ++c) {
+      for (int32_t r = 0; r != num_rows; ++r) {
+        column[r] = rows[r][c];
+      }
+
+      // column is reordered
+      ComputeColHeader(h, &column, &headers[c]);
+
+      float p0 = Uint16ToFloat(h, headers[c].percentile_0);
+      float p25 = Uint16ToFloat(h, headers[c].percentile_25);
+      float p75 = Uint16ToFloat(h, headers[c].percentile_75);
+      float p100 = Uint16ToFloat(h, headers[c].percentile_100);
+
+      for (int32_t r = 0; r != num_rows; ++r, ++byte_data) {
+        *byte_data = FloatToChar(p0, p25, p75, p100, rows[r][c]);
+      }
+    }
+    memcpy(p, headers.data(), num_cols * sizeof(PerColHeader));
+  } else if (format_ == 2) {
+    for (int32_t r = 0; r != num_rows; ++r) {
+      for (int32_t c = 0; c != num_cols; ++c, p += 2) {
+        uint16_t v = FloatToUint16(h, rows[r][c]);
+        memcpy(p, &v, 2);
+      }
+    }
+  } else {
+    for (int32_t r = 0; r != num_rows; ++r) {
+      for (int32_t c = 0; c != num_cols; ++c, ++p) {
+        *p = FloatToUint8(h, rows[r][c]);
+      }
+    }
+  }
+}
+
+void CompressedMatrix::CopyToMatrix(float *out) const {
+  Decompress(Token(), data_.data(), out);
+}
+
+int64_t CompressedMatrix::Parse(const char *token, const uint8_t *data,
+                                int64_t size, int32_t *num_rows,
+                                int32_t *num_cols) {
+  int32_t format = FormatOfToken(token);
+  if (format == 0 || size < static_cast<int64_t>(sizeof(GlobalHeader))) {
+    return -1;
+  }
+
+  GlobalHeader h;
+  memcpy(&h, data, sizeof(h));
+  if (h.num_rows < 0 || h.num_cols < 0) {
+    return -1;
+  }
+
+  *num_rows = h.num_rows;
+  *num_cols = h.num_cols;
+  return DataSize(format, h.num_rows, h.num_cols);
+}
+
+void CompressedMatrix::Decompress(const char *token, const uint8_t *data,
+                                  float *out) {
+  int32_t format = FormatOfToken(token);
+  if (format == 0) {
+    fprintf(stderr, "Unknown token of compressed matrix: %s\n", token);
+    exit(-1);
+  }
+
+  GlobalHeader h;
+  memcpy(&h, data, sizeof(h));
+  int32_t num_rows = h.num_rows;
+  int32_t num_cols = h.num_cols;
+  const uint8_t *p = data + sizeof(h);
+  const SimdKernels &kernels = GetSimdKernels();
+
+  if (format == 1) {
+    // The bytes are stored column by column. We decode a block of rows
+    // of all columns at a time into a buffer that fits in the cache and
+    // transpose it.
+    constexpr int32_t kBlock = 64;
+    std::vector<float> pieces(num_cols * 9);
+    for (int32_t c = 0; c != num_cols; ++c) {
+      PerColHeader header;
+      memcpy(&header, p + c * sizeof(PerColHeader), sizeof(header));
+      float *q = pieces.data() + c * 9;
+      GetColumnPieces(h, header, q, q + 3, q + 6);
+    }
+
+    const uint8_t *byte_data = p + num_cols * sizeof(PerColHeader);
+    std::vector<float> buf(kBlock * num_cols);
+    for (int32_t r0 = 0; r0 < num_rows; r0 += kBlock) {
+      int32_t n = std::min(kBlock, num_rows - r0);
+      for (int32_t c = 0; c != num_cols; ++c) {
+        const float *q = pieces.data() + c * 9;
+        kernels.piecewise_uint8_to_float(
+            byte_data + static_cast<int64_t>(c) * num_rows + r0, q, q + 3,
+            q + 6, buf.data() + c * kBlock, n);
+      }
+
+      for (int32_t r = 0; r != n; ++r) {
+        float *o = out + static_cast<int64_t>(r0 + r) * num_cols;
+        for (int32_t c = 0; c != num_cols; ++c) {
+          o[c] = buf[c * kBlock + r];
+        }
+      }
+    }
+  } else if (format == 2) {
+    int64_t n = static_cast<int64_t>(num_rows) * num_cols;
+    for (int64_t i = 0; i != n; ++i) {
+      uint16_t v;
+      memcpy(&v, p + 2 * i, 2);
+      out[i] = Uint16ToFloat(h, v);
+    }
+  } else {
+    // A single piece
+    float base[3] = {h.min_value, h.min_value, h.min_value};
+    float s = h.range * (1.0f / 255.0f);
+    float scale[3] = {s, s, s};
+    float offset[3] = {0, 0, 0};
+    kernels.piecewise_uint8_to_float(
+        p, base, scale, offset, out,
+        static_cast<int64_t>(num_rows) * num_cols);
+  }
+}
+
+}  // namespace knf
@@ -0,0 +1,116 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file is modified from kaldi/src/matrix/compressed-matrix.h
+//
+// The lossy compressed matrix of Kaldi. The binary format is compatible
+// with Kaldi, so compressed features written by ArkWriter can be read by
+// Kaldi and kaldiio, and vice versa.
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_COMPRESSED_MATRIX_H_
+#define KALDI_NATIVE_FBANK_CSRC_COMPRESSED_MATRIX_H_
+
+#include <cstdint>
+#include <vector>
+
+namespace knf {
+
+// The same as CompressionMethod in Kaldi, except that the methods for
+// integer matrices are not supported.
+enum class CompressionMethod : int32_t {
+  // kSpeechFeature if there are more than 8 rows, else kTwoByteAuto
+  kAutomatic = 1,
+
+  // 8 bits per value, quantized with per-column percentiles. It works well
+  // for features, which have a different range in each column.
+  kSpeechFeature = 2,
+
+  // 16 bits per value, quantized between the min and max of the matrix
+  kTwoByteAuto = 3,
+
+  // 8 bits per value, quantized between the min and max of the matrix
+  kOneByteAuto = 5,
+};
+
+class CompressedMatrix {
+ public:
+  /// An empty matrix
+  CompressedMatrix();
+
+  /// Compress a row-major matrix of shape [num_rows, num_cols]
+  CompressedMatrix(const float *data, int32_t num_rows, int32_t num_cols,
+                   CompressionMethod method = CompressionMethod::kAutomatic);
+
+  /// Like the above, but rows[i] points to row i. It is used to compress
+  /// the frames of an online feature extractor without copying them into
+  /// a matrix first.
+  CompressedMatrix(const float *const *rows, int32_t num_rows,
+                   int32_t num_cols,
+                   CompressionMethod method = CompressionMethod::kAutomatic);
+
+  int32_t NumRows() const { return num_rows_; }
+  int32_t NumCols() const { return num_cols_; }
+
+  /// The token of the format in the binary format of Kaldi, i.e., "CM",
+  /// "CM2" or "CM3".
+  const char *Token() const;
+
+  /// The bytes following the token and a space in the binary format of
+  /// Kaldi.
+  const std::vector<uint8_t> &Data() const { return data_; }
+
+  /// @param out  A row-major matrix of shape [NumRows(), NumCols()]
+  void CopyToMatrix(float *out) const;
+
+  /**
+   * Decompress a matrix in the binary format of Kaldi, e.g., from a mapped
+   * ark file, without copying it into a CompressedMatrix first.
+   *
+   * @param token  "CM", "CM2" or "CM3"
+   * @param data  The bytes following the token and a space. It does not
+   *              need to be aligned.
+   * @param out  A row-major matrix of shape [num_rows, num_cols], where
+   *             num_rows and num_cols are from the header in data.
+   */
+  static void Decompress(const char *token, const uint8_t *data, float *out);
+
+  /**
+   * Return the number of bytes of a compressed matrix in the binary format
+   * of Kaldi, excluding the token, and the shape in its header. Return -1
+   * if the token is unknown or the header is invalid.
+   *
+   * @param token  "CM", "CM2" or "CM3"
+   * @param data  The bytes following the token and a space.
+   * @param size  Number of bytes available in data.
+   */
+  static int64_t Parse(const char *token, const uint8_t *data, int64_t size,
+                       int32_t *num_rows, int32_t *num_cols);
+
+ private:
+  void Compress(const float *const *rows, int32_t num_rows, int32_t num_cols,
+                CompressionMethod method);
+
+  int32_t format_ = 1;  // 1: "CM", 2: "CM2", 3: "CM3"
+  int32_t num_rows_ = 0;
+  int32_t num_cols_ = 0;
+  std::vector<uint8_t> data_;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_COMPRESSED_MATRIX_H_
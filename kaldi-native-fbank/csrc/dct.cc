@@ -0,0 +1,226 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/dct.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/kaldi-math.h"
+#include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/simd.h"
+
+namespace knf {
+
+// We use the FFT-based algorithm only if num_bins is even (required by Rfft)
+// and not too small, and if most of the outputs are needed.
+static bool ShouldUseFft(int32_t num_ceps, int32_t num_bins) {
+  return num_bins % 2 == 0 && num_bins >= 32 && 2 * num_ceps >= num_bins;
+}
+
+Dct::Dct(int32_t num_ceps, int32_t num_bins,
+         const std::vector<float> &lifter_coeffs /*= {}*/)
+    : num_ceps_(num_ceps), num_bins_(num_bins), buf_(num_bins) {
+  KNF_CHECK_GT(num_ceps, 0);
+  KNF_CHECK_LE(num_ceps, num_bins);
+
+  if (!lifter_coeffs.empty()) {
+    KNF_CHECK_EQ(static_cast<int32_t>(lifter_coeffs.size()), num_ceps);
+  }
+
+  std::vector<double> scale(num_ceps);
+  for (int32_t k = 0; k != num_ceps; ++k) {
+    scale[k] = (k == 0) ? std::sqrt(1.0 / num_bins) : std::sqrt(2.0 / num_bins);
+    if (!lifter_coeffs.empty()) {
+      scale[k] *= lifter_coeffs[k];
+    }
+  }
+
+  auto tables = std::make_shared<Tables>();
+
+  // See ComputeDctMatrix() in
+  // https://github.com/kaldi-asr/kaldi/blob/master/src/matrix/matrix-functions.cc#L592
+  tables->matrix_t.resize(num_bins * num_ceps);
+  for (int32_t n = 0; n != num_bins; ++n) {
+    float *p = tables->matrix_t.data() + n * num_ceps;
+    for (int32_t k = 0; k != num_ceps; ++k) {
+      p[k] = scale[k] *
+             std::cos(static_cast<double>(M_PI) / num_bins * (n + 0.5) * k);
+    }
+  }
+
+  if (ShouldUseFft(num_ceps, num_bins)) {
+    rfft_ = std::make_unique<Rfft>(num_bins);
+    tables->twiddle_cos.resize(num_ceps);
+    tables->twiddle_sin.resize(num_ceps);
+    for (int32_t k = 0; k != num_ceps; ++k) {
+      double theta = M_PI * k / (2.0 * num_bins);
+      tables->twiddle_cos[k] = scale[k] * std::cos(theta);
+      tables->twiddle_sin[k] = scale[k] * std::sin(theta);
+    }
+  }
+
+  tables_ = std::move(tables);
+}
+
+Dct::Dct(const Dct &other)
+    : num_ceps_(other.num_ceps_),
+      num_bins_(other.num_bins_),
+      tables_(other.tables_),
+      rfft_(other.rfft_ ? std::make_unique<Rfft>(*other.rfft_) : nullptr),
+      buf_(other.buf_.size()) {}
+
+void Dct::Compute(const float *in, float *out) {
+  if (rfft_) {
+    ComputeFft(in, out);
+    return;
+  }
+
+  Compute(in, 1, &out);
+}
+
+void Dct::ComputeLog(float *in, float *out, bool skip_c0 /*= false*/,
+                     bool fast_log /*= false*/) {
+  const SimdKernels &kernels = GetSimdKernels();
+  auto log = fast_log ? kernels.log_fast : kernels.log;
+  log(std::numeric_limits<float>::epsilon(), in, num_bins_);
+  if (rfft_) {
+    float c0 = out[0];
+    ComputeFft(in, out);
+    if (skip_c0) {
+      out[0] = c0;
+    }
+    return;
+  }
+
+  int32_t k0 = skip_c0 ? 1 : 0;
+  int32_t num_ceps = num_ceps_;
+  std::fill(out + k0, out + num_ceps, 0.0f);
+
+  // Each log value is multiplied with a row of the transposed matrix and
+  // accumulated into all the outputs, so the inner loop is contiguous and
+  // can be vectorized.
+  const float *p = tables_->matrix_t.data();
+  for (int32_t n = 0; n != num_bins_; ++n, p += num_ceps) {
+    float x = in[n];
+    for (int32_t k = k0; k < num_ceps; ++k) {
+      out[k] += x * p[k];
+    }
+  }
+}
+
+void Dct::Compute(const float *in, int32_t num_frames,
+                  float *const *out) const {
+  constexpr int32_t kBlock = 4;
+
+  int32_t num_ceps = num_ceps_;
+  int32_t num_bins = num_bins_;
+  for (int32_t f = 0; f != num_frames; ++f) {
+    std::fill(out[f], out[f] + num_ceps, 0.0f);
+  }
+
+  // out[f][k] = sum_n in[f][n] * matrix_t[n][k]
+  //
+  // We process kBlock frames at a time so that each row of matrix_t is
+  // reused kBlock times while it is in the L1 cache.
+  int32_t f = 0;
+  for (; f + kBlock <= num_frames; f += kBlock) {
+    const float *x0 = in + f * num_bins;
+    const float *x1 = x0 + num_bins;
+    const float *x2 = x1 + num_bins;
+    const float *x3 = x2 + num_bins;
+
+    float *y0 = out[f];
+    float *y1 = out[f + 1];
+    float *y2 = out[f + 2];
+    float *y3 = out[f + 3];
+
+    const float *p = tables_->matrix_t.data();
+    for (int32_t n = 0; n != num_bins; ++n, p += num_ceps) {
+      float a0 = x0[n];
+      float a1 = x1[n];
+      float a2 = x2[n];
+      float a3 = x3[n];
+      for (int32_t k = 0; k != num_ceps; ++k) {
+        y0[k] += a0 * p[k];
+        y1[k] += a1 * p[k];
+        y2[k] += a2 * p[k];
+        y3[k] += a3 * p[k];
+      }
+    }
+  }
+
+  for (; f != num_frames; ++f) {
+    const float *x = in + f * num_bins;
+    float *y = out[f];
+
+    const float *p = tables_->matrix_t.data();
+    for (int32_t n = 0; n != num_bins; ++n, p += num_ceps) {
+      float a = x[n];
+      for (int32_t k = 0; k != num_ceps; ++k) {
+        y[k] += a * p[k];
+      }
+    }
+  }
+}
+
+void Dct::ComputeFft(const float *in, float *out) {
+  // Makhoul, J. "A fast cosine transform in one and two dimensions."
+  // IEEE Trans. ASSP 28.1 (1980): 27-34.
+  //
+  // v[n] = in[2n], v[N-1-n] = in[2n+1], 0 <= n < N/2
+  // V = fft(v)
+  // dct[k] = Re(exp(-i*pi*k/(2N)) * V[k])
+  int32_t n = num_bins_;
+  int32_t half = n / 2;
+  float *v = buf_.data();
+  for (int32_t i = 0; i != half; ++i) {
+    v[i] = in[2 * i];
+    v[n - 1 - i] = in[2 * i + 1];
+  }
+
+  rfft_->Compute(v);
+
+  // See rfft.h for the layout of v
+  for (int32_t k = 0; k != num_ceps_; ++k) {
+    float re;
+    float im;
+    if (k == 0) {
+      re = v[0];
+      im = 0;
+    } else if (k < half) {
+      re = v[2 * k];
+      im = v[2 * k + 1];
+    } else if (k == half) {
+      re = v[1];
+      im = 0;
+    } else {
+      // V[k] = conj(V[N-k])
+      re = v[2 * (n - k)];
+      im = -v[2 * (n - k) + 1];
+    }
+
+    out[k] = re * tables_->twiddle_cos[k] + im * tables_->twiddle_sin[k];
+  }
+}
+
+}  // namespace knf
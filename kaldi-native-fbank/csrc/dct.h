@@ -0,0 +1,127 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_DCT_H_
+#define KALDI_NATIVE_FBANK_CSRC_DCT_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/rfft.h"
+
+namespace knf {
+
+// Orthonormal DCT-II as used in MFCC computation, i.e., the first num_ceps
+// rows of Kaldi's ComputeDctMatrix(), with optional liftering coefficients
+// folded into the transform.
+//
+//   out[k] = lifter[k] * norm[k] * sum_n in[n] * cos(pi / N * (n + 0.5) * k)
+//
+// where N = num_bins, norm[0] = sqrt(1/N) and norm[k] = sqrt(2/N) for k > 0.
+//
+// If num_ceps is close to num_bins, the transform is computed with an
+// N-point real FFT (Makhoul's algorithm), which needs O(N log N) instead of
+// O(num_ceps * N) operations. Otherwise, a matrix is used.
+class Dct {
+ public:
+  /**
+   * @param num_ceps Number of output coefficients. Must be <= num_bins.
+   * @param num_bins Input dimension.
+   * @param lifter_coeffs If not empty, it is of size num_ceps and
+   *                      out[k] is scaled by lifter_coeffs[k].
+   */
+  Dct(int32_t num_ceps, int32_t num_bins,
+      const std::vector<float> &lifter_coeffs = {});
+
+  // The tables are immutable and are shared between copies.
+  Dct(const Dct &other);
+  Dct &operator=(const Dct &other) = delete;
+
+  int32_t NumCeps() const { return num_ceps_; }
+  int32_t NumBins() const { return num_bins_; }
+
+  // True if the FFT-based algorithm is used
+  bool UseFft() const { return rfft_ != nullptr; }
+
+  /**
+   * @param in  1-D array of size num_bins.
+   * @param out 1-D array of size num_ceps.
+   */
+  void Compute(const float *in, float *out);
+
+  /** Fused log + DCT + liftering for one frame of MFCC.
+   *
+   * It computes Compute(log(max(in, epsilon))). The log is computed in
+   * place with the SIMD log kernel and then each log value is consumed by
+   * all num_ceps outputs when the matrix is used.
+   *
+   * @param in  1-D array of size num_bins containing linear mel energies.
+   *            It is used as a workspace and its content is undefined on
+   *            return.
+   * @param out 1-D array of size num_ceps.
+   * @param skip_c0 If true, out[0] is not computed and left untouched,
+   *                e.g., because it will be replaced by the energy.
+   * @param fast_log If true, use the log_fast kernel. See simd.h
+   */
+  void ComputeLog(float *in, float *out, bool skip_c0 = false,
+                  bool fast_log = false);
+
+  /** Batched version of Compute() as a small GEMM with the matrix, even if
+   * UseFft() is true. The products are accumulated in the same order as
+   * in ComputeLog() when UseFft() is false, so the results are the same.
+   * See MfccComputer::ComputeBatch().
+   *
+   * @param in  2-D array of shape [num_frames, num_bins] in row major.
+   * @param num_frames Number of frames in `in` and `out`.
+   * @param out num_frames pointers, each to a 1-D array of size num_ceps.
+   */
+  void Compute(const float *in, int32_t num_frames,
+               float *const *out) const;
+
+ private:
+  void ComputeFft(const float *in, float *out);
+
+ private:
+  int32_t num_ceps_;
+  int32_t num_bins_;
+
+  struct Tables {
+    // [num_bins][num_ceps], i.e., the transpose of the (liftered) DCT
+    // matrix. It is always computed since the batched version uses it.
+    std::vector<float> matrix_t;
+
+    // [num_ceps], norm[k] * lifter[k] * cos(pi * k / (2 * num_bins)) and
+    // norm[k] * lifter[k] * sin(pi * k / (2 * num_bins)).
+    // Used only by the FFT-based algorithm
+    std::vector<float> twiddle_cos;
+    std::vector<float> twiddle_sin;
+  };
+
+  std::shared_ptr<const Tables> tables_;
+
+  // Used only by the FFT-based algorithm
+  std::unique_ptr<Rfft> rfft_;
+
+  // workspace of size num_bins
+  std::vector<float> buf_;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_DCT_H_
@@ -28,6 +28,8 @@
 #include "kaldi-native-fbank/csrc/feature-functions.h"
 #include "kaldi-native-fbank/csrc/kaldi-math.h"
 #include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+#include "kaldi-native-fbank/csrc/simd.h"
 
 namespace knf {
 
@@ -37,7 +39,9 @@ std::ostream &operator<<(std::ostream &os, const FbankOptions &opts) {
 }
 
 FbankComputer::FbankComputer(const FbankOptions &opts)
-    : opts_(opts), rfft_(opts.frame_opts.PaddedWindowSize()) {
+    : opts_(opts),
+      fast_math_(opts.frame_opts.UseFastMath()),
+      rfft_(opts.frame_opts.PaddedWindowSize()) {
   if (opts.energy_floor > 0.0f) {
     log_energy_floor_ = logf(opts.energy_floor);
   }
@@ -47,29 +51,22 @@ FbankComputer::FbankComputer(const FbankOptions &opts)
   GetMelBanks(1.0f);
 }
 
-FbankComputer::~FbankComputer() {
-  for (auto iter = mel_banks_.begin(); iter != mel_banks_.end(); ++iter)
-    delete iter->second;
-}
+FbankComputer::~FbankComputer() = default;
 
 const MelBanks *FbankComputer::GetMelBanks(float vtln_warp) {
-  MelBanks *this_mel_banks = nullptr;
-
-  // std::map<float, MelBanks *>::iterator iter = mel_banks_.find(vtln_warp);
   auto iter = mel_banks_.find(vtln_warp);
   if (iter == mel_banks_.end()) {
-    this_mel_banks = new MelBanks(opts_.mel_opts, opts_.frame_opts, vtln_warp);
-    mel_banks_[vtln_warp] = this_mel_banks;
-  } else {
-    this_mel_banks = iter->second;
+    auto mel_banks =
+        MelBanksCache::Get(opts_.mel_opts, opts_.frame_opts, vtln_warp);
+    const MelBanks *ans = mel_banks.get();
+    mel_banks_[vtln_warp] = std::move(mel_banks);
+    return ans;
   }
-  return this_mel_banks;
+  return iter->second.get();
 }
 
 void FbankComputer::Compute(float signal_raw_log_energy, float vtln_warp,
                             std::vector<float> *signal_frame, float *feature) {
-  const MelBanks &mel_banks = *(GetMelBanks(vtln_warp));
-
   KNF_CHECK_EQ(signal_frame->size(), opts_.frame_opts.PaddedWindowSize());
 
   // Compute energy after window function (not the raw one).
@@ -79,37 +76,115 @@ void FbankComputer::Compute(float signal_raw_log_energy, float vtln_warp,
                                      signal_frame->size()),
                         std::numeric_limits<float>::epsilon()));
   }
-  rfft_.Compute(signal_frame->data());  // signal_frame is modified in-place
-  ComputePowerSpectrum(signal_frame);
-
-  // Use magnitude instead of power if requested.
-  if (!opts_.use_power) {
-    Sqrt(signal_frame->data(), signal_frame->size() / 2 + 1);
+  {
+    KNF_PROFILE_SCOPE(kProfileFft);
+    rfft_.Compute(signal_frame->data());  // signal_frame is modified in-place
   }
 
+  ComputeFromFft(signal_raw_log_energy, vtln_warp, signal_frame->data(),
+                 feature);
+}
+
+void FbankComputer::ComputeFromFft(float log_energy, float vtln_warp,
+                                   float *fft, float *feature) {
+  const MelBanks &mel_banks = *(GetMelBanks(vtln_warp));
+  int32_t n = opts_.frame_opts.PaddedWindowSize();
+
   int32_t mel_offset = ((opts_.use_energy && !opts_.htk_compat) ? 1 : 0);
 
   // Its length is opts_.mel_opts.num_bins
   float *mel_energies = feature + mel_offset;
 
-  // Sum with mel filter banks over the power spectrum
-  mel_banks.Compute(signal_frame->data(), mel_energies);
+  // Power (or magnitude) spectrum and mel filter banks, computed only for the
+  // fft bins covered by the filters
+  mel_banks.ComputeFromFft(fft, n, opts_.use_power, mel_energies);
+
+  ComputeFromMelEnergies(log_energy, feature);
+}
+
+void FbankComputer::ComputeFromSpectrum(float log_energy, float vtln_warp,
+                                        const float *spectrum,
+                                        float *feature) {
+  const MelBanks &mel_banks = *(GetMelBanks(vtln_warp));
+  int32_t mel_offset = ((opts_.use_energy && !opts_.htk_compat) ? 1 : 0);
+  {
+    KNF_PROFILE_SCOPE(kProfileMel);
+    mel_banks.Compute(spectrum, feature + mel_offset);
+  }
+
+  ComputeFromMelEnergies(log_energy, feature);
+}
+
+void FbankComputer::ComputeFromMelEnergies(float log_energy, float *feature) {
+  int32_t mel_offset = ((opts_.use_energy && !opts_.htk_compat) ? 1 : 0);
+  float *mel_energies = feature + mel_offset;
 
   if (opts_.use_log_fbank) {
+    KNF_PROFILE_SCOPE(kProfileLog);
     // Avoid log of zero (which should be prevented anyway by dithering).
-    for (int32_t i = 0; i != opts_.mel_opts.num_bins; ++i) {
-      auto t = std::max(mel_energies[i], std::numeric_limits<float>::epsilon());
-      mel_energies[i] = std::log(t);
-    }
+    const SimdKernels &kernels = GetSimdKernels();
+    auto log = fast_math_ ? kernels.log_fast : kernels.log;
+    log(std::numeric_limits<float>::epsilon(), mel_energies,
+        opts_.mel_opts.num_bins);
   }
 
   // Copy energy as first value (or the last, if htk_compat == true).
   if (opts_.use_energy) {
-    if (opts_.energy_floor > 0.0 && signal_raw_log_energy < log_energy_floor_) {
-      signal_raw_log_energy = log_energy_floor_;
+    if (opts_.energy_floor > 0.0 && log_energy < log_energy_floor_) {
+      log_energy = log_energy_floor_;
     }
     int32_t energy_index = opts_.htk_compat ? opts_.mel_opts.num_bins : 0;
-    feature[energy_index] = signal_raw_log_energy;
+    feature[energy_index] = log_energy;
+  }
+}
+
+void FbankComputer::ComputeBatch(const float *raw_log_energies,
+                                 float vtln_warp, std::vector<float> *frames,
+                                 int32_t n, float *const *features) {
+  int32_t padded_window_size = opts_.frame_opts.PaddedWindowSize();
+  int32_t num_bins = opts_.mel_opts.num_bins;
+  int32_t mel_offset = ((opts_.use_energy && !opts_.htk_compat) ? 1 : 0);
+
+  // The energy is computed before the FFT overwrites the frames. It does
+  // not overlap with the mel energies of the output.
+  if (opts_.use_energy) {
+    int32_t energy_index = opts_.htk_compat ? num_bins : 0;
+    for (int32_t i = 0; i != n; ++i) {
+      float log_energy = raw_log_energies[i];
+      if (!opts_.raw_energy) {
+        log_energy = std::log(std::max<float>(
+            InnerProduct(frames[i].data(), frames[i].data(),
+                         frames[i].size()),
+            std::numeric_limits<float>::epsilon()));
+      }
+
+      if (opts_.energy_floor > 0.0 && log_energy < log_energy_floor_) {
+        log_energy = log_energy_floor_;
+      }
+      features[i][energy_index] = log_energy;
+    }
+  }
+
+  for (int32_t i = 0; i != n; ++i) {
+    KNF_CHECK_EQ(frames[i].size(), padded_window_size);
+    KNF_PROFILE_SCOPE(kProfileFft);
+    rfft_.Compute(frames[i].data());
+  }
+
+  const MelBanks &mel_banks = *(GetMelBanks(vtln_warp));
+  for (int32_t i = 0; i != n; ++i) {
+    mel_banks.ComputeFromFft(frames[i].data(), padded_window_size,
+                             opts_.use_power, features[i] + mel_offset);
+  }
+
+  if (opts_.use_log_fbank) {
+    const SimdKernels &kernels = GetSimdKernels();
+    auto log = fast_math_ ? kernels.log_fast : kernels.log;
+    for (int32_t i = 0; i != n; ++i) {
+      KNF_PROFILE_SCOPE(kProfileLog);
+      log(std::numeric_limits<float>::epsilon(), features[i] + mel_offset,
+          num_bins);
+    }
   }
 }
 
@@ -22,6 +22,7 @@
 #define KALDI_NATIVE_FBANK_CSRC_FEATURE_FBANK_H_
 
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 #include <cstdint>
@@ -122,12 +123,66 @@ class FbankComputer {
   void Compute(float signal_raw_log_energy, float vtln_warp,
                std::vector<float> *signal_frame, float *feature);
 
- private:
+  /**
+     Like Compute(), but it starts from the FFT of the windowed frame so
+     that one FFT can be shared by several computers with the same
+     frame options. See MultiFeatureComputer.
+
+     @param [in] log_energy  The raw log-energy if use_energy and raw_energy
+         are true; the log-energy of the windowed frame if use_energy is true
+         and raw_energy is false. Ignored if use_energy is false.
+     @param [in] vtln_warp  See Compute().
+     @param [in,out] fft  The output of Rfft::Compute() for the windowed
+         frame. It has GetFrameOptions().PaddedWindowSize() elements and is
+         used as a workspace.
+     @param [out] feature  Pointer to a vector of size this->Dim().
+  */
+  void ComputeFromFft(float log_energy, float vtln_warp, float *fft,
+                      float *feature);
+
+  /**
+     Like ComputeFromFft(), but it starts from the spectrum, so that one
+     power spectrum can be shared by several computers. See
+     MultiFeatureComputer.
+
+     @param [in] spectrum  |X|^2 if use_power is true; |X| otherwise.
+         It has GetFrameOptions().PaddedWindowSize() / 2 + 1 elements, but
+         only the fft bins in [GetMelBanks(vtln_warp)->FftBegin(),
+         FftEnd()) are read.
+  */
+  void ComputeFromSpectrum(float log_energy, float vtln_warp,
+                           const float *spectrum, float *feature);
+
+  /**
+     Like Compute(), but for n frames. Each stage, i.e., the FFT, the mel
+     filter banks and the log, is run over all frames before the next stage
+     starts, so that the tables of a stage stay in the cache. The output
+     is identical to calling Compute() for each frame.
+     See MultiStreamOnlineFeature.
+
+     @param [in] raw_log_energies  n values. See Compute().
+     @param [in] vtln_warp  See Compute().
+     @param [in,out] frames  n windowed frames. They are used as workspace.
+     @param [in] n  Number of frames.
+     @param [out] features  n pointers, each to a vector of size Dim().
+  */
+  void ComputeBatch(const float *raw_log_energies, float vtln_warp,
+                    std::vector<float> *frames, int32_t n,
+                    float *const *features);
+
+  // The mel banks for the given VTLN warp factor
   const MelBanks *GetMelBanks(float vtln_warp);
 
+ private:
+  // Apply the log to the mel energies in feature and set the energy
+  void ComputeFromMelEnergies(float log_energy, float *feature);
+
   FbankOptions opts_;
-  float log_energy_floor_;
-  std::map<float, MelBanks *> mel_banks_;  // float is VTLN coefficient.
+  float log_energy_floor_ = 0;
+  bool fast_math_ = false;  // opts_.frame_opts.accuracy is "fast"
+  // float is VTLN coefficient. The MelBanks are shared with other computers
+  // through MelBanksCache.
+  std::map<float, std::shared_ptr<const MelBanks>> mel_banks_;
   Rfft rfft_;
 };
 
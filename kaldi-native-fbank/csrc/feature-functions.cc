@@ -23,6 +23,8 @@
 #include <cstdint>
 #include <vector>
 
+#include "kaldi-native-fbank/csrc/simd.h"
+
 namespace knf {
 
 void ComputePowerSpectrum(std::vector<float> *complex_fft) {
@@ -36,11 +38,9 @@ void ComputePowerSpectrum(std::vector<float> *complex_fft) {
   float first_energy = p[0] * p[0];
   float last_energy = p[1] * p[1];  // handle this special case
 
-  for (int32_t i = 1; i < half_dim; ++i) {
-    float real = p[i * 2];
-    float im = p[i * 2 + 1];
-    p[i] = real * real + im * im;
-  }
+  // p[i] = p[2*i]^2 + p[2*i+1]^2 for 1 <= i < half_dim. It is done in place
+  // since p[i] is written after p[2*i] and p[2*i+1] are read.
+  GetSimdKernels().complex_squared_norm(p + 2, p + 1, half_dim - 1);
   p[0] = first_energy;
   p[half_dim] = last_energy;  // Will actually never be used, and anyway
   // if the signal has been bandlimited sensibly this should be zero.
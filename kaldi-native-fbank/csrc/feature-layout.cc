@@ -0,0 +1,66 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/feature-layout.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "kaldi-native-fbank/csrc/log.h"
+
+namespace knf {
+
+// 16 floats, i.e., a cache line of 64 bytes
+static constexpr int32_t kTileSize = 16;
+
+void WriteFrames(const float *const *frames, int32_t num_frames, int32_t dim,
+                 FeatureLayout layout, int32_t stride, float *out) {
+  if (layout == FeatureLayout::kFrameMajor) {
+    if (stride == 0) {
+      stride = dim;
+    }
+    KNF_CHECK_GE(stride, dim);
+
+    for (int32_t t = 0; t != num_frames; ++t) {
+      memcpy(out + static_cast<int64_t>(t) * stride, frames[t],
+             dim * sizeof(float));
+    }
+    return;
+  }
+
+  if (stride == 0) {
+    stride = num_frames;
+  }
+  KNF_CHECK_GE(stride, num_frames);
+
+  for (int32_t t0 = 0; t0 < num_frames; t0 += kTileSize) {
+    int32_t t1 = std::min(t0 + kTileSize, num_frames);
+    for (int32_t d0 = 0; d0 < dim; d0 += kTileSize) {
+      int32_t d1 = std::min(d0 + kTileSize, dim);
+      for (int32_t d = d0; d != d1; ++d) {
+        float *q = out + static_cast<int64_t>(d) * stride;
+        for (int32_t t = t0; t != t1; ++t) {
+          q[t] = frames[t][d];
+        }
+      }
+    }
+  }
+}
+
+}  // namespace knf
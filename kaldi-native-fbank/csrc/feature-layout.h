@@ -0,0 +1,59 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_FEATURE_LAYOUT_H_
+#define KALDI_NATIVE_FBANK_CSRC_FEATURE_LAYOUT_H_
+
+#include <cstdint>
+
+namespace knf {
+
+// Memory layout of a matrix of features written by the batch APIs, e.g.,
+// OnlineGenericBaseFeature::GetFrames() and ChunkAssembler::GetChunk().
+enum class FeatureLayout : int32_t {
+  // [num_frames, dim]. Row t is frame t.
+  kFrameMajor = 0,
+
+  // [dim, num_frames]. Row d holds feature d of all frames, e.g., the
+  // input of Whisper and of many CNN frontends.
+  kFeatureMajor = 1,
+};
+
+/**
+ * Write frames into out with the given layout.
+ *
+ * For kFeatureMajor, the transpose is done in tiles of a few frames, so
+ * that each write touches a full cache line of out and the rows of the
+ * tile stay in the cache.
+ *
+ * @param frames  frames[t] points to the dim features of frame t
+ * @param num_frames  Number of frames
+ * @param dim  Dimension of a frame
+ * @param layout  Layout of out
+ * @param stride  Leading stride of out in floats, i.e., the distance
+ *                between two rows. It should be at least dim for
+ *                kFrameMajor and num_frames for kFeatureMajor. 0 means
+ *                no padding. Padding elements are not written.
+ * @param out  Output matrix
+ */
+void WriteFrames(const float *const *frames, int32_t num_frames, int32_t dim,
+                 FeatureLayout layout, int32_t stride, float *out);
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_FEATURE_LAYOUT_H_
@@ -30,44 +30,31 @@
 #include "kaldi-native-fbank/csrc/feature-window.h"
 #include "kaldi-native-fbank/csrc/kaldi-math.h"
 #include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+#include "kaldi-native-fbank/csrc/simd.h"
 
 namespace knf {
 
-static std::vector<float> ComputeDctMatrix(int32_t num_rows, int32_t num_cols) {
-  // this function is copied from
-  // https://github.com/kaldi-asr/kaldi/blob/master/src/matrix/matrix-functions.cc#L592
-
-  std::vector<float> ans(num_rows * num_cols);
-  float *p = ans.data();
-
-  float normalizer = std::sqrt(1.0 / num_cols);  // normalizer for X_0
-
-  for (int32_t i = 0; i != num_cols; ++i) {
-    p[i] = normalizer;
-  }
-
-  normalizer = std::sqrt(2.0 / num_cols);  // normalizer for other elements
-
-  for (int32_t k = 1; k != num_rows; ++k) {
-    for (int32_t n = 0; n != num_cols; ++n) {
-      *(p + k * num_cols + n) =
-          normalizer *
-          std::cos(static_cast<double>(M_PI) / num_cols * (n + 0.5) * k);
-    }
-  }
-
-  return ans;
-}
-
 std::ostream &operator<<(std::ostream &os, const MfccOptions &opts) {
   os << opts.ToString();
   return os;
 }
 
+static std::vector<float> GetLifterCoeffs(const MfccOptions &opts) {
+  std::vector<float> ans;
+  if (opts.cepstral_lifter != 0.0) {
+    ans.resize(opts.num_ceps);
+    ComputeLifterCoeffs(opts.cepstral_lifter, &ans);
+  }
+  return ans;
+}
+
 MfccComputer::MfccComputer(const MfccOptions &opts)
     : opts_(opts),
+      fast_math_(opts.frame_opts.UseFastMath()),
       rfft_(opts.frame_opts.PaddedWindowSize()),
-      mel_energies_(opts.mel_opts.num_bins) {
+      mel_energies_(opts.mel_opts.num_bins),
+      dct_(opts.num_ceps, opts.mel_opts.num_bins, GetLifterCoeffs(opts)) {
   if (opts.energy_floor > 0.0f) {
     log_energy_floor_ = logf(opts.energy_floor);
   }
@@ -82,39 +69,24 @@ MfccComputer::MfccComputer(const MfccOptions &opts)
       << "num-ceps cannot be larger than num-mel-bins."
       << " It should be smaller or equal. You provided num-ceps: "
       << opts.num_ceps << "  and num-mel-bins: " << num_bins;
-
-  dct_matrix_ = ComputeDctMatrix(opts.num_ceps, num_bins);
-
-  if (opts.cepstral_lifter != 0.0) {
-    lifter_coeffs_ = std::vector<float>(opts.num_ceps);
-    // torch::empty({1, opts.num_ceps}, torch::kFloat32);
-    ComputeLifterCoeffs(opts.cepstral_lifter, &lifter_coeffs_);
-  }
 }
 
-MfccComputer::~MfccComputer() {
-  for (auto iter = mel_banks_.begin(); iter != mel_banks_.end(); ++iter)
-    delete iter->second;
-}
+MfccComputer::~MfccComputer() = default;
 
 const MelBanks *MfccComputer::GetMelBanks(float vtln_warp) {
-  MelBanks *this_mel_banks = nullptr;
-
-  // std::map<float, MelBanks *>::iterator iter = mel_banks_.find(vtln_warp);
   auto iter = mel_banks_.find(vtln_warp);
   if (iter == mel_banks_.end()) {
-    this_mel_banks = new MelBanks(opts_.mel_opts, opts_.frame_opts, vtln_warp);
-    mel_banks_[vtln_warp] = this_mel_banks;
-  } else {
-    this_mel_banks = iter->second;
+    auto mel_banks =
+        MelBanksCache::Get(opts_.mel_opts, opts_.frame_opts, vtln_warp);
+    const MelBanks *ans = mel_banks.get();
+    mel_banks_[vtln_warp] = std::move(mel_banks);
+    return ans;
   }
-  return this_mel_banks;
+  return iter->second.get();
 }
 
 void MfccComputer::Compute(float signal_raw_log_energy, float vtln_warp,
                            std::vector<float> *signal_frame, float *feature) {
-  const MelBanks &mel_banks = *(GetMelBanks(vtln_warp));
-
   KNF_CHECK_EQ(signal_frame->size(), opts_.frame_opts.PaddedWindowSize());
 
   // Compute energy after window function (not the raw one).
@@ -124,50 +96,146 @@ void MfccComputer::Compute(float signal_raw_log_energy, float vtln_warp,
                                      signal_frame->size()),
                         std::numeric_limits<float>::epsilon()));
   }
-  rfft_.Compute(signal_frame->data());  // signal_frame is modified in-place
-  ComputePowerSpectrum(signal_frame);
+  {
+    KNF_PROFILE_SCOPE(kProfileFft);
+    rfft_.Compute(signal_frame->data());  // signal_frame is modified in-place
+  }
+
+  ComputeFromFft(signal_raw_log_energy, vtln_warp, signal_frame->data(),
+                 feature);
+}
+
+void MfccComputer::ComputeFromFft(float log_energy, float vtln_warp,
+                                  float *fft, float *feature) {
+  const MelBanks &mel_banks = *(GetMelBanks(vtln_warp));
+  int32_t n = opts_.frame_opts.PaddedWindowSize();
 
   // Sum with mel filter banks over the power spectrum
-  mel_banks.Compute(signal_frame->data(), mel_energies_.data());
+  mel_banks.ComputeFromFft(fft, n, true, mel_energies_.data());
 
-  // Avoid log of zero (which should be prevented anyway by dithering).
-  for (int32_t i = 0; i != opts_.mel_opts.num_bins; ++i) {
-    auto t = std::max(mel_energies_[i], std::numeric_limits<float>::epsilon());
-    mel_energies_[i] = std::log(t);
-  }
+  ComputeFromMelEnergies(log_energy, feature);
+}
 
-  // feature = dct_matrix_ * mel_energies [which now have log]
-  for (int32_t i = 0; i != opts_.num_ceps; ++i) {
-    feature[i] = InnerProduct(dct_matrix_.data() + i * opts_.mel_opts.num_bins,
-                              mel_energies_.data(), opts_.mel_opts.num_bins);
+void MfccComputer::ComputeFromSpectrum(float log_energy, float vtln_warp,
+                                       const float *spectrum, float *feature) {
+  const MelBanks &mel_banks = *(GetMelBanks(vtln_warp));
+  {
+    KNF_PROFILE_SCOPE(kProfileMel);
+    mel_banks.Compute(spectrum, mel_energies_.data());
   }
 
-  if (opts_.cepstral_lifter != 0.0) {
-    for (int32_t i = 0; i != opts_.num_ceps; ++i) {
-      feature[i] *= lifter_coeffs_[i];
-    }
+  ComputeFromMelEnergies(log_energy, feature);
+}
+
+void MfccComputer::ComputeFromMelEnergies(float log_energy, float *feature) {
+  // Log (floored at epsilon), DCT and liftering are done in a single pass.
+  // C0 is not computed if it will be replaced by the energy.
+  {
+    KNF_PROFILE_SCOPE(kProfileLog);
+    dct_.ComputeLog(mel_energies_.data(), feature, opts_.use_energy,
+                    fast_math_);
   }
 
   if (opts_.use_energy) {
-    if (opts_.energy_floor > 0.0 && signal_raw_log_energy < log_energy_floor_) {
-      signal_raw_log_energy = log_energy_floor_;
+    if (opts_.energy_floor > 0.0 && log_energy < log_energy_floor_) {
+      log_energy = log_energy_floor_;
     }
-    feature[0] = signal_raw_log_energy;
+    feature[0] = log_energy;
   }
 
   if (opts_.htk_compat) {
+    int32_t num_ceps = opts_.num_ceps;
     double energy = feature[0];
 
-    for (int32_t i = 0; i < opts_.num_ceps - 1; ++i) {
-      feature[i] = feature[i + 1];
-    }
+    std::copy(feature + 1, feature + num_ceps, feature);
 
     if (!opts_.use_energy) {
       energy *= M_SQRT2;  // scale on C0 (actually removing a scale
     }
     // we previously added that's part of one common definition of
     // the cosine transform.)
-    feature[opts_.num_ceps - 1] = static_cast<float>(energy);
+    feature[num_ceps - 1] = static_cast<float>(energy);
+  }
+}
+
+void MfccComputer::ComputeBatch(const float *raw_log_energies,
+                                float vtln_warp, std::vector<float> *frames,
+                                int32_t n, float *const *features) {
+  int32_t padded_window_size = opts_.frame_opts.PaddedWindowSize();
+  int32_t num_bins = opts_.mel_opts.num_bins;
+
+  if (opts_.use_energy) {
+    batch_log_energies_.assign(raw_log_energies, raw_log_energies + n);
+    if (!opts_.raw_energy) {
+      // Compute energy after window function (not the raw one).
+      for (int32_t i = 0; i != n; ++i) {
+        batch_log_energies_[i] = std::log(std::max<float>(
+            InnerProduct(frames[i].data(), frames[i].data(),
+                         frames[i].size()),
+            std::numeric_limits<float>::epsilon()));
+      }
+    }
+  }
+
+  for (int32_t i = 0; i != n; ++i) {
+    KNF_CHECK_EQ(frames[i].size(), padded_window_size);
+    KNF_PROFILE_SCOPE(kProfileFft);
+    rfft_.Compute(frames[i].data());
+  }
+
+  const MelBanks &mel_banks = *(GetMelBanks(vtln_warp));
+  batch_mel_energies_.resize(static_cast<int64_t>(n) * num_bins);
+  for (int32_t i = 0; i != n; ++i) {
+    mel_banks.ComputeFromFft(frames[i].data(), padded_window_size, true,
+                             batch_mel_energies_.data() +
+                                 static_cast<int64_t>(i) * num_bins);
+  }
+
+  if (dct_.UseFft()) {
+    for (int32_t i = 0; i != n; ++i) {
+      KNF_PROFILE_SCOPE(kProfileLog);
+      dct_.ComputeLog(batch_mel_energies_.data() +
+                          static_cast<int64_t>(i) * num_bins,
+                      features[i], opts_.use_energy, fast_math_);
+    }
+  } else {
+    // The log over the whole batch and then the DCT of all frames as a
+    // small GEMM. C0 is also computed, but it is replaced below if
+    // use_energy is true, as in ComputeLog().
+    const SimdKernels &kernels = GetSimdKernels();
+    auto log = fast_math_ ? kernels.log_fast : kernels.log;
+    for (int32_t i = 0; i != n; ++i) {
+      KNF_PROFILE_SCOPE(kProfileLog);
+      log(std::numeric_limits<float>::epsilon(),
+          batch_mel_energies_.data() + static_cast<int64_t>(i) * num_bins,
+          num_bins);
+    }
+
+    KNF_PROFILE_SCOPE(kProfileLog);
+    dct_.Compute(batch_mel_energies_.data(), n, features);
+  }
+
+  for (int32_t i = 0; i != n; ++i) {
+    float *feature = features[i];
+    if (opts_.use_energy) {
+      float log_energy = batch_log_energies_[i];
+      if (opts_.energy_floor > 0.0 && log_energy < log_energy_floor_) {
+        log_energy = log_energy_floor_;
+      }
+      feature[0] = log_energy;
+    }
+
+    if (opts_.htk_compat) {
+      int32_t num_ceps = opts_.num_ceps;
+      double energy = feature[0];
+
+      std::copy(feature + 1, feature + num_ceps, feature);
+
+      if (!opts_.use_energy) {
+        energy *= M_SQRT2;  // See ComputeFromFft()
+      }
+      feature[num_ceps - 1] = static_cast<float>(energy);
+    }
   }
 }
 
@@ -25,10 +25,12 @@
 
 #include <cstdint>
 #include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
 
+#include "kaldi-native-fbank/csrc/dct.h"
 #include "kaldi-native-fbank/csrc/feature-window.h"
 #include "kaldi-native-fbank/csrc/mel-computations.h"
 #include "kaldi-native-fbank/csrc/rfft.h"
@@ -128,22 +130,68 @@ class MfccComputer {
   void Compute(float signal_raw_log_energy, float vtln_warp,
                std::vector<float> *signal_frame, float *feature);
 
- private:
+  /**
+     Like Compute(), but it starts from the FFT of the windowed frame so
+     that one FFT can be shared by several computers with the same
+     frame options. See MultiFeatureComputer.
+
+     @param [in] log_energy  The raw log-energy if use_energy and raw_energy
+         are true; the log-energy of the windowed frame if use_energy is true
+         and raw_energy is false. Ignored if use_energy is false.
+     @param [in] vtln_warp  See Compute().
+     @param [in,out] fft  The output of Rfft::Compute() for the windowed
+         frame. It has GetFrameOptions().PaddedWindowSize() elements and is
+         used as a workspace.
+     @param [out] feature  Pointer to a vector of size this->Dim().
+  */
+  void ComputeFromFft(float log_energy, float vtln_warp, float *fft,
+                      float *feature);
+
+  /**
+     Like ComputeFromFft(), but it starts from the spectrum, so that one
+     power spectrum can be shared by several computers. See
+     MultiFeatureComputer.
+
+     @param [in] spectrum  The power spectrum |X|^2. It has
+         GetFrameOptions().PaddedWindowSize() / 2 + 1 elements, but only the
+         fft bins in [GetMelBanks(vtln_warp)->FftBegin(), FftEnd()) are
+         read.
+  */
+  void ComputeFromSpectrum(float log_energy, float vtln_warp,
+                           const float *spectrum, float *feature);
+
+  // Like Compute(), but for n frames, one stage at a time. The stages are
+  // the FFT, the mel filter banks and the log + DCT.
+  // See FbankComputer::ComputeBatch()
+  void ComputeBatch(const float *raw_log_energies, float vtln_warp,
+                    std::vector<float> *frames, int32_t n,
+                    float *const *features);
+
+  // The mel banks for the given VTLN warp factor
   const MelBanks *GetMelBanks(float vtln_warp);
 
+ private:
+  // Log, DCT, liftering and energy of mel_energies_
+  void ComputeFromMelEnergies(float log_energy, float *feature);
+
   MfccOptions opts_;
-  float log_energy_floor_;
-  std::map<float, MelBanks *> mel_banks_;  // float is VTLN coefficient.
+  float log_energy_floor_ = 0;
+  bool fast_math_ = false;  // opts_.frame_opts.accuracy is "fast"
+  // float is VTLN coefficient. The MelBanks are shared with other computers
+  // through MelBanksCache.
+  std::map<float, std::shared_ptr<const MelBanks>> mel_banks_;
   Rfft rfft_;
 
   // temp buffer of size num_mel_bins = opts.mel_opts.num_bins
   std::vector<float> mel_energies_;
 
-  // opts_.num_ceps
-  std::vector<float> lifter_coeffs_;
+  // Used by ComputeBatch(). The mel energies and the log-energies of all
+  // frames of a batch.
+  std::vector<float> batch_mel_energies_;
+  std::vector<float> batch_log_energies_;
 
-  // [num_ceps][num_mel_bins]
-  std::vector<float> dct_matrix_;
+  // DCT with the liftering coefficients folded into it
+  Dct dct_;
 };
 
 }  // namespace knf
@@ -0,0 +1,193 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/feature-multi.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+#include "kaldi-native-fbank/csrc/simd.h"
+
+namespace knf {
+
+std::ostream &operator<<(std::ostream &os, const MultiFeatureOptions &opts) {
+  os << opts.ToString();
+  return os;
+}
+
+MultiFeatureComputer::MultiFeatureComputer(const MultiFeatureOptions &opts)
+    : opts_(opts),
+      rfft_(opts.frame_opts.PaddedWindowSize()),
+      power_(opts.frame_opts.PaddedWindowSize() / 2 + 1) {
+  offsets_.push_back(0);
+
+  for (auto &fbank_opts : opts_.fbank) {
+    fbank_opts.frame_opts = opts_.frame_opts;
+    fbank_.emplace_back(fbank_opts);
+    offsets_.push_back(offsets_.back() + fbank_.back().Dim());
+
+    need_raw_log_energy_ |= fbank_opts.use_energy && fbank_opts.raw_energy;
+    need_log_energy_ |= fbank_opts.use_energy && !fbank_opts.raw_energy;
+    need_magnitude_ |= !fbank_opts.use_power;
+  }
+
+  if (need_magnitude_) {
+    magnitude_.resize(power_.size());
+  }
+
+  for (auto &mfcc_opts : opts_.mfcc) {
+    mfcc_opts.frame_opts = opts_.frame_opts;
+    mfcc_.emplace_back(mfcc_opts);
+    offsets_.push_back(offsets_.back() + mfcc_.back().Dim());
+
+    need_raw_log_energy_ |= mfcc_opts.use_energy && mfcc_opts.raw_energy;
+    need_log_energy_ |= mfcc_opts.use_energy && !mfcc_opts.raw_energy;
+  }
+
+  if (opts_.use_power_spectrum) {
+    offsets_.push_back(offsets_.back() +
+                       opts_.frame_opts.PaddedWindowSize() / 2 + 1);
+  }
+
+  if (opts_.use_energy) {
+    offsets_.push_back(offsets_.back() + 1);
+
+    need_raw_log_energy_ |= opts_.raw_energy;
+    need_log_energy_ |= !opts_.raw_energy;
+  }
+
+  if (NumHeads() == 0) {
+    fprintf(stderr, "MultiFeatureOptions has no heads\n");
+    exit(-1);
+  }
+}
+
+void MultiFeatureComputer::Compute(float signal_raw_log_energy,
+                                   float vtln_warp,
+                                   std::vector<float> *signal_frame,
+                                   float *feature) {
+  KNF_CHECK_EQ(signal_frame->size(), opts_.frame_opts.PaddedWindowSize());
+
+  // Energy after the window function, for heads with raw_energy false
+  float log_energy = 0;
+  if (need_log_energy_) {
+    log_energy = std::log(
+        std::max<float>(InnerProduct(signal_frame->data(), signal_frame->data(),
+                                     signal_frame->size()),
+                        std::numeric_limits<float>::epsilon()));
+  }
+
+  {
+    KNF_PROFILE_SCOPE(kProfileFft);
+    rfft_.Compute(signal_frame->data());  // signal_frame is modified in-place
+  }
+
+  const float *fft = signal_frame->data();
+  int32_t half = static_cast<int32_t>(signal_frame->size()) / 2;
+
+  // The union of the fft bins used by the heads
+  int32_t begin = half + 1;
+  int32_t end = 0;
+  int32_t magnitude_begin = half + 1;
+  int32_t magnitude_end = 0;
+  for (auto &computer : fbank_) {
+    const MelBanks *mel_banks = computer.GetMelBanks(vtln_warp);
+    begin = std::min(begin, mel_banks->FftBegin());
+    end = std::max(end, mel_banks->FftEnd());
+    if (!computer.GetOptions().use_power) {
+      magnitude_begin = std::min(magnitude_begin, mel_banks->FftBegin());
+      magnitude_end = std::max(magnitude_end, mel_banks->FftEnd());
+    }
+  }
+
+  for (auto &computer : mfcc_) {
+    const MelBanks *mel_banks = computer.GetMelBanks(vtln_warp);
+    begin = std::min(begin, mel_banks->FftBegin());
+    end = std::max(end, mel_banks->FftEnd());
+  }
+
+  // The power spectrum head is after the fbank and mfcc heads
+  float *power = power_.data();
+  if (opts_.use_power_spectrum) {
+    power = feature + offsets_[fbank_.size() + mfcc_.size()];
+    begin = 0;
+    end = half + 1;
+  }
+  end = std::min(end, half + 1);
+
+  if (end > begin) {
+    // See ComputePowerSpectrum()
+    KNF_PROFILE_SCOPE(kProfilePowerSpectrum);
+    int32_t k0 = std::max(begin, 1);
+    int32_t k1 = std::min(end, half);
+    if (k1 > k0) {
+      GetSimdKernels().complex_squared_norm(fft + 2 * k0, power + k0,
+                                            k1 - k0);
+    }
+
+    if (begin == 0) {
+      power[0] = fft[0] * fft[0];
+    }
+
+    if (end == half + 1) {
+      power[half] = fft[1] * fft[1];
+    }
+  }
+
+  magnitude_end = std::min(magnitude_end, half + 1);
+  if (magnitude_end > magnitude_begin) {
+    KNF_PROFILE_SCOPE(kProfilePowerSpectrum);
+    std::copy(power + magnitude_begin, power + magnitude_end,
+              magnitude_.begin() + magnitude_begin);
+    GetSimdKernels().sqrt(magnitude_.data() + magnitude_begin,
+                          magnitude_end - magnitude_begin);
+  }
+
+  int32_t h = 0;
+  for (auto &computer : fbank_) {
+    const FbankOptions &opts = computer.GetOptions();
+    float energy = opts.raw_energy ? signal_raw_log_energy : log_energy;
+    computer.ComputeFromSpectrum(energy, vtln_warp,
+                                 opts.use_power ? power : magnitude_.data(),
+                                 feature + offsets_[h++]);
+  }
+
+  for (auto &computer : mfcc_) {
+    const MfccOptions &opts = computer.GetOptions();
+    float energy = opts.raw_energy ? signal_raw_log_energy : log_energy;
+    computer.ComputeFromSpectrum(energy, vtln_warp, power,
+                                 feature + offsets_[h++]);
+  }
+
+  if (opts_.use_power_spectrum) {
+    ++h;  // It is computed above
+  }
+
+  if (opts_.use_energy) {
+    feature[offsets_[h++]] =
+        opts_.raw_energy ? signal_raw_log_energy : log_energy;
+  }
+}
+
+}  // namespace knf
@@ -0,0 +1,143 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Several features from one pass over the signal, e.g., fbank for an ASR
+// model and MFCC for a speaker model. The window, the FFT and the power
+// spectrum are computed once per frame and shared by all heads.
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_FEATURE_MULTI_H_
+#define KALDI_NATIVE_FBANK_CSRC_FEATURE_MULTI_H_
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/feature-fbank.h"
+#include "kaldi-native-fbank/csrc/feature-mfcc.h"
+#include "kaldi-native-fbank/csrc/feature-window.h"
+#include "kaldi-native-fbank/csrc/rfft.h"
+
+namespace knf {
+
+struct MultiFeatureOptions {
+  // Shared by all heads. The frame_opts of fbank and mfcc are ignored.
+  FrameExtractionOptions frame_opts;
+
+  // One head per element
+  std::vector<FbankOptions> fbank;
+  std::vector<MfccOptions> mfcc;
+
+  // If true, add a head with the power spectrum, i.e., |X|^2 of the fft
+  // bins from 0 to the Nyquist frequency
+  bool use_power_spectrum = false;
+
+  // If true, add a head with the log energy of the frame
+  bool use_energy = false;
+
+  // If true, compute the energy before preemphasis and windowing
+  bool raw_energy = true;  // active iff use_energy==true
+
+  std::string ToString() const {
+    std::ostringstream os;
+    os << "frame_opts: \n";
+    os << frame_opts << "\n";
+    os << "\n";
+
+    for (const auto &opts : fbank) {
+      os << "fbank: \n";
+      os << opts << "\n";
+    }
+
+    for (const auto &opts : mfcc) {
+      os << "mfcc: \n";
+      os << opts << "\n";
+    }
+
+    os << "use_power_spectrum: " << use_power_spectrum << "\n";
+    os << "use_energy: " << use_energy << "\n";
+    os << "raw_energy: " << raw_energy << "\n";
+    return os.str();
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const MultiFeatureOptions &opts);
+
+/// A frame of the output is the concatenation of the heads in the order
+/// fbank[0], fbank[1], ..., mfcc[0], mfcc[1], ..., the power spectrum and
+/// the energy. Use HeadOffset() and HeadDim() to split it.
+///
+/// Head i gives the same result as the computer of its own options with
+/// frame_opts replaced by MultiFeatureOptions::frame_opts, e.g., the
+/// output of OnlineMultiFeature can be compared with that of OnlineFbank.
+/// Note that the dithering noise is also shared.
+class MultiFeatureComputer {
+ public:
+  using Options = MultiFeatureOptions;
+
+  explicit MultiFeatureComputer(const MultiFeatureOptions &opts);
+
+  int32_t Dim() const { return offsets_.back(); }
+
+  bool NeedRawLogEnergy() const { return need_raw_log_energy_; }
+
+  const FrameExtractionOptions &GetFrameOptions() const {
+    return opts_.frame_opts;
+  }
+
+  const MultiFeatureOptions &GetOptions() const { return opts_; }
+
+  int32_t NumHeads() const { return static_cast<int32_t>(offsets_.size()) - 1; }
+
+  /// Offset of head i in a frame of the output
+  int32_t HeadOffset(int32_t i) const { return offsets_[i]; }
+
+  int32_t HeadDim(int32_t i) const { return offsets_[i + 1] - offsets_[i]; }
+
+  /// See FbankComputer::Compute()
+  void Compute(float signal_raw_log_energy, float vtln_warp,
+               std::vector<float> *signal_frame, float *feature);
+
+ private:
+  MultiFeatureOptions opts_;
+  std::vector<FbankComputer> fbank_;
+  std::vector<MfccComputer> mfcc_;
+
+  // offsets_[i] is the offset of head i. The last entry is Dim().
+  std::vector<int32_t> offsets_;
+
+  bool need_raw_log_energy_ = false;
+  bool need_log_energy_ = false;  // of the windowed frame
+
+  // Fbank heads with use_power false need the magnitude spectrum
+  bool need_magnitude_ = false;
+
+  Rfft rfft_;
+
+  // The power spectrum of a frame, of size PaddedWindowSize() / 2 + 1. It is
+  // computed only for the fft bins used by at least one head. Not used if
+  // there is a power spectrum head, which holds it instead.
+  std::vector<float> power_;
+
+  // The magnitude spectrum for fbank heads with use_power false
+  std::vector<float> magnitude_;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_FEATURE_MULTI_H_
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file is copied/modified from kaldi/src/feat/feature-spectrogram.cc
+
+#include "kaldi-native-fbank/csrc/feature-spectrogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+#include "kaldi-native-fbank/csrc/simd.h"
+
+namespace knf {
+
+std::ostream &operator<<(std::ostream &os, const SpectrogramOptions &opts) {
+  os << opts.ToString();
+  return os;
+}
+
+SpectrogramComputer::SpectrogramComputer(const SpectrogramOptions &opts)
+    : opts_(opts),
+      fast_math_(opts.frame_opts.UseFastMath()),
+      rfft_(opts.frame_opts.PaddedWindowSize()) {
+  if (opts.energy_floor > 0.0f) {
+    log_energy_floor_ = logf(opts.energy_floor);
+  }
+
+  int32_t n = opts.frame_opts.PaddedWindowSize();
+  float sample_freq = opts.frame_opts.samp_freq;
+  float nyquist = 0.5f * sample_freq;
+
+  float high_freq;
+  if (opts.high_freq > 0.0f) {
+    high_freq = opts.high_freq;
+  } else {
+    high_freq = nyquist + opts.high_freq;
+  }
+
+  if (high_freq <= 0.0f || high_freq > nyquist) {
+    fprintf(stderr, "Bad values in options: high-freq %g vs. nyquist %g\n",
+            high_freq, nyquist);
+    exit(-1);
+  }
+
+  float fft_bin_width = sample_freq / n;
+  num_bins_ = std::min(static_cast<int32_t>(high_freq / fft_bin_width) + 1,
+                       n / 2 + 1);
+  if (num_bins_ < 1) {
+    fprintf(stderr, "Invalid number of bins %d. Please check high-freq\n",
+            num_bins_);
+    exit(-1);
+  }
+}
+
+void SpectrogramComputer::Compute(float signal_raw_log_energy,
+                                  float /*vtln_warp*/,
+                                  std::vector<float> *signal_frame,
+                                  float *feature) {
+  KNF_CHECK_EQ(signal_frame->size(), opts_.frame_opts.PaddedWindowSize());
+
+  // Compute energy after window function (not the raw one).
+  if (opts_.use_energy && !opts_.raw_energy) {
+    signal_raw_log_energy = std::log(
+        std::max<float>(InnerProduct(signal_frame->data(), signal_frame->data(),
+                                     signal_frame->size()),
+                        std::numeric_limits<float>::epsilon()));
+  }
+
+  {
+    KNF_PROFILE_SCOPE(kProfileFft);
+    rfft_.Compute(signal_frame->data());  // signal_frame is modified in-place
+  }
+
+  // See ComputePowerSpectrum(). Only the first num_bins_ bins are computed.
+  const float *fft = signal_frame->data();
+  int32_t half = static_cast<int32_t>(signal_frame->size()) / 2;
+  const SimdKernels &kernels = GetSimdKernels();
+
+  feature[0] = fft[0] * fft[0];
+  kernels.complex_squared_norm(fft + 2, feature + 1,
+                               std::min(num_bins_, half) - 1);
+  if (num_bins_ > half) {
+    feature[half] = fft[1] * fft[1];
+  }
+
+  if (opts_.use_log) {
+    KNF_PROFILE_SCOPE(kProfileLog);
+    auto log = fast_math_ ? kernels.log_fast : kernels.log;
+    log(std::numeric_limits<float>::epsilon(), feature, num_bins_);
+  }
+
+  if (opts_.use_energy) {
+    if (opts_.energy_floor > 0.0 && signal_raw_log_energy < log_energy_floor_) {
+      signal_raw_log_energy = log_energy_floor_;
+    }
+    feature[0] = signal_raw_log_energy;
+  }
+}
+
+}  // namespace knf
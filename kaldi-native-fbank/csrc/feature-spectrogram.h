@@ -0,0 +1,110 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file is copied/modified from kaldi/src/feat/feature-spectrogram.h
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_FEATURE_SPECTROGRAM_H_
+#define KALDI_NATIVE_FBANK_CSRC_FEATURE_SPECTROGRAM_H_
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/feature-window.h"
+#include "kaldi-native-fbank/csrc/rfft.h"
+
+namespace knf {
+
+struct SpectrogramOptions {
+  FrameExtractionOptions frame_opts;
+
+  // Floor on energy (absolute, not relative) in Spectrogram
+  // computation. Caution: this floor is applied to the zeroth
+  // component, representing the total signal energy. The
+  // floor on the individual spectrogram elements is fixed at
+  // std::numeric_limits<float>::epsilon().
+  float energy_floor = 0.0f;  // active iff use_energy==true
+
+  // If true, compute energy before preemphasis and windowing
+  bool raw_energy = true;  // active iff use_energy==true
+
+  // If true (default), replace the zeroth bin with the log energy of the
+  // frame, like Kaldi. If false, the zeroth bin is the power of the DC
+  // component.
+  bool use_energy = true;
+
+  // If true (default), output log power, else power
+  bool use_log = true;
+
+  // An upper frequency cutoff. Bins above it are not computed.
+  // 0 -> no cutoff, negative -> added to the Nyquist frequency to get
+  // the cutoff.
+  float high_freq = 0;
+
+  std::string ToString() const {
+    std::ostringstream os;
+    os << "frame_opts: \n";
+    os << frame_opts << "\n";
+    os << "\n";
+
+    os << "energy_floor: " << energy_floor << "\n";
+    os << "raw_energy: " << raw_energy << "\n";
+    os << "use_energy: " << use_energy << "\n";
+    os << "use_log: " << use_log << "\n";
+    os << "high_freq: " << high_freq << "\n";
+    return os.str();
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const SpectrogramOptions &opts);
+
+/// Bin k is the power of the fft bin with frequency k * sample_freq / N,
+/// where N is frame_opts.PaddedWindowSize(). There are N / 2 + 1 bins
+/// without high_freq.
+class SpectrogramComputer {
+ public:
+  using Options = SpectrogramOptions;
+
+  explicit SpectrogramComputer(const SpectrogramOptions &opts);
+
+  int32_t Dim() const { return num_bins_; }
+
+  bool NeedRawLogEnergy() const { return opts_.use_energy && opts_.raw_energy; }
+
+  const FrameExtractionOptions &GetFrameOptions() const {
+    return opts_.frame_opts;
+  }
+
+  const SpectrogramOptions &GetOptions() const { return opts_; }
+
+  /// See FbankComputer::Compute()
+  void Compute(float signal_raw_log_energy, float vtln_warp,
+               std::vector<float> *signal_frame, float *feature);
+
+ private:
+  SpectrogramOptions opts_;
+  int32_t num_bins_ = 0;
+  float log_energy_floor_ = 0;
+  bool fast_math_ = false;  // opts_.frame_opts.accuracy is "fast"
+  Rfft rfft_;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_FEATURE_SPECTROGRAM_H_
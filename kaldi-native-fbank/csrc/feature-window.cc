@@ -10,9 +10,15 @@
 #include <cmath>
 #include <cstddef>
 #include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "kaldi-native-fbank/csrc/kaldi-math.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+#include "kaldi-native-fbank/csrc/shared-cache.h"
+#include "kaldi-native-fbank/csrc/simd.h"
 
 namespace knf {
 
@@ -21,6 +27,53 @@ std::ostream &operator<<(std::ostream &os, const FrameExtractionOptions &opts) {
   return os;
 }
 
+bool FrameExtractionOptions::UseFastMath() const {
+  if (accuracy == "exact") {
+    return false;
+  }
+
+  if (accuracy == "fast") {
+    return true;
+  }
+
+  fprintf(stderr, "Invalid accuracy '%s'. Valid values are: exact, fast\n",
+          accuracy.c_str());
+  exit(-1);
+}
+
+const char *FeatureDtypeName(FeatureDtype dtype) {
+  switch (dtype) {
+    case FeatureDtype::kFloat32:
+      return "float32";
+    case FeatureDtype::kFloat16:
+      return "float16";
+    case FeatureDtype::kBFloat16:
+      return "bfloat16";
+    default:
+      return "unknown";
+  }
+}
+
+FeatureDtype FrameExtractionOptions::OutputDtype() const {
+  if (output_dtype == "float32") {
+    return FeatureDtype::kFloat32;
+  }
+
+  if (output_dtype == "float16") {
+    return FeatureDtype::kFloat16;
+  }
+
+  if (output_dtype == "bfloat16") {
+    return FeatureDtype::kBFloat16;
+  }
+
+  fprintf(stderr,
+          "Invalid output_dtype '%s'. Valid values are: float32, float16, "
+          "bfloat16\n",
+          output_dtype.c_str());
+  exit(-1);
+}
+
 std::vector<float> GetWindow(const std::string &window_type,
                              int32_t window_size,
                              float blackman_coeff /*= 0.42*/) {
@@ -66,24 +119,56 @@ std::vector<float> GetWindow(const std::string &window_type,
   return window;
 }
 
+namespace {
+
+using WindowKey = std::tuple<std::string, int32_t, float>;
+
+using WindowCacheImpl = SharedCache<WindowKey, std::vector<float>>;
+
+WindowCacheImpl &GetWindowCacheImpl() {
+  // It is never destroyed. See SharedCache
+  static auto *cache = new WindowCacheImpl;
+  return *cache;
+}
+
+}  // namespace
+
+std::shared_ptr<const std::vector<float>> WindowCache::Get(
+    const std::string &window_type, int32_t window_size,
+    float blackman_coeff /*= 0.42*/) {
+  WindowKey key{window_type, window_size,
+                window_type == "blackman" ? blackman_coeff : 0.0f};
+  return GetWindowCacheImpl().Get(key, [&]() {
+    return std::make_shared<const std::vector<float>>(
+        GetWindow(window_type, window_size, blackman_coeff));
+  });
+}
+
+int32_t WindowCache::Size() { return GetWindowCacheImpl().Size(); }
+
 FeatureWindowFunction::FeatureWindowFunction(const FrameExtractionOptions &opts)
     : FeatureWindowFunction(opts.window_type, opts.WindowSize(),
-                            opts.blackman_coeff) {}
+                            opts.blackman_coeff) {
+  fast_math_ = opts.UseFastMath();
+}
 
 FeatureWindowFunction::FeatureWindowFunction(const std::string &window_type,
                                              int32_t window_size,
                                              float blackman_coeff /*= 0.42*/)
-    : window_(knf::GetWindow(window_type, window_size, blackman_coeff)) {}
+    : window_(WindowCache::Get(window_type, window_size, blackman_coeff)) {}
 
 FeatureWindowFunction::FeatureWindowFunction(const std::vector<float> &window)
-    : window_(window) {}
+    : window_(std::make_shared<const std::vector<float>>(window)) {}
 
 void FeatureWindowFunction::Apply(float *wave) const {
-  int32_t window_size = window_.size();
-  const float *p = window_.data();
-  for (int32_t k = 0; k != window_size; ++k) {
-    wave[k] *= p[k];
-  }
+  GetSimdKernels().multiply(window_->data(), wave, window_->size());
+}
+
+void FeatureWindowFunction::ApplyWithPreemphasis(float *wave, float mean,
+                                                 float preemph_coeff) const {
+  GetSimdKernels().preemphasize_and_window(window_->data(), mean,
+                                           preemph_coeff, wave,
+                                           window_->size());
 }
 
 int64_t FirstSampleOfFrame(int32_t frame, const FrameExtractionOptions &opts) {
@@ -146,7 +231,8 @@ void ExtractWindow(int64_t sample_offset, const std::vector<float> &wave,
                    int32_t f, const FrameExtractionOptions &opts,
                    const FeatureWindowFunction &window_function,
                    std::vector<float> *window,
-                   float *log_energy_pre_window /*= nullptr*/) {
+                   float *log_energy_pre_window /*= nullptr*/,
+                   std::vector<float> *scratch /*= nullptr*/) {
   KNF_CHECK(sample_offset >= 0 && wave.size() != 0);
 
   int32_t frame_length = opts.WindowSize();
@@ -173,9 +259,11 @@ void ExtractWindow(int64_t sample_offset, const std::vector<float> &wave,
 
   if (wave_start >= 0 && wave_end <= wave.size()) {
     // the normal case-- no edge effects to consider.
+    KNF_PROFILE_SCOPE(kProfileFraming);
     std::copy(wave.begin() + wave_start,
               wave.begin() + wave_start + frame_length, window->data());
   } else {
+    KNF_PROFILE_SCOPE(kProfileFraming);
     // Deal with any end effects by reflection, if needed.  This code will only
     // be reached for about two frames per utterance, so we don't concern
     // ourselves excessively with efficiency.
@@ -197,78 +285,91 @@ void ExtractWindow(int64_t sample_offset, const std::vector<float> &wave,
     }
   }
 
-  ProcessWindow(opts, window_function, window->data(), log_energy_pre_window);
-}
-
-static void RemoveDcOffset(float *d, int32_t n) {
-  float sum = 0;
-  for (int32_t i = 0; i != n; ++i) {
-    sum += d[i];
-  }
-
-  float mean = sum / n;
-
-  for (int32_t i = 0; i != n; ++i) {
-    d[i] -= mean;
-  }
+  ProcessWindow(opts, window_function, window->data(), log_energy_pre_window,
+                scratch);
 }
 
 float InnerProduct(const float *a, const float *b, int32_t n) {
-  float sum = 0;
-  for (int32_t i = 0; i != n; ++i) {
-    sum += a[i] * b[i];
-  }
-  return sum;
+  return GetSimdKernels().inner_product(a, b, n);
 }
 
-void Dither(float *d, int32_t n, float dither_value) {
+static void Dither(float *d, int32_t n, float dither_value, bool fast_math,
+                   std::vector<float> *scratch) {
   if (dither_value == 0.0) {
     return;
   }
 
   RandomState rstate;
-  for (int32_t i = 0; i < n; ++i) {
-    d[i] += RandGauss(&rstate) * dither_value;
+  if (!fast_math) {
+    for (int32_t i = 0; i < n; ++i) {
+      d[i] += RandGauss(&rstate) * dither_value;
+    }
+    return;
   }
-}
 
-static void Preemphasize(float *d, int32_t n, float preemph_coeff) {
-  if (preemph_coeff == 0.0) {
-    return;
+  // The Box-Muller transform gives two samples for each pair of uniform
+  // random numbers. buf contains [u1, u2, samples]
+  int32_t m = (n + 1) / 2;
+  std::vector<float> local;
+  std::vector<float> &buf = scratch ? *scratch : local;
+  if (static_cast<int32_t>(buf.size()) < 4 * m) {
+    buf.resize(4 * m);
+  }
+
+  for (int32_t i = 0; i != 2 * m; ++i) {
+    buf[i] = RandUniform(&rstate);
   }
 
-  KNF_CHECK(preemph_coeff >= 0.0 && preemph_coeff <= 1.0);
+  float *gauss = buf.data() + 2 * m;
+  GetSimdKernels().gauss(buf.data(), buf.data() + m, gauss, m);
 
-  for (int32_t i = n - 1; i > 0; --i) {
-    d[i] -= preemph_coeff * d[i - 1];
+  for (int32_t i = 0; i < n; ++i) {
+    d[i] += gauss[i] * dither_value;
   }
-  d[0] -= preemph_coeff * d[0];
 }
 
 void ProcessWindow(const FrameExtractionOptions &opts,
                    const FeatureWindowFunction &window_function, float *window,
-                   float *log_energy_pre_window /*= nullptr*/) {
+                   float *log_energy_pre_window /*= nullptr*/,
+                   std::vector<float> *scratch /*= nullptr*/) {
+  KNF_PROFILE_SCOPE(kProfileWindow);
+
   int32_t frame_length = opts.WindowSize();
+  bool fast_math = window_function.UseFastMath();
 
   if (opts.dither != 0.0) {
-    Dither(window, frame_length, opts.dither);
+    Dither(window, frame_length, opts.dither, fast_math, scratch);
   }
 
+  const SimdKernels &kernels = GetSimdKernels();
+
+  float mean = 0;
   if (opts.remove_dc_offset) {
-    RemoveDcOffset(window, frame_length);
+    mean = kernels.sum(window, frame_length) / frame_length;
   }
 
   if (log_energy_pre_window != NULL) {
-    float energy = std::max<float>(InnerProduct(window, window, frame_length),
-                                   std::numeric_limits<float>::epsilon());
-    *log_energy_pre_window = std::log(energy);
-  }
+    // The energy is computed after removing the DC offset, so we cannot
+    // defer it to the fused kernel below.
+    if (opts.remove_dc_offset) {
+      kernels.add_scalar(-mean, window, frame_length);
+      mean = 0;
+    }
 
-  if (opts.preemph_coeff != 0.0) {
-    Preemphasize(window, frame_length, opts.preemph_coeff);
+    const float kEps = std::numeric_limits<float>::epsilon();
+    float energy = InnerProduct(window, window, frame_length);
+    if (fast_math) {
+      kernels.log_fast(kEps, &energy, 1);
+    } else {
+      energy = std::log(std::max(energy, kEps));
+    }
+    *log_energy_pre_window = energy;
   }
 
-  window_function.Apply(window);
+  KNF_CHECK(opts.preemph_coeff >= 0.0 && opts.preemph_coeff <= 1.0);
+
+  // Remove the DC offset, pre-emphasize and apply the window in one pass
+  window_function.ApplyWithPreemphasis(window, mean, opts.preemph_coeff);
 }
 
 }  // namespace knf
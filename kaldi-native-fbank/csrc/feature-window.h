@@ -8,6 +8,7 @@
 #define KALDI_NATIVE_FBANK_CSRC_FEATURE_WINDOW_H_
 
 #include <cstdint>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -28,6 +29,17 @@ inline int32_t RoundUpToNearestPowerOfTwo(int32_t n) {
   return n + 1;
 }
 
+// Element type of the features stored by the online extractors.
+// See FrameExtractionOptions::output_dtype
+enum class FeatureDtype {
+  kFloat32,
+  kFloat16,  // IEEE half precision
+  kBFloat16,
+};
+
+// Return "float32", "float16" or "bfloat16"
+const char *FeatureDtypeName(FeatureDtype dtype);
+
 struct FrameExtractionOptions {
   float samp_freq = 16000;
   float frame_shift_ms = 10.0f;   // in milliseconds.
@@ -47,8 +59,38 @@ struct FrameExtractionOptions {
   bool round_to_power_of_two = true;
   float blackman_coeff = 0.42f;
   bool snip_edges = true;
-  // bool allow_downsample = false;
-  // bool allow_upsample = false;
+  // If true, the input of OnlineGenericBaseFeature::AcceptWaveform() can
+  // have a higher (or lower) sampling rate than samp_freq. It is resampled
+  // to samp_freq. See resample.h
+  bool allow_downsample = false;
+  bool allow_upsample = false;
+
+  // Accuracy of the math functions evaluated for each frame, i.e., the log
+  // of the energy and of the mel energies, and the Gaussian random numbers
+  // for dithering. "exact" or "fast".
+  //  - exact: std::log() and RandGauss(), the same results as Kaldi.
+  //  - fast: Polynomial approximations with an error less than 1e-4.
+  //          See log_fast and gauss in simd.h
+  std::string accuracy = "exact";
+
+  // Return true if accuracy is "fast". It is an error if accuracy is
+  // neither "exact" nor "fast".
+  //
+  // It compares strings, so call it once when a computer is constructed
+  // and not for each frame.
+  bool UseFastMath() const;
+
+  // Element type of the features stored by the online extractors, e.g.,
+  // OnlineFbank. "float32", "float16" or "bfloat16".
+  //
+  // With "float16" or "bfloat16", each frame is computed in float32 and
+  // converted right after it is computed, so it takes half the memory and
+  // can be fed to a model in that type without another pass. Such frames
+  // are read with GetHalfFrame() instead of GetFrame().
+  std::string output_dtype = "float32";
+
+  // It is an error if output_dtype is invalid
+  FeatureDtype OutputDtype() const;
 
   int32_t WindowShift() const {
     return static_cast<int32_t>(samp_freq * 0.001f * frame_shift_ms);
@@ -73,8 +115,10 @@ struct FrameExtractionOptions {
     KNF_PRINT(round_to_power_of_two);
     KNF_PRINT(blackman_coeff);
     KNF_PRINT(snip_edges);
-    // KNF_PRINT(allow_downsample);
-    // KNF_PRINT(allow_upsample);
+    KNF_PRINT(allow_downsample);
+    KNF_PRINT(allow_upsample);
+    KNF_PRINT(accuracy);
+    KNF_PRINT(output_dtype);
 #undef KNF_PRINT
     return os.str();
   }
@@ -98,10 +142,54 @@ class FeatureWindowFunction {
    */
   void Apply(float *wave) const;
 
-  const std::vector<float> &GetWindow() const { return window_; }
+  /**
+   * A fused version of removing the DC offset, pre-emphasis and Apply(),
+   * with the same results. It is done in a single pass over wave:
+   *
+   *   y[i] = wave[i] - mean
+   *   wave[i] = window[i] * (y[i] - preemph_coeff * y[i-1]), y[-1] = y[0]
+   *
+   * @param wave Pointer to a 1-D array of shape [window_size].
+   *             It is modified in-place.
+   * @param mean The DC offset to remove. Use 0 to skip it.
+   * @param preemph_coeff Use 0 to skip pre-emphasis.
+   */
+  void ApplyWithPreemphasis(float *wave, float mean,
+                            float preemph_coeff) const;
+
+  const std::vector<float> &GetWindow() const { return *window_; }
+
+  // True if it is constructed from FrameExtractionOptions whose accuracy
+  // is "fast". Used by ProcessWindow().
+  bool UseFastMath() const { return fast_math_; }
 
  private:
-  std::vector<float> window_;  // of size opts.WindowSize()
+  // of size opts.WindowSize(). It is immutable, so copies of a
+  // FeatureWindowFunction share it.
+  std::shared_ptr<const std::vector<float>> window_ =
+      std::make_shared<const std::vector<float>>();
+
+  bool fast_math_ = false;
+};
+
+// A cache of window tables. Computing a window needs a cos() (and a pow()
+// for "povey") per sample, so FeatureWindowFunction takes it from here and
+// all instances with the same config share the same immutable table.
+// An entry is freed when the last FeatureWindowFunction using it is
+// destroyed.
+//
+// All methods are thread-safe.
+class WindowCache {
+ public:
+  // Return the window for the given config, creating it if it is not
+  // in the cache. blackman_coeff is ignored unless window_type is
+  // "blackman".
+  static std::shared_ptr<const std::vector<float>> Get(
+      const std::string &window_type, int32_t window_size,
+      float blackman_coeff = 0.42);
+
+  // Return the number of windows in the cache that are still being used.
+  static int32_t Size();
 };
 
 int64_t FirstSampleOfFrame(int32_t frame, const FrameExtractionOptions &opts);
@@ -148,12 +236,14 @@ int32_t NumFrames(int64_t num_samples, const FrameExtractionOptions &opts,
   @param [out] log_energy_pre_window  If non-NULL, the log-energy of
                    the signal prior to pre-emphasis and multiplying by
                    the windowing function will be written to here.
+  @param [in,out] scratch  See ProcessWindow().
 */
 void ExtractWindow(int64_t sample_offset, const std::vector<float> &wave,
                    int32_t f, const FrameExtractionOptions &opts,
                    const FeatureWindowFunction &window_function,
                    std::vector<float> *window,
-                   float *log_energy_pre_window = nullptr);
+                   float *log_energy_pre_window = nullptr,
+                   std::vector<float> *scratch = nullptr);
 
 /**
   This function does all the windowing steps after actually
@@ -171,10 +261,17 @@ void ExtractWindow(int64_t sample_offset, const std::vector<float> &wave,
    @param [out]   log_energy_pre_window If non-NULL, then after dithering and
       DC offset removal, this function will write to this pointer the log of
       the total energy (i.e. sum-squared) of the frame.
+   @param [in,out] scratch  If non-NULL, the workspace for dithering with
+      accuracy "fast". Pass the same vector for all frames so that no memory
+      is allocated per frame. It is resized as needed.
+
+   The accuracy is taken from window_function, so that opts.accuracy is not
+   parsed for each frame.
  */
 void ProcessWindow(const FrameExtractionOptions &opts,
                    const FeatureWindowFunction &window_function, float *window,
-                   float *log_energy_pre_window = nullptr);
+                   float *log_energy_pre_window = nullptr,
+                   std::vector<float> *scratch = nullptr);
 
 // Compute the inner product of two vectors
 float InnerProduct(const float *a, const float *b, int32_t n);
@@ -19,11 +19,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <mutex>  // NOLINT
 #include <sstream>
 #include <string>
 #include <utility>
 
 #include "kaldi-native-fbank/csrc/feature-window.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
 #include "kaldi-native-fbank/csrc/rfft.h"
 
 namespace knf {
@@ -40,6 +42,11 @@ class IStft::Impl {
   }
 
   std::vector<float> Compute(const StftResult &stft_result) const {
+#if KNF_ENABLE_PROFILING
+    ProfileStats stats;
+    KNF_PROFILE_STATS(&stats);
+#endif
+
     Rfft rfft(config_.n_fft, true);
 
     int32_t num_samples =
@@ -48,10 +55,17 @@ class IStft::Impl {
     std::vector<float> samples(num_samples);
     for (int32_t i = 0; i < stft_result.num_frames; ++i) {
       auto x = InverseFFT(stft_result, i, &rfft);
+#if KNF_ENABLE_PROFILING
+      stats.bytes_allocated += CapacityInBytes(x);
+#endif
       OverlapAdd(std::move(x), i, &samples);
     }
 
     auto denominator = GetDenominator(stft_result.num_frames);
+#if KNF_ENABLE_PROFILING
+    stats.bytes_allocated +=
+        CapacityInBytes(samples) + CapacityInBytes(denominator);
+#endif
 
     for (int32_t i = 0; i < num_samples; ++i) {
       if (denominator[i]) {
@@ -62,11 +76,30 @@ class IStft::Impl {
     if (config_.center) {
       samples = {samples.begin() + config_.n_fft / 2,
                  samples.end() - config_.n_fft / 2};
+#if KNF_ENABLE_PROFILING
+      stats.bytes_allocated += CapacityInBytes(samples);
+#endif
     }
 
+#if KNF_ENABLE_PROFILING
+    stats.frames_processed = stft_result.num_frames;
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.Merge(stats);
+#endif
+
     return samples;
   }
 
+  ProfileStats GetStats() const {
+#if KNF_ENABLE_PROFILING
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+#else
+    return {};
+#endif
+  }
+
   std::vector<float> InverseFFT(const StftResult &r, int32_t frame_index,
                                 Rfft *rfft) const {
     int32_t n_fft = config_.n_fft;
@@ -91,7 +124,10 @@ class IStft::Impl {
       }
     }
 
-    rfft->Compute(tmp.data());
+    {
+      KNF_PROFILE_SCOPE(kProfileFft);
+      rfft->Compute(tmp.data());
+    }
 
     scale = 1.0f / n_fft;
     for (auto &f : tmp) {
@@ -103,6 +139,7 @@ class IStft::Impl {
 
   void OverlapAdd(std::vector<float> current_frame, int32_t frame_index,
                   std::vector<float> *samples) const {
+    KNF_PROFILE_SCOPE(kProfileOverlapAdd);
     if (window_) {
       window_->Apply(current_frame.data());
     }
@@ -144,6 +181,11 @@ class IStft::Impl {
  private:
   StftConfig config_;
   std::unique_ptr<FeatureWindowFunction> window_;
+
+#if KNF_ENABLE_PROFILING
+  mutable std::mutex mutex_;
+  mutable ProfileStats stats_;
+#endif
 };
 
 IStft::IStft(const StftConfig &config)
@@ -155,4 +197,6 @@ std::vector<float> IStft::Compute(const StftResult &stft_result) const {
   return impl_->Compute(stft_result);
 }
 
+ProfileStats IStft::GetStats() const { return impl_->GetStats(); }
+
 }  // namespace knf
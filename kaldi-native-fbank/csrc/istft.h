@@ -34,6 +34,9 @@ class IStft {
   ~IStft();
   std::vector<float> Compute(const StftResult &stft_result) const;
 
+  // Accumulated over all calls of Compute(). See profiling.h
+  ProfileStats GetStats() const;
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
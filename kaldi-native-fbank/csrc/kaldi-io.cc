@@ -0,0 +1,395 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/kaldi-io.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace knf {
+
+static void CheckKey(const std::string &key) {
+  bool ok = !key.empty();
+  for (char c : key) {
+    ok = ok && !std::isspace(static_cast<unsigned char>(c));
+  }
+
+  if (!ok) {
+    fprintf(stderr, "Invalid key '%s'. It should be non-empty without spaces\n",
+            key.c_str());
+    exit(-1);
+  }
+}
+
+ArkWriter::ArkWriter(const std::string &ark_filename,
+                     const std::string &scp_filename /*= ""*/)
+    : ark_filename_(ark_filename) {
+  ark_ = fopen(ark_filename.c_str(), "wb");
+  if (!ark_) {
+    fprintf(stderr, "Failed to open %s for writing\n", ark_filename.c_str());
+    exit(-1);
+  }
+
+  if (!scp_filename.empty()) {
+    scp_ = fopen(scp_filename.c_str(), "w");
+    if (!scp_) {
+      fprintf(stderr, "Failed to open %s for writing\n", scp_filename.c_str());
+      exit(-1);
+    }
+  }
+}
+
+ArkWriter::~ArkWriter() { Close(); }
+
+void ArkWriter::Close() {
+  if (ark_) {
+    fclose(ark_);
+    ark_ = nullptr;
+  }
+
+  if (scp_) {
+    fclose(scp_);
+    scp_ = nullptr;
+  }
+}
+
+void ArkWriter::Write(const std::string &key, const float *data,
+                      int32_t num_rows, int32_t num_cols) {
+  WriteHeader(key, num_rows, num_cols);
+  WriteData(data, num_rows * num_cols);
+}
+
+void ArkWriter::Write(const std::string &key, const CompressedMatrix &m) {
+  WriteKey(key);
+
+  // "\0B" + token + ' ' + data
+  std::string header("\0B", 2);
+  header.append(m.Token());
+  header.push_back(' ');
+  WriteBytes(header.data(), header.size());
+  WriteBytes(m.Data().data(), m.Data().size());
+}
+
+void ArkWriter::CheckFloat32(const std::string &key,
+                             FeatureDtype dtype) const {
+  if (dtype != FeatureDtype::kFloat32) {
+    fprintf(stderr,
+            "Cannot write '%s': the features are stored as %s. Please set "
+            "output_dtype to float32\n",
+            key.c_str(), FeatureDtypeName(dtype));
+    exit(-1);
+  }
+}
+
+void ArkWriter::WriteKey(const std::string &key) {
+  CheckKey(key);
+  if (!ark_) {
+    fprintf(stderr, "Write() is called after Close()\n");
+    exit(-1);
+  }
+
+  std::string s = key;
+  s.push_back(' ');
+  WriteBytes(s.data(), s.size());
+
+  if (scp_) {
+    fprintf(scp_, "%s %s:%lld\n", key.c_str(), ark_filename_.c_str(),
+            static_cast<long long>(offset_));  // NOLINT
+  }
+}
+
+void ArkWriter::WriteHeader(const std::string &key, int32_t num_rows,
+                            int32_t num_cols) {
+  WriteKey(key);
+
+  // "\0B" + "FM " + '\4' + rows + '\4' + cols
+  std::string header("\0BFM \4", 6);
+  header.append(reinterpret_cast<const char *>(&num_rows), 4);
+  header.push_back('\4');
+  header.append(reinterpret_cast<const char *>(&num_cols), 4);
+  WriteBytes(header.data(), header.size());
+}
+
+void ArkWriter::WriteData(const float *data, int32_t n) {
+  WriteBytes(data, static_cast<int64_t>(n) * sizeof(float));
+}
+
+void ArkWriter::WriteBytes(const void *data, int64_t n) {
+  if (fwrite(data, 1, n, ark_) != static_cast<size_t>(n)) {
+    fprintf(stderr, "Failed to write to %s\n", ark_filename_.c_str());
+    exit(-1);
+  }
+  offset_ += n;
+}
+
+ArkReader::ArkReader(const std::string &ark_filename) {
+  Map(ark_filename);
+  BuildIndex(ark_filename);
+}
+
+ArkReader::~ArkReader() { Unmap(); }
+
+FloatMatrixView ArkReader::Get(const std::string &key) const {
+  auto iter = index_.find(key);
+  if (iter == index_.end()) {
+    return {};
+  }
+
+  const Entry &e = iter->second;
+  FloatMatrixView m = e.m;
+  if (m.data || !e.bytes) {
+    return m;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::vector<float> &copy = copies_[key];
+  if (copy.empty()) {
+    copy.resize(static_cast<int64_t>(m.num_rows) * m.num_cols);
+    memcpy(copy.data(), e.bytes, copy.size() * sizeof(float));
+  }
+  m.data = copy.data();
+  return m;
+}
+
+bool ArkReader::IsCompressed(const std::string &key) const {
+  auto iter = index_.find(key);
+  return iter != index_.end() && iter->second.token != nullptr;
+}
+
+bool ArkReader::Read(const std::string &key, std::vector<float> *out,
+                     int32_t *num_rows, int32_t *num_cols) const {
+  auto iter = index_.find(key);
+  if (iter == index_.end()) {
+    return false;
+  }
+
+  const Entry &e = iter->second;
+  *num_rows = e.m.num_rows;
+  *num_cols = e.m.num_cols;
+  out->resize(static_cast<int64_t>(e.m.num_rows) * e.m.num_cols);
+
+  if (e.token) {
+    CompressedMatrix::Decompress(e.token, e.compressed, out->data());
+  } else if (!out->empty()) {
+    memcpy(out->data(), e.bytes, out->size() * sizeof(float));
+  }
+
+  return true;
+}
+
+#ifdef _WIN32
+void ArkReader::Map(const std::string &filename) {
+  HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    fprintf(stderr, "Failed to open %s\n", filename.c_str());
+    exit(-1);
+  }
+  file_ = file;
+
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(file, &size)) {
+    fprintf(stderr, "Failed to get the size of %s\n", filename.c_str());
+    exit(-1);
+  }
+  size_ = size.QuadPart;
+  if (size_ == 0) {
+    return;
+  }
+
+  HANDLE mapping =
+      CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  if (!mapping) {
+    fprintf(stderr, "Failed to map %s\n", filename.c_str());
+    exit(-1);
+  }
+  mapping_ = mapping;
+
+  data_ = static_cast<const char *>(
+      MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+  if (!data_) {
+    fprintf(stderr, "Failed to map %s\n", filename.c_str());
+    exit(-1);
+  }
+}
+
+void ArkReader::Unmap() {
+  if (data_) {
+    UnmapViewOfFile(data_);
+  }
+
+  if (mapping_) {
+    CloseHandle(static_cast<HANDLE>(mapping_));
+  }
+
+  if (file_) {
+    CloseHandle(static_cast<HANDLE>(file_));
+  }
+}
+#else
+void ArkReader::Map(const std::string &filename) {
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1) {
+    fprintf(stderr, "Failed to open %s\n", filename.c_str());
+    exit(-1);
+  }
+
+  struct stat st;
+  if (fstat(fd, &st) == -1) {
+    fprintf(stderr, "Failed to get the size of %s\n", filename.c_str());
+    exit(-1);
+  }
+  size_ = st.st_size;
+
+  if (size_ > 0) {
+    void *p = mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+      fprintf(stderr, "Failed to map %s\n", filename.c_str());
+      exit(-1);
+    }
+    data_ = static_cast<const char *>(p);
+  }
+
+  // The mapping stays valid after the file is closed
+  close(fd);
+}
+
+void ArkReader::Unmap() {
+  if (data_) {
+    munmap(const_cast<char *>(data_), size_);
+  }
+}
+#endif
+
+void ArkReader::BuildIndex(const std::string &filename) {
+  int64_t pos = 0;
+  auto fail = [&filename, &pos](const char *msg) {
+    fprintf(stderr, "%s: %s at byte %lld\n", filename.c_str(), msg,
+            static_cast<long long>(pos));  // NOLINT
+    exit(-1);
+  };
+
+  while (pos < size_) {
+    const char *p = data_ + pos;
+    const char *space =
+        static_cast<const char *>(memchr(p, ' ', size_ - pos));
+    if (!space || space == p) {
+      fail("Expect a key followed by a space");
+    }
+
+    std::string key(p, space);
+    pos += key.size() + 1;
+
+    if (size_ - pos < 2 || memcmp(data_ + pos, "\0B", 2) != 0) {
+      fail("Only the binary format is supported");
+    }
+    pos += 2;
+
+    // The token, e.g., "FM" or "CM", is followed by a space
+    p = data_ + pos;
+    space = static_cast<const char *>(
+        memchr(p, ' ', std::min<int64_t>(size_ - pos, 4)));
+    if (!space) {
+      fail("Expect a token followed by a space");
+    }
+    std::string token(p, space);
+    pos += token.size() + 1;
+    p = data_ + pos;
+
+    Entry e;
+    if (token == "CM" || token == "CM2" || token == "CM3") {
+      e.token = token == "CM" ? "CM" : (token == "CM2" ? "CM2" : "CM3");
+      e.compressed = reinterpret_cast<const uint8_t *>(p);
+
+      int64_t num_bytes = CompressedMatrix::Parse(
+          e.token, e.compressed, size_ - pos, &e.m.num_rows, &e.m.num_cols);
+      if (num_bytes < 0) {
+        fail("Invalid compressed matrix");
+      }
+
+      if (size_ - pos < num_bytes) {
+        fail("Truncated matrix");
+      }
+      pos += num_bytes;
+    } else {
+      if (token != "FM") {
+        fail("Only float matrices are supported");
+      }
+
+      // '\4' + rows + '\4' + cols
+      constexpr int32_t kHeaderSize = 10;
+      if (size_ - pos < kHeaderSize) {
+        fail("Truncated header");
+      }
+
+      if (p[0] != 4 || p[5] != 4) {
+        fail("Expect int32 for the number of rows and columns");
+      }
+
+      FloatMatrixView &m = e.m;
+      memcpy(&m.num_rows, p + 1, 4);
+      memcpy(&m.num_cols, p + 6, 4);
+      if (m.num_rows < 0 || m.num_cols < 0) {
+        fail("Invalid matrix shape");
+      }
+      pos += kHeaderSize;
+
+      int64_t num_bytes =
+          static_cast<int64_t>(m.num_rows) * m.num_cols * sizeof(float);
+      if (size_ - pos < num_bytes) {
+        fail("Truncated matrix");
+      }
+
+      // The view points into the file only if it is aligned. See Get().
+      // An empty matrix points to the start of the mapping, which is
+      // page aligned, so that its data is not nullptr.
+      e.bytes = data_ + pos;
+      if (num_bytes == 0) {
+        m.data = reinterpret_cast<const float *>(data_);
+      } else if (reinterpret_cast<uintptr_t>(e.bytes) % alignof(float) == 0) {
+        m.data = reinterpret_cast<const float *>(e.bytes);
+      }
+      pos += num_bytes;
+    }
+
+    if (!index_.emplace(key, e).second) {
+      fail("Duplicate key");
+    }
+    keys_.push_back(std::move(key));
+  }
+}
+
+}  // namespace knf
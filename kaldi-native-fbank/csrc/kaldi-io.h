@@ -0,0 +1,222 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Reading and writing features in the binary ark format of Kaldi.
+//
+// Each entry of an ark file is
+//
+//   key + ' ' + "\0B" + "FM " + '\4' + rows + '\4' + cols + data
+//
+// where rows and cols are int32 and data is a row-major float matrix,
+// both in the byte order of the machine (little endian in practice).
+// A compressed matrix is written as
+//
+//   key + ' ' + "\0B" + token + ' ' + data
+//
+// where token is "CM", "CM2" or "CM3". See CompressedMatrix.
+//
+// An scp file has one line "key ark_filename:offset" per entry, where
+// offset points to "\0B". Both can be read by Kaldi and kaldiio.
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_KALDI_IO_H_
+#define KALDI_NATIVE_FBANK_CSRC_KALDI_IO_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <mutex>  // NOLINT
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/compressed-matrix.h"
+#include "kaldi-native-fbank/csrc/feature-window.h"
+
+namespace knf {
+
+// A read-only row-major matrix owned by someone else
+struct FloatMatrixView {
+  const float *data = nullptr;
+  int32_t num_rows = 0;
+  int32_t num_cols = 0;
+};
+
+class ArkWriter {
+ public:
+  /**
+   * @param ark_filename  The ark file to write. It is truncated if it exists.
+   * @param scp_filename  If not empty, the scp file to write.
+   */
+  explicit ArkWriter(const std::string &ark_filename,
+                     const std::string &scp_filename = "");
+
+  ~ArkWriter();
+
+  ArkWriter(const ArkWriter &) = delete;
+  ArkWriter &operator=(const ArkWriter &) = delete;
+
+  /**
+   * @param key  It should be non-empty and contain no whitespace.
+   * @param data  Pointer to a row-major matrix of shape [num_rows, num_cols]
+   */
+  void Write(const std::string &key, const float *data, int32_t num_rows,
+             int32_t num_cols);
+
+  /// Write frames [0, NumFramesReady()) of an online feature extractor,
+  /// e.g., OnlineFbank, without copying them into a matrix first. None of
+  /// the frames should have been discarded by Pop(). Its output_dtype
+  /// should be "float32".
+  template <class F>
+  void Write(const std::string &key, const F &feature) {
+    CheckFloat32(key, feature.OutputDtype());
+    int32_t num_frames = feature.NumFramesReady();
+    int32_t dim = feature.Dim();
+
+    WriteHeader(key, num_frames, dim);
+    for (int32_t i = 0; i != num_frames; ++i) {
+      WriteData(feature.GetFrame(i), dim);
+    }
+  }
+
+  void Write(const std::string &key, const CompressedMatrix &m);
+
+  /// Like Write() above, but the frames are compressed, which saves 75% of
+  /// the space with kSpeechFeature. The frames are not copied.
+  template <class F>
+  void WriteCompressed(
+      const std::string &key, const F &feature,
+      CompressionMethod method = CompressionMethod::kAutomatic) {
+    CheckFloat32(key, feature.OutputDtype());
+    int32_t num_frames = feature.NumFramesReady();
+    std::vector<const float *> rows(num_frames);
+    for (int32_t i = 0; i != num_frames; ++i) {
+      rows[i] = feature.GetFrame(i);
+    }
+    Write(key, CompressedMatrix(rows.data(), num_frames, feature.Dim(),
+                                method));
+  }
+
+  /// Flush and close the files. It is called by the destructor.
+  void Close();
+
+ private:
+  // Exit with an error if dtype is not float32
+  void CheckFloat32(const std::string &key, FeatureDtype dtype) const;
+
+  // Write key + ' ' and add it to the scp file
+  void WriteKey(const std::string &key);
+
+  void WriteHeader(const std::string &key, int32_t num_rows, int32_t num_cols);
+
+  void WriteBytes(const void *data, int64_t n);
+
+  void WriteData(const float *data, int32_t n);
+
+  std::string ark_filename_;
+  FILE *ark_ = nullptr;
+  FILE *scp_ = nullptr;
+
+  // Number of bytes written to ark_
+  int64_t offset_ = 0;
+};
+
+/**
+ * It maps an ark file into memory, so reading a matrix costs no copy and
+ * no parsing. Only the headers of the matrices are read in the constructor
+ * to build an index of the keys.
+ *
+ * It is safe to call the const methods from different threads.
+ */
+class ArkReader {
+ public:
+  explicit ArkReader(const std::string &ark_filename);
+
+  ~ArkReader();
+
+  ArkReader(const ArkReader &) = delete;
+  ArkReader &operator=(const ArkReader &) = delete;
+
+  /// Keys in the order of the ark file
+  const std::vector<std::string> &Keys() const { return keys_; }
+
+  bool Contains(const std::string &key) const {
+    return index_.count(key) != 0;
+  }
+
+  /// Return a view of the matrix with the given key. It is valid as long as
+  /// this object is alive. Its data points into the mapped file if it is
+  /// aligned to 4 bytes there, which depends on the length of the keys.
+  /// Otherwise, the matrix is copied once into a buffer owned by this
+  /// object on the first call.
+  ///
+  /// If the key is not found or the matrix is compressed, the returned data
+  /// is nullptr. The shape is still set for a compressed matrix. Use Read()
+  /// for it.
+  FloatMatrixView Get(const std::string &key) const;
+
+  /// Return true if the matrix with the given key is compressed
+  bool IsCompressed(const std::string &key) const;
+
+  /**
+   * Copy the matrix with the given key. A compressed matrix is
+   * decompressed.
+   *
+   * @param key  The key of the matrix
+   * @param out  On return, a row-major matrix of shape [num_rows, num_cols]
+   * @return Return false if the key is not found.
+   */
+  bool Read(const std::string &key, std::vector<float> *out,
+            int32_t *num_rows, int32_t *num_cols) const;
+
+ private:
+  void Map(const std::string &filename);
+
+  void Unmap();
+
+  void BuildIndex(const std::string &filename);
+
+  const char *data_ = nullptr;
+  int64_t size_ = 0;
+
+#ifdef _WIN32
+  void *file_ = nullptr;
+  void *mapping_ = nullptr;
+#endif
+
+  struct Entry {
+    // m.data is nullptr if it is compressed or not aligned in the file
+    FloatMatrixView m;
+
+    // Start of the data of a float matrix in the mapped file
+    const char *bytes = nullptr;
+
+    // For compressed matrices only
+    const char *token = nullptr;  // "CM", "CM2" or "CM3"
+    const uint8_t *compressed = nullptr;
+  };
+
+  std::vector<std::string> keys_;
+  std::unordered_map<std::string, Entry> index_;
+
+  // Aligned copies of the float matrices that are not aligned in the file
+  mutable std::mutex mutex_;
+  mutable std::unordered_map<std::string, std::vector<float>> copies_;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_KALDI_IO_H_
@@ -12,6 +12,8 @@
 
 #include <cmath>
 
+#include "kaldi-native-fbank/csrc/simd.h"
+
 namespace knf {
 
 int Rand(struct RandomState *state) {
@@ -43,9 +45,7 @@ RandomState::RandomState() {
 }
 
 void Sqrt(float *in_out, int32_t n) {
-  for (int32_t i = 0; i != n; ++i) {
-    in_out[i] = std::sqrt(in_out[i]);
-  }
+  GetSimdKernels().sqrt(in_out, n);
 }
 
 }  // namespace knf
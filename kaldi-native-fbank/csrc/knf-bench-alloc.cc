@@ -0,0 +1,52 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Replacements of the global operator new and delete for knf-bench, to
+// count the number of allocations of the whole program.
+//
+// They are in a separate translation unit so that the compiler does not
+// see a pointer from operator new being passed to free(), which GCC 12
+// reports with -Wmismatched-new-delete.
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<int64_t> g_num_allocs{0};
+
+void *operator new(std::size_t n) {
+  g_num_allocs.fetch_add(1, std::memory_order_relaxed);
+  void *p = std::malloc(n == 0 ? 1 : n);
+  if (!p) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+
+void operator delete(void *p, std::size_t) noexcept { std::free(p); }
+
+namespace knf {
+
+int64_t NumAllocations() {
+  return g_num_allocs.load(std::memory_order_relaxed);
+}
+
+}  // namespace knf
@@ -0,0 +1,296 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Micro and macro benchmarks.
+//
+// Usage:
+//
+//   cmake -DKALDI_NATIVE_FBANK_BUILD_BENCHMARKS=ON ..
+//   make knf-bench
+//   ./bin/knf-bench --benchmark_filter=OnlineFbank
+//
+// Macro benchmarks report the following counters:
+//
+//   - rtf: real-time factor, i.e., seconds of CPU time per second of audio
+//   - frames/s: number of output frames per second
+//   - allocs/frame: number of calls of operator new per output frame
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "kaldi-native-fbank/csrc/dct.h"
+#include "kaldi-native-fbank/csrc/feature-fbank.h"
+#include "kaldi-native-fbank/csrc/feature-functions.h"
+#include "kaldi-native-fbank/csrc/feature-window.h"
+#include "kaldi-native-fbank/csrc/istft.h"
+#include "kaldi-native-fbank/csrc/mel-computations.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/rfft.h"
+#include "kaldi-native-fbank/csrc/stft.h"
+
+namespace knf {
+
+// Number of calls of operator new so far. See knf-bench-alloc.cc
+int64_t NumAllocations();
+
+static std::vector<float> GenerateAudio(int32_t n) {
+  std::mt19937 gen(20260101);
+  std::normal_distribution<float> dist(0, 0.1);
+  std::vector<float> ans(n);
+  for (int32_t i = 0; i != n; ++i) {
+    ans[i] = std::sin(0.05f * i) * 0.3f + dist(gen);
+  }
+  return ans;
+}
+
+// ---------------------------------------------------------------------------
+// Micro benchmarks
+// ---------------------------------------------------------------------------
+
+static void BM_Rfft(benchmark::State &state) {  // NOLINT
+  int32_t n = state.range(0);
+  Rfft rfft(n);
+  std::vector<float> original = GenerateAudio(n);
+  std::vector<float> d(n);
+
+  for (auto _ : state) {
+    std::copy(original.begin(), original.end(), d.begin());
+    rfft.Compute(d.data());
+    benchmark::DoNotOptimize(d.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_Rfft)->Arg(256)->Arg(400)->Arg(512)->Arg(1024)->Arg(2048);
+
+static void BM_ProcessWindow(benchmark::State &state) {  // NOLINT
+  FrameExtractionOptions opts;
+  opts.dither = 0;
+  FeatureWindowFunction window_function(opts);
+
+  int32_t n = opts.PaddedWindowSize();
+  std::vector<float> original = GenerateAudio(n);
+  std::vector<float> d(n);
+
+  float log_energy;
+  for (auto _ : state) {
+    std::copy(original.begin(), original.end(), d.begin());
+    ProcessWindow(opts, window_function, d.data(), &log_energy);
+    benchmark::DoNotOptimize(d.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ProcessWindow);
+
+static void BM_ComputePowerSpectrum(benchmark::State &state) {  // NOLINT
+  int32_t n = state.range(0);
+  std::vector<float> original = GenerateAudio(n);
+  std::vector<float> d(n);
+
+  for (auto _ : state) {
+    std::copy(original.begin(), original.end(), d.begin());
+    ComputePowerSpectrum(&d);
+    benchmark::DoNotOptimize(d.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ComputePowerSpectrum)->Arg(512);
+
+static void BM_MelBanksCompute(benchmark::State &state) {  // NOLINT
+  MelBanksOptions opts;
+  opts.num_bins = state.range(0);
+  FrameExtractionOptions frame_opts;
+  MelBanks mel_banks(opts, frame_opts, 1.0f);
+
+  std::vector<float> power =
+      GenerateAudio(frame_opts.PaddedWindowSize() / 2 + 1);
+  for (auto &p : power) {
+    p = p * p;
+  }
+  std::vector<float> mel(opts.num_bins);
+
+  for (auto _ : state) {
+    mel_banks.Compute(power.data(), mel.data());
+    benchmark::DoNotOptimize(mel.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MelBanksCompute)->Arg(23)->Arg(80)->Arg(128);
+
+// Args: num_ceps, num_bins
+static void BM_MfccDct(benchmark::State &state) {  // NOLINT
+  int32_t num_ceps = state.range(0);
+  int32_t num_bins = state.range(1);
+
+  std::vector<float> lifter_coeffs(num_ceps);
+  ComputeLifterCoeffs(22, &lifter_coeffs);
+  Dct dct(num_ceps, num_bins, lifter_coeffs);
+
+  std::vector<float> original = GenerateAudio(num_bins);
+  for (auto &f : original) {
+    f = std::abs(f) + 1;
+  }
+  std::vector<float> in(num_bins);
+  std::vector<float> out(num_ceps);
+
+  for (auto _ : state) {
+    std::copy(original.begin(), original.end(), in.begin());
+    dct.ComputeLog(in.data(), out.data());
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MfccDct)->Args({13, 23})->Args({40, 40})->Args({80, 80});
+
+// ---------------------------------------------------------------------------
+// Macro benchmarks
+// ---------------------------------------------------------------------------
+
+static constexpr float kSampleRate = 16000;
+
+static void SetCounters(benchmark::State &state,  // NOLINT
+                        double audio_seconds_per_iter, int64_t num_frames,
+                        int64_t num_allocs) {
+  state.counters["rtf"] = benchmark::Counter(
+      audio_seconds_per_iter,
+      benchmark::Counter::kIsIterationInvariantRate |
+          benchmark::Counter::kInvert);
+
+  state.counters["frames/s"] =
+      benchmark::Counter(num_frames, benchmark::Counter::kIsRate);
+
+  state.counters["allocs/frame"] =
+      num_frames ? static_cast<double>(num_allocs) / num_frames : 0;
+}
+
+// Feed 10 seconds of audio in packets of state.range(0) samples, as a
+// streaming server would do.
+template <class C>
+static void BM_OnlineFeature(benchmark::State &state,  // NOLINT
+                             const typename C::Options &opts) {
+  int32_t packet_size = state.range(0);
+  int32_t num_samples = 10 * kSampleRate;
+  std::vector<float> audio = GenerateAudio(num_samples);
+
+  FeatureExtractorConfig<C> config(opts);
+
+  int64_t num_frames = 0;
+  int64_t num_allocs = 0;
+  for (auto _ : state) {
+    int64_t allocs_before = NumAllocations();
+
+    OnlineGenericBaseFeature<C> feature(config);
+    for (int32_t start = 0; start < num_samples; start += packet_size) {
+      int32_t n = std::min(packet_size, num_samples - start);
+      feature.AcceptWaveform(kSampleRate, audio.data() + start, n);
+
+      // Consume the frames as a decoder would
+      int32_t num_ready = feature.NumFramesReady();
+      if (num_ready > 0) {
+        benchmark::DoNotOptimize(feature.GetFrame(num_ready - 1));
+        feature.Pop(num_ready);
+      }
+    }
+    feature.InputFinished();
+
+    num_frames += feature.NumFramesReady();
+    num_allocs += NumAllocations() - allocs_before;
+  }
+
+  SetCounters(state, num_samples / kSampleRate, num_frames, num_allocs);
+}
+
+static void BM_OnlineFbank(benchmark::State &state) {  // NOLINT
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+  opts.mel_opts.num_bins = 80;
+  BM_OnlineFeature<FbankComputer>(state, opts);
+}
+
+static void BM_OnlineMfcc(benchmark::State &state) {  // NOLINT
+  MfccOptions opts;
+  opts.frame_opts.dither = 0;
+  BM_OnlineFeature<MfccComputer>(state, opts);
+}
+
+static void BM_OnlineWhisperFbank(benchmark::State &state) {  // NOLINT
+  WhisperFeatureOptions opts;
+  opts.dim = 80;
+  BM_OnlineFeature<WhisperFeatureComputer>(state, opts);
+}
+
+// packet sizes: 10ms, 20ms, 100ms and 500ms at 16 kHz
+BENCHMARK(BM_OnlineFbank)->Arg(160)->Arg(320)->Arg(1600)->Arg(8000);
+BENCHMARK(BM_OnlineMfcc)->Arg(160)->Arg(320)->Arg(1600)->Arg(8000);
+BENCHMARK(BM_OnlineWhisperFbank)->Arg(160)->Arg(1600);
+
+static StftConfig GetStftConfig() {
+  StftConfig config;
+  config.n_fft = 512;
+  config.hop_length = 160;
+  config.win_length = 400;
+  config.window_type = "hann";
+  return config;
+}
+
+static void BM_Stft(benchmark::State &state) {  // NOLINT
+  int32_t num_samples = state.range(0) * kSampleRate;
+  std::vector<float> audio = GenerateAudio(num_samples);
+  Stft stft(GetStftConfig());
+
+  int64_t num_frames = 0;
+  int64_t num_allocs = 0;
+  for (auto _ : state) {
+    int64_t allocs_before = NumAllocations();
+    StftResult r = stft.Compute(audio.data(), num_samples);
+    num_frames += r.num_frames;
+    num_allocs += NumAllocations() - allocs_before;
+  }
+
+  SetCounters(state, num_samples / kSampleRate, num_frames, num_allocs);
+}
+BENCHMARK(BM_Stft)->Arg(1)->Arg(10);
+
+static void BM_IStft(benchmark::State &state) {  // NOLINT
+  int32_t num_samples = state.range(0) * kSampleRate;
+  std::vector<float> audio = GenerateAudio(num_samples);
+  StftConfig config = GetStftConfig();
+  StftResult r = Stft(config).Compute(audio.data(), num_samples);
+  IStft istft(config);
+
+  int64_t num_frames = 0;
+  int64_t num_allocs = 0;
+  for (auto _ : state) {
+    int64_t allocs_before = NumAllocations();
+    std::vector<float> samples = istft.Compute(r);
+    benchmark::DoNotOptimize(samples.data());
+    num_frames += r.num_frames;
+    num_allocs += NumAllocations() - allocs_before;
+  }
+
+  SetCounters(state, num_samples / kSampleRate, num_frames, num_allocs);
+}
+BENCHMARK(BM_IStft)->Arg(1)->Arg(10);
+
+}  // namespace knf
+
+BENCHMARK_MAIN();
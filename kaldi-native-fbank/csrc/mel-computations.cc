@@ -23,12 +23,18 @@
 #include <stdio.h>
 
 #include <algorithm>
+#include <memory>
 #include <sstream>
+#include <string>
+#include <tuple>
 #include <vector>
 
 #include "kaldi-native-fbank/csrc/feature-window.h"
 #include "kaldi-native-fbank/csrc/kaldi-math.h"
 #include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+#include "kaldi-native-fbank/csrc/shared-cache.h"
+#include "kaldi-native-fbank/csrc/simd.h"
 
 namespace knf {
 
@@ -116,6 +122,20 @@ MelBanks::MelBanks(const MelBanksOptions &opts,
   } else {
     InitKaldiMelBanks(opts, frame_opts, vtln_warp_factor);
   }
+  InitFftRange();
+}
+
+void MelBanks::InitFftRange() {
+  if (bins_.empty()) {
+    return;
+  }
+
+  fft_begin_ = bins_[0].first;
+  fft_end_ = bins_[0].first + bins_[0].second.size();
+  for (const auto &b : bins_) {
+    fft_begin_ = std::min<int32_t>(fft_begin_, b.first);
+    fft_end_ = std::max<int32_t>(fft_end_, b.first + b.second.size());
+  }
 }
 
 void MelBanks::InitKaldiMelBanks(const MelBanksOptions &opts,
@@ -409,20 +429,20 @@ MelBanks::MelBanks(const float *weights, int32_t num_rows, int32_t num_cols)
     bins_[bin].second.insert(bins_[bin].second.end(), this_bin + first_index,
                              this_bin + first_index + size);
   }
+  InitFftRange();
 }
 
 // "power_spectrum" contains fft energies.
 void MelBanks::Compute(const float *power_spectrum,
                        float *mel_energies_out) const {
   int32_t num_bins = bins_.size();
+  const SimdKernels &kernels = GetSimdKernels();
 
   for (int32_t i = 0; i < num_bins; i++) {
     int32_t offset = bins_[i].first;
     const auto &v = bins_[i].second;
-    float energy = 0;
-    for (int32_t k = 0; k != v.size(); ++k) {
-      energy += v[k] * power_spectrum[k + offset];
-    }
+    float energy =
+        kernels.inner_product(v.data(), power_spectrum + offset, v.size());
 
     // HTK-like flooring- for testing purposes (we prefer dither)
     if (htk_mode_ && energy < 1.0) {
@@ -445,6 +465,84 @@ void MelBanks::Compute(const float *power_spectrum,
   }
 }
 
+void MelBanks::ComputeFromFft(float *fft, int32_t n, bool use_power,
+                              float *mel_energies_out) const {
+  const SimdKernels &kernels = GetSimdKernels();
+  int32_t half = n / 2;
+  int32_t begin = fft_begin_;
+  int32_t end = std::min(fft_end_, half + 1);
+
+  {
+    KNF_PROFILE_SCOPE(kProfilePowerSpectrum);
+    // The power of fft bin k is saved in fft[k]. fft[1] contains the real
+    // part of the last bin, so it is saved before being overwritten.
+    float last = fft[1];
+
+    int32_t k0 = std::max(begin, 1);
+    int32_t k1 = std::min(end, half);
+    if (k1 > k0) {
+      kernels.complex_squared_norm(fft + 2 * k0, fft + k0, k1 - k0);
+    }
+
+    if (begin == 0) {
+      fft[0] = fft[0] * fft[0];
+    }
+
+    if (end == half + 1) {
+      fft[half] = last * last;
+    }
+
+    if (!use_power && end > begin) {
+      kernels.sqrt(fft + begin, end - begin);
+    }
+  }
+
+  {
+    KNF_PROFILE_SCOPE(kProfileMel);
+    Compute(fft, mel_energies_out);
+  }
+}
+
+namespace {
+
+using MelBanksKey =
+    std::tuple<int32_t, float, float, float, float, bool, bool, bool,
+               std::string, bool, bool, float, int32_t, float>;
+
+MelBanksKey GetMelBanksKey(const MelBanksOptions &opts,
+                           const FrameExtractionOptions &frame_opts,
+                           float vtln_warp_factor) {
+  return MelBanksKey(opts.num_bins, opts.low_freq, opts.high_freq,
+                     opts.vtln_low, opts.vtln_high, opts.debug_mel,
+                     opts.htk_mode, opts.is_librosa, opts.norm,
+                     opts.use_slaney_mel_scale, opts.floor_to_int_bin,
+                     frame_opts.samp_freq, frame_opts.PaddedWindowSize(),
+                     vtln_warp_factor);
+}
+
+using MelBanksCacheImpl = SharedCache<MelBanksKey, MelBanks>;
+
+MelBanksCacheImpl &GetMelBanksCacheImpl() {
+  // It is never destroyed so that it is safe to use it from the destructors
+  // of static objects.
+  static auto *cache = new MelBanksCacheImpl;
+  return *cache;
+}
+
+}  // namespace
+
+std::shared_ptr<const MelBanks> MelBanksCache::Get(
+    const MelBanksOptions &opts, const FrameExtractionOptions &frame_opts,
+    float vtln_warp_factor) {
+  return GetMelBanksCacheImpl().Get(
+      GetMelBanksKey(opts, frame_opts, vtln_warp_factor), [&]() {
+        return std::make_shared<const MelBanks>(opts, frame_opts,
+                                                vtln_warp_factor);
+      });
+}
+
+int32_t MelBanksCache::Size() { return GetMelBanksCacheImpl().Size(); }
+
 void ComputeLifterCoeffs(float Q, std::vector<float> *coeffs) {
   // Compute liftering coefficients (scaling on cepstral coeffs)
   // coeffs are numbered slightly differently from HTK: the zeroth
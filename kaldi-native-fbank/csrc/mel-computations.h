@@ -21,6 +21,7 @@
 
 #include <cmath>
 #include <cstdint>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -156,8 +157,24 @@ class MelBanks {
   /// @param mel_energies_out  1-D array of size num_mel_bins
   void Compute(const float *fft_energies, float *mel_energies_out) const;
 
+  /// It is equivalent to ComputePowerSpectrum(), followed by Sqrt() if
+  /// use_power is false, and Compute(), but the power (or magnitude) is
+  /// computed only for the fft bins used by at least one mel bin.
+  ///
+  /// @param fft  The output of Rfft::Compute(), i.e., [r0, r(n/2), r1, i1,
+  ///             ...]. It is used as a scratch buffer and is modified.
+  /// @param n    Number of elements in fft, i.e., the fft size.
+  /// @param use_power  true to use |X|^2; false to use |X|.
+  /// @param mel_energies_out  1-D array of size num_mel_bins
+  void ComputeFromFft(float *fft, int32_t n, bool use_power,
+                      float *mel_energies_out) const;
+
   int32_t NumBins() const { return bins_.size(); }
 
+  /// Compute() reads only the fft bins in [FftBegin(), FftEnd())
+  int32_t FftBegin() const { return fft_begin_; }
+  int32_t FftEnd() const { return fft_end_; }
+
  private:
   // for kaldi-compatible
   void InitKaldiMelBanks(const MelBanksOptions &opts,
@@ -170,16 +187,50 @@ class MelBanks {
                            const FrameExtractionOptions &frame_opts,
                            float vtln_warp_factor);
 
+  // Set fft_begin_ and fft_end_ from bins_
+  void InitFftRange();
+
  private:
   // the "bins_" vector is a vector, one for each bin, of a pair:
   // (the first nonzero fft-bin), (the vector of weights).
   std::vector<std::pair<int32_t, std::vector<float>>> bins_;
 
+  // fft bins in [fft_begin_, fft_end_) are used by at least one mel bin
+  int32_t fft_begin_ = 0;
+  int32_t fft_end_ = 0;
+
   // TODO(fangjun): Remove debug_ and htk_mode_
   bool debug_ = false;
   bool htk_mode_ = false;
 };
 
+// A process-wide cache of MelBanks.
+//
+// Computing the weights of a MelBanks is relatively expensive, e.g., it
+// evaluates MelScale() for each fft bin of each mel bin. Feature computers
+// with the same configuration share a single immutable instance through this
+// cache instead of creating their own.
+//
+// The cache does not own the returned instances. An entry is freed as soon as
+// the last computer using it is destroyed.
+//
+// All methods are thread-safe.
+class MelBanksCache {
+ public:
+  // Return a MelBanks for the given config, creating it if it is not
+  // in the cache.
+  //
+  // The key consists of all fields of opts, frame_opts.samp_freq,
+  // frame_opts.PaddedWindowSize() and vtln_warp_factor.
+  static std::shared_ptr<const MelBanks> Get(
+      const MelBanksOptions &opts, const FrameExtractionOptions &frame_opts,
+      float vtln_warp_factor);
+
+  // Return the number of MelBanks instances in the cache that are still
+  // being used.
+  static int32_t Size();
+};
+
 // Compute liftering coefficients (scaling on cepstral coeffs)
 // coeffs are numbered slightly differently from HTK: the zeroth
 // index is C0, which is not affected.
@@ -0,0 +1,383 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/multi-stream-online-feature.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/resample.h"
+
+namespace knf {
+
+template <class C>
+struct MultiStreamOnlineFeature<C>::Stream {
+  Stream(FeatureDtype dtype, const OnlineCmvn &cmvn)
+      : features(-1, dtype), cmvn(cmvn) {}
+
+  RecyclingVector features;
+
+  // See OnlineGenericBaseFeature::cmvn_
+  OnlineCmvn cmvn;
+
+  bool input_finished = false;
+
+  // number of samples discarded before waveform_remainder
+  int64_t waveform_offset = 0;
+
+  std::vector<float> waveform_remainder;
+
+  // Not null if the input of this stream is resampled
+  std::unique_ptr<LinearResample> resampler;
+
+  // Used only inside ComputeReady(). Frames in the range
+  // [features.Size(), num_frames_new) are computed in the current batch.
+  int32_t num_frames_new = 0;
+};
+
+template <class C>
+MultiStreamOnlineFeature<C>::MultiStreamOnlineFeature(
+    const typename C::Options &opts, int32_t num_streams /*= 0*/)
+    : MultiStreamOnlineFeature(FeatureExtractorConfig<C>(opts), num_streams) {}
+
+template <class C>
+MultiStreamOnlineFeature<C>::MultiStreamOnlineFeature(
+    const FeatureExtractorConfig<C> &config, int32_t num_streams /*= 0*/)
+    : computer_(config.GetComputer()),
+      window_function_(config.GetWindowFunction()),
+      cmvn_(config.GetCmvn()) {
+  KNF_CHECK_GE(num_streams, 0);
+  for (int32_t i = 0; i != num_streams; ++i) {
+    AddStream();
+  }
+}
+
+template <class C>
+MultiStreamOnlineFeature<C>::~MultiStreamOnlineFeature() = default;
+
+template <class C>
+int32_t MultiStreamOnlineFeature<C>::AddStream() {
+  auto iter = std::find(streams_.begin(), streams_.end(), nullptr);
+  if (iter != streams_.end()) {
+    *iter = std::make_unique<Stream>(OutputDtype(), cmvn_);
+    return static_cast<int32_t>(iter - streams_.begin());
+  }
+
+  streams_.push_back(std::make_unique<Stream>(OutputDtype(), cmvn_));
+  return static_cast<int32_t>(streams_.size()) - 1;
+}
+
+template <class C>
+void MultiStreamOnlineFeature<C>::RemoveStream(int32_t stream_id) {
+  GetStream(stream_id);  // for the checks inside it
+  streams_[stream_id].reset();
+}
+
+template <class C>
+int32_t MultiStreamOnlineFeature<C>::NumStreams() const {
+  return static_cast<int32_t>(
+      streams_.size() - std::count(streams_.begin(), streams_.end(), nullptr));
+}
+
+template <class C>
+typename MultiStreamOnlineFeature<C>::Stream &
+MultiStreamOnlineFeature<C>::GetStream(int32_t stream_id) {
+  KNF_CHECK(stream_id >= 0 &&
+            stream_id < static_cast<int32_t>(streams_.size()) &&
+            streams_[stream_id] != nullptr)
+      << "Invalid stream ID: " << stream_id;
+  return *streams_[stream_id];
+}
+
+template <class C>
+const typename MultiStreamOnlineFeature<C>::Stream &
+MultiStreamOnlineFeature<C>::GetStream(int32_t stream_id) const {
+  KNF_CHECK(stream_id >= 0 &&
+            stream_id < static_cast<int32_t>(streams_.size()) &&
+            streams_[stream_id] != nullptr)
+      << "Invalid stream ID: " << stream_id;
+  return *streams_[stream_id];
+}
+
+template <class C>
+void MultiStreamOnlineFeature<C>::AcceptWaveform(int32_t stream_id,
+                                                 float sampling_rate,
+                                                 const float *waveform,
+                                                 int32_t n) {
+  Stream &s = GetStream(stream_id);
+  if (n == 0) {
+    return;  // Nothing to do.
+  }
+
+  if (s.input_finished) {
+    KNF_LOG(FATAL) << "AcceptWaveform called after InputFinished() was called "
+                   << "for stream " << stream_id;
+  }
+
+  if (s.resampler) {
+    KNF_CHECK_EQ(sampling_rate, s.resampler->GetInputSamplingRate());
+  } else {
+    s.resampler =
+        CreateResamplerIfNeeded(sampling_rate, computer_.GetFrameOptions());
+  }
+
+#if KNF_ENABLE_PROFILING
+  size_t old_capacity = s.waveform_remainder.capacity();
+#endif
+
+  if (s.resampler) {
+    s.resampler->Resample(waveform, n, false, &s.waveform_remainder);
+  } else {
+    s.waveform_remainder.insert(s.waveform_remainder.end(), waveform,
+                                waveform + n);
+  }
+
+#if KNF_ENABLE_PROFILING
+  CountReallocation(s.waveform_remainder, old_capacity, &stats_);
+#endif
+}
+
+template <class C>
+void MultiStreamOnlineFeature<C>::InputFinished(int32_t stream_id) {
+  Stream &s = GetStream(stream_id);
+  if (s.resampler && !s.input_finished) {
+#if KNF_ENABLE_PROFILING
+    size_t old_capacity = s.waveform_remainder.capacity();
+#endif
+    s.resampler->Resample(nullptr, 0, true, &s.waveform_remainder);
+#if KNF_ENABLE_PROFILING
+    CountReallocation(s.waveform_remainder, old_capacity, &stats_);
+#endif
+  }
+  s.input_finished = true;
+}
+
+template <class C>
+int32_t MultiStreamOnlineFeature<C>::ComputeReady() {
+  KNF_PROFILE_STATS(&stats_);
+
+  const FrameExtractionOptions &frame_opts = computer_.GetFrameOptions();
+
+  // Stage 0: Find the frames to compute
+  int32_t batch_size = 0;
+  for (auto &p : streams_) {
+    if (!p) {
+      continue;
+    }
+
+    Stream &s = *p;
+    int64_t num_samples_total =
+        s.waveform_offset + static_cast<int64_t>(s.waveform_remainder.size());
+
+    s.num_frames_new = NumFrames(num_samples_total, frame_opts,
+                                 s.input_finished);
+    KNF_CHECK_GE(s.num_frames_new, s.features.Size());
+
+    batch_size += s.num_frames_new - s.features.Size();
+  }
+
+  if (batch_size == 0) {
+    return 0;
+  }
+
+#if KNF_ENABLE_PROFILING
+  size_t old_windows_capacity = windows_.capacity();
+  size_t old_energies_capacity = raw_log_energies_.capacity();
+  size_t old_scratch_capacity = scratch_.capacity();
+#endif
+
+  if (static_cast<int32_t>(windows_.size()) < batch_size) {
+    windows_.resize(batch_size);
+  }
+  raw_log_energies_.resize(batch_size);
+
+#if KNF_ENABLE_PROFILING
+  CountReallocation(windows_, old_windows_capacity, &stats_);
+  CountReallocation(raw_log_energies_, old_energies_capacity, &stats_);
+#endif
+
+  // Stage 1: Extract and process the windows of all frames
+  bool need_raw_log_energy = computer_.NeedRawLogEnergy();
+  int32_t k = 0;
+  for (auto &p : streams_) {
+    if (!p) {
+      continue;
+    }
+
+    Stream &s = *p;
+    for (int32_t f = s.features.Size(); f < s.num_frames_new; ++f, ++k) {
+      std::vector<float> &window = windows_[k];
+      std::fill(window.begin(), window.end(), 0);
+#if KNF_ENABLE_PROFILING
+      size_t old_capacity = window.capacity();
+#endif
+
+      raw_log_energies_[k] = 0;
+      ExtractWindow(s.waveform_offset, s.waveform_remainder, f, frame_opts,
+                    window_function_, &window,
+                    need_raw_log_energy ? &raw_log_energies_[k] : nullptr,
+                    &scratch_);
+#if KNF_ENABLE_PROFILING
+      CountReallocation(window, old_capacity, &stats_);
+#endif
+    }
+  }
+
+#if KNF_ENABLE_PROFILING
+  CountReallocation(scratch_, old_scratch_capacity, &stats_);
+#endif
+
+  // Stage 2: Compute features for all frames, one stage of the computer
+  // at a time
+  //
+  // note: this online feature-extraction code does not support VTLN.
+  float vtln_warp = 1.0;
+  int32_t dim = computer_.Dim();
+
+  std::vector<std::vector<float>> features(batch_size);
+  std::vector<float *> outputs(batch_size);
+  for (int32_t i = 0; i != batch_size; ++i) {
+    features[i].resize(dim);
+    outputs[i] = features[i].data();
+#if KNF_ENABLE_PROFILING
+    stats_.bytes_allocated += CapacityInBytes(features[i]);
+#endif
+  }
+
+  computer_.ComputeBatch(raw_log_energies_.data(), vtln_warp, windows_.data(),
+                         batch_size, outputs.data());
+
+  // Stage 3: Scatter the features back to the streams
+  k = 0;
+  for (auto &p : streams_) {
+    if (!p) {
+      continue;
+    }
+
+    Stream &s = *p;
+#if KNF_ENABLE_PROFILING
+    int64_t old_features_bytes = s.features.BytesAllocated();
+#endif
+    for (int32_t f = s.features.Size(); f < s.num_frames_new; ++f, ++k) {
+      if (s.cmvn.Enabled()) {
+        KNF_PROFILE_SCOPE(kProfileCmvn);
+        s.cmvn.Apply(features[k].data());
+      }
+      s.features.PushBack(std::move(features[k]));
+    }
+#if KNF_ENABLE_PROFILING
+    stats_.bytes_allocated +=
+        s.features.BytesAllocated() - old_features_bytes;
+#endif
+
+    DiscardSamples(&s);
+  }
+
+#if KNF_ENABLE_PROFILING
+  stats_.frames_processed += batch_size;
+#endif
+
+  return batch_size;
+}
+
+template <class C>
+void MultiStreamOnlineFeature<C>::DiscardSamples(Stream *s) const {
+  // See also OnlineGenericBaseFeature<C>::ComputeFeatures()
+  int64_t first_sample_of_next_frame =
+      FirstSampleOfFrame(s->features.Size(), computer_.GetFrameOptions());
+
+  int64_t samples_to_discard = first_sample_of_next_frame - s->waveform_offset;
+  if (samples_to_discard <= 0) {
+    return;
+  }
+
+  int64_t num_samples = s->waveform_remainder.size();
+  if (samples_to_discard >= num_samples) {
+    s->waveform_offset += num_samples;
+    s->waveform_remainder.clear();
+    return;
+  }
+
+  // Shift in place so that the capacity of the buffer is reused
+  s->waveform_remainder.erase(
+      s->waveform_remainder.begin(),
+      s->waveform_remainder.begin() + samples_to_discard);
+  s->waveform_offset += samples_to_discard;
+}
+
+template <class C>
+int32_t MultiStreamOnlineFeature<C>::NumFramesReady(int32_t stream_id) const {
+  return GetStream(stream_id).features.Size();
+}
+
+template <class C>
+bool MultiStreamOnlineFeature<C>::IsLastFrame(int32_t stream_id,
+                                              int32_t frame) const {
+  const Stream &s = GetStream(stream_id);
+
+  // input_finished is not enough since the last frames may not have been
+  // computed yet
+  int32_t num_frames = s.features.Size();
+  return s.input_finished &&
+         num_frames ==
+             NumFrames(s.waveform_offset + s.waveform_remainder.size(),
+                       computer_.GetFrameOptions(), true) &&
+         frame == num_frames - 1;
+}
+
+template <class C>
+const float *MultiStreamOnlineFeature<C>::GetFrame(int32_t stream_id,
+                                                   int32_t frame) const {
+  return GetStream(stream_id).features.At(frame);
+}
+
+template <class C>
+const uint16_t *MultiStreamOnlineFeature<C>::GetHalfFrame(
+    int32_t stream_id, int32_t frame) const {
+  return GetStream(stream_id).features.HalfAt(frame);
+}
+
+template <class C>
+void MultiStreamOnlineFeature<C>::Pop(int32_t stream_id, int32_t n) {
+  GetStream(stream_id).features.Pop(n);
+}
+
+template <class C>
+ProfileStats MultiStreamOnlineFeature<C>::GetStats() const {
+#if KNF_ENABLE_PROFILING
+  ProfileStats stats = stats_;
+  stats.samples_buffered = 0;
+  for (const auto &p : streams_) {
+    if (p) {
+      stats.samples_buffered += p->waveform_remainder.size();
+    }
+  }
+  return stats;
+#else
+  return {};
+#endif
+}
+
+template class MultiStreamOnlineFeature<FbankComputer>;
+template class MultiStreamOnlineFeature<MfccComputer>;
+template class MultiStreamOnlineFeature<WhisperFeatureComputer>;
+
+}  // namespace knf
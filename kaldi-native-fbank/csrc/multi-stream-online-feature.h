@@ -0,0 +1,158 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_MULTI_STREAM_ONLINE_FEATURE_H_
+#define KALDI_NATIVE_FBANK_CSRC_MULTI_STREAM_ONLINE_FEATURE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/feature-window.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+
+namespace knf {
+
+/// Online feature extraction for many streams with the same config.
+///
+/// AcceptWaveform() and InputFinished() only queue the input of a stream.
+/// Features are computed by ComputeReady(), which collects the ready frames
+/// of all streams into a single batch and runs each stage of the pipeline
+/// (window extraction, FFT, mel filter banks, log, etc.) over the whole
+/// batch before moving to the next stage, so that the tables of each stage
+/// stay in the cache. Results are then scattered back to the streams.
+/// The stages after window extraction are run by C::ComputeBatch().
+///
+/// The output of a stream is identical to that of an OnlineGenericBaseFeature
+/// with the same input, including CMVN if it is enabled in the config.
+///
+/// This class is not thread-safe.
+template <class C>
+class MultiStreamOnlineFeature {
+ public:
+  /// @param opts  Options shared by all streams.
+  /// @param num_streams  Number of streams to create. Their IDs are
+  ///                     0, 1, ..., num_streams - 1. More streams can be
+  ///                     added with AddStream().
+  explicit MultiStreamOnlineFeature(const typename C::Options &opts,
+                                    int32_t num_streams = 0);
+
+  explicit MultiStreamOnlineFeature(const FeatureExtractorConfig<C> &config,
+                                    int32_t num_streams = 0);
+
+  ~MultiStreamOnlineFeature();
+
+  MultiStreamOnlineFeature(const MultiStreamOnlineFeature &) = delete;
+  MultiStreamOnlineFeature &operator=(const MultiStreamOnlineFeature &) =
+      delete;
+
+  int32_t Dim() const { return computer_.Dim(); }
+
+  float FrameShiftInSeconds() const {
+    return computer_.GetFrameOptions().frame_shift_ms / 1000.0f;
+  }
+
+  FeatureDtype OutputDtype() const {
+    return computer_.GetFrameOptions().OutputDtype();
+  }
+
+  /// Create a new stream and return its ID. IDs of removed streams
+  /// are reused.
+  int32_t AddStream();
+
+  /// Free all resources of a stream. Its ID becomes invalid.
+  void RemoveStream(int32_t stream_id);
+
+  /// Number of streams that have not been removed
+  int32_t NumStreams() const;
+
+  /// Append samples to a stream. No features are computed until
+  /// ComputeReady() is called. Streams may have different sampling rates
+  /// if allow_downsample or allow_upsample is set.
+  void AcceptWaveform(int32_t stream_id, float sampling_rate,
+                      const float *waveform, int32_t n);
+
+  /// Like OnlineGenericBaseFeature::InputFinished(). The last frames
+  /// are computed on the next call of ComputeReady().
+  void InputFinished(int32_t stream_id);
+
+  /// Compute all frames that can be computed from the input of all streams.
+  ///
+  /// @return Return the number of frames computed.
+  int32_t ComputeReady();
+
+  int32_t NumFramesReady(int32_t stream_id) const;
+
+  // Note: IsLastFrame() will only ever return true if you have called
+  // InputFinished() and ComputeReady() (and this frame is the last frame).
+  bool IsLastFrame(int32_t stream_id, int32_t frame) const;
+
+  // It is valid only if frame_opts.output_dtype is "float32"
+  const float *GetFrame(int32_t stream_id, int32_t frame) const;
+
+  // It is valid only if frame_opts.output_dtype is "float16" or "bfloat16".
+  // It returns the bits of Dim() 16-bit values.
+  const uint16_t *GetHalfFrame(int32_t stream_id, int32_t frame) const;
+
+  // discard the first n frames of a stream
+  void Pop(int32_t stream_id, int32_t n);
+
+  // Return a snapshot of the stats of all streams. samples_buffered is the
+  // sum over the streams. All fields are 0 unless it is built with
+  // KNF_ENABLE_PROFILING. See profiling.h
+  ProfileStats GetStats() const;
+
+ private:
+  struct Stream;
+
+  Stream &GetStream(int32_t stream_id);
+  const Stream &GetStream(int32_t stream_id) const;
+
+  // Discard samples of a stream that are not needed by any future frame
+  void DiscardSamples(Stream *s) const;
+
+ private:
+  C computer_;
+  FeatureWindowFunction window_function_;
+
+  // Copied into each new stream, which keeps its own statistics
+  OnlineCmvn cmvn_;
+
+  // A null entry means the stream has been removed
+  std::vector<std::unique_ptr<Stream>> streams_;
+
+  // Reused across calls to ComputeReady() to avoid memory allocations.
+  // Each entry is a frame of size PaddedWindowSize().
+  std::vector<std::vector<float>> windows_;
+  std::vector<float> raw_log_energies_;
+  std::vector<float> scratch_;  // for dithering
+
+#if KNF_ENABLE_PROFILING
+  ProfileStats stats_;
+#endif
+};
+
+using MultiStreamOnlineFbank = MultiStreamOnlineFeature<FbankComputer>;
+using MultiStreamOnlineMfcc = MultiStreamOnlineFeature<MfccComputer>;
+using MultiStreamOnlineWhisperFbank =
+    MultiStreamOnlineFeature<WhisperFeatureComputer>;
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_MULTI_STREAM_ONLINE_FEATURE_H_
@@ -0,0 +1,287 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/online-cmvn.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/shared-cache.h"
+#include "kaldi-native-fbank/csrc/simd.h"
+
+namespace knf {
+
+std::ostream &operator<<(std::ostream &os, const OnlineCmvnOptions &opts) {
+  os << opts.ToString();
+  return os;
+}
+
+// Read a Kaldi matrix in binary ("FM" or "DM") or text format and return
+// its elements in row-major order
+static std::vector<double> ReadKaldiMatrix(const std::string &filename,
+                                           int32_t *num_rows,
+                                           int32_t *num_cols) {
+  std::ifstream is(filename, std::ios::binary);
+  if (!is) {
+    fprintf(stderr, "Failed to open %s\n", filename.c_str());
+    exit(-1);
+  }
+
+  std::ostringstream os;
+  os << is.rdbuf();
+  std::string s = os.str();
+
+  std::vector<double> ans;
+  if (s.size() >= 2 && s[0] == '\0' && s[1] == 'B') {
+    // "\0B" + "FM " + '\4' + rows + '\4' + cols + data
+    if (s.size() < 15 || (s.compare(2, 3, "FM ") != 0 &&
+                          s.compare(2, 3, "DM ") != 0) ||
+        s[5] != 4 || s[10] != 4) {
+      fprintf(stderr, "%s: Expect a float or double matrix\n",
+              filename.c_str());
+      exit(-1);
+    }
+    bool is_double = s[2] == 'D';
+    memcpy(num_rows, &s[6], 4);
+    memcpy(num_cols, &s[11], 4);
+
+    int64_t n = static_cast<int64_t>(*num_rows) * *num_cols;
+    int64_t element_size = is_double ? sizeof(double) : sizeof(float);
+    if (*num_rows < 0 || *num_cols < 0 ||
+        static_cast<int64_t>(s.size()) < 15 + n * element_size) {
+      fprintf(stderr, "%s: Truncated matrix\n", filename.c_str());
+      exit(-1);
+    }
+
+    ans.resize(n);
+    const char *p = s.data() + 15;
+    for (int64_t i = 0; i != n; ++i, p += element_size) {
+      if (is_double) {
+        memcpy(&ans[i], p, sizeof(double));
+      } else {
+        float f;
+        memcpy(&f, p, sizeof(float));
+        ans[i] = f;
+      }
+    }
+    return ans;
+  }
+
+  // Text format, e.g.,
+  //   [ 1 2 3
+  //     4 5 6 ]
+  std::istringstream iss(s);
+  std::string line;
+  *num_rows = 0;
+  *num_cols = 0;
+  while (std::getline(iss, line)) {
+    std::replace(line.begin(), line.end(), '[', ' ');
+    std::replace(line.begin(), line.end(), ']', ' ');
+    std::istringstream ls(line);
+    int32_t n = 0;
+    double d;
+    while (ls >> d) {
+      ans.push_back(d);
+      ++n;
+    }
+
+    if (n == 0) {
+      continue;
+    }
+
+    if (*num_rows != 0 && n != *num_cols) {
+      fprintf(stderr, "%s: Rows have different numbers of columns\n",
+              filename.c_str());
+      exit(-1);
+    }
+    *num_cols = n;
+    *num_rows += 1;
+  }
+  return ans;
+}
+
+// Set t->offset and t->scale from the sums of count frames
+static void ComputeTransform(const double *sum, const double *sum_sq,
+                             double count, int32_t dim,
+                             bool normalize_variance, CmvnTransform *t) {
+  float *offset = t->offset.data();
+  float *scale = t->scale.data();
+  for (int32_t i = 0; i != dim; ++i) {
+    double mean = sum[i] / count;
+    offset[i] = mean;
+
+    if (normalize_variance) {
+      double var = sum_sq[i] / count - mean * mean;
+      if (var < 1.0e-20) {
+        var = 1.0e-20;
+      }
+      scale[i] = var;
+    }
+  }
+
+  if (normalize_variance) {
+    GetSimdKernels().sqrt(scale, dim);
+    for (int32_t i = 0; i != dim; ++i) {
+      scale[i] = 1.0f / scale[i];
+    }
+  }
+}
+
+namespace {
+
+// filename, dim and normalize_variance
+using GlobalCmvnKey = std::tuple<std::string, int32_t, bool>;
+
+using GlobalCmvnCache = SharedCache<GlobalCmvnKey, CmvnTransform>;
+
+GlobalCmvnCache &GetGlobalCmvnCache() {
+  // It is never destroyed. See SharedCache
+  static auto *cache = new GlobalCmvnCache;
+  return *cache;
+}
+
+std::shared_ptr<const CmvnTransform> LoadGlobalCmvn(
+    const std::string &filename, int32_t dim, bool normalize_variance) {
+  int32_t num_rows = 0;
+  int32_t num_cols = 0;
+  std::vector<double> stats = ReadKaldiMatrix(filename, &num_rows, &num_cols);
+  if (num_rows != 2 || num_cols != dim + 1) {
+    fprintf(stderr,
+            "%s: Expect CMVN stats of shape [2, %d]. Given: [%d, %d]\n",
+            filename.c_str(), dim + 1, num_rows, num_cols);
+    exit(-1);
+  }
+
+  double count = stats[dim];
+  if (count < 1) {
+    fprintf(stderr, "%s: Invalid frame count %f\n", filename.c_str(),
+            count);
+    exit(-1);
+  }
+
+  auto t = std::make_shared<CmvnTransform>();
+  t->offset.resize(dim);
+  t->scale.resize(dim, 1);
+  ComputeTransform(stats.data(), stats.data() + dim + 1, count, dim,
+                   normalize_variance, t.get());
+  return t;
+}
+
+}  // namespace
+
+OnlineCmvn::OnlineCmvn(const OnlineCmvnOptions &opts, int32_t dim)
+    : dim_(dim),
+      cmn_window_(opts.cmn_window),
+      normalize_variance_(opts.normalize_variance) {
+  if (opts.mode == "none") {
+    mode_ = Mode::kNone;
+    return;
+  } else if (opts.mode == "global") {
+    mode_ = Mode::kGlobal;
+  } else if (opts.mode == "prefix") {
+    mode_ = Mode::kPrefix;
+  } else if (opts.mode == "sliding") {
+    mode_ = Mode::kSliding;
+  } else {
+    fprintf(stderr,
+            "Invalid CMVN mode '%s'. Valid values are: none, global, prefix, "
+            "sliding\n",
+            opts.mode.c_str());
+    exit(-1);
+  }
+
+  if (mode_ == Mode::kGlobal) {
+    GlobalCmvnKey key{opts.global_cmvn_stats, dim, normalize_variance_};
+    global_ = GetGlobalCmvnCache().Get(key, [&]() {
+      return LoadGlobalCmvn(opts.global_cmvn_stats, dim, normalize_variance_);
+    });
+    return;
+  }
+
+  transform_.offset.resize(dim);
+  transform_.scale.resize(dim, 1);
+
+  if (mode_ == Mode::kSliding && cmn_window_ <= 0) {
+    fprintf(stderr, "cmn_window should be positive. Given: %d\n",
+            cmn_window_);
+    exit(-1);
+  }
+
+  sum_.resize(dim);
+  sum_sq_.resize(dim);
+  if (mode_ == Mode::kSliding) {
+    ring_.resize(static_cast<int64_t>(cmn_window_) * dim);
+  }
+}
+
+void OnlineCmvn::Apply(float *feature) {
+  if (mode_ == Mode::kNone) {
+    return;
+  }
+
+  if (mode_ != Mode::kGlobal) {
+    if (mode_ == Mode::kSliding) {
+      float *row = ring_.data() + (num_frames_ % cmn_window_) * dim_;
+      if (num_frames_ >= cmn_window_) {
+        // Remove the frame that leaves the window
+        for (int32_t i = 0; i != dim_; ++i) {
+          sum_[i] -= row[i];
+          sum_sq_[i] -= static_cast<double>(row[i]) * row[i];
+        }
+      }
+      std::copy(feature, feature + dim_, row);
+    }
+
+    for (int32_t i = 0; i != dim_; ++i) {
+      sum_[i] += feature[i];
+      sum_sq_[i] += static_cast<double>(feature[i]) * feature[i];
+    }
+    ++num_frames_;
+
+    double count = num_frames_;
+    if (mode_ == Mode::kSliding) {
+      count = std::min<int64_t>(num_frames_, cmn_window_);
+    }
+    ComputeTransform(sum_.data(), sum_sq_.data(), count, dim_,
+                     normalize_variance_, &transform_);
+  }
+
+  const CmvnTransform &t = global_ ? *global_ : transform_;
+  const float *offset = t.offset.data();
+  const float *scale = t.scale.data();
+  if (normalize_variance_) {
+    for (int32_t i = 0; i != dim_; ++i) {
+      feature[i] = (feature[i] - offset[i]) * scale[i];
+    }
+  } else {
+    for (int32_t i = 0; i != dim_; ++i) {
+      feature[i] -= offset[i];
+    }
+  }
+}
+
+}  // namespace knf
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Online cepstral mean and variance normalization (CMVN) applied by
+// OnlineGenericBaseFeature to each frame before it is stored.
+//
+// See also kaldi/src/feat/online-feature.h and apply-cmvn-sliding in Kaldi.
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_ONLINE_CMVN_H_
+#define KALDI_NATIVE_FBANK_CSRC_ONLINE_CMVN_H_
+
+#include <cstdint>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace knf {
+
+struct OnlineCmvnOptions {
+  // Which frames the mean (and variance) of frame t are computed from.
+  //  - none: CMVN is disabled
+  //  - global: the stats in global_cmvn_stats
+  //  - prefix: all frames so far, i.e., [0, t]
+  //  - sliding: the last cmn_window frames, i.e., [t - cmn_window + 1, t],
+  //             or [0, t] for t < cmn_window. Only frames up to t are used.
+  //             Note that apply-cmvn-sliding --center=false in Kaldi is
+  //             different: it uses the cmn_window + 1 frames
+  //             [t - cmn_window, t] and, for t < min_window, the first
+  //             min_window frames, including frames after t.
+  std::string mode = "none";
+
+  // Number of frames of the sliding window. Used only if mode is "sliding".
+  int32_t cmn_window = 600;
+
+  // If true, also divide by the standard deviation
+  bool normalize_variance = false;
+
+  // A Kaldi matrix of shape [2, dim + 1] in binary or text format, e.g.,
+  // from compute-cmvn-stats. Row 0 holds the sums of the features followed
+  // by the number of frames and row 1 holds the sums of their squares.
+  // Used only if mode is "global".
+  std::string global_cmvn_stats;
+
+  std::string ToString() const {
+    std::ostringstream os;
+    os << "mode: " << mode << "\n";
+    os << "cmn_window: " << cmn_window << "\n";
+    os << "normalize_variance: " << normalize_variance << "\n";
+    os << "global_cmvn_stats: " << global_cmvn_stats << "\n";
+    return os.str();
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const OnlineCmvnOptions &opts);
+
+// feature[i] = (feature[i] - offset[i]) * scale[i]
+struct CmvnTransform {
+  std::vector<float> offset;
+  std::vector<float> scale;
+};
+
+class OnlineCmvn {
+ public:
+  /// @param opts  If opts.mode is "global", the transform is computed from
+  ///              the stats file and shared by all OnlineCmvn objects with
+  ///              the same file, dim and normalize_variance. The file is
+  ///              read again only if all of them have been destroyed. To
+  ///              read it only once, keep a FeatureExtractorConfig
+  ///              created with these options and construct the streams
+  ///              from it.
+  /// @param dim  Dimension of the features
+  OnlineCmvn(const OnlineCmvnOptions &opts, int32_t dim);
+
+  /// Return false if opts.mode is "none"
+  bool Enabled() const { return mode_ != Mode::kNone; }
+
+  /// Normalize the next frame in place. Frames must be given in order.
+  /// The sliding window is updated in O(dim) per frame.
+  void Apply(float *feature);
+
+ private:
+  enum class Mode {
+    kNone,
+    kGlobal,
+    kPrefix,
+    kSliding,
+  };
+
+  Mode mode_ = Mode::kNone;
+  int32_t dim_;
+  int32_t cmn_window_;
+  bool normalize_variance_;
+
+  // Running sums of the frames in the window. For the prefix and the
+  // sliding modes only.
+  std::vector<double> sum_;
+  std::vector<double> sum_sq_;
+  int64_t num_frames_ = 0;
+
+  // The last cmn_window_ frames before normalization. For the sliding mode
+  // only. Frame t is at row t % cmn_window_.
+  std::vector<float> ring_;
+
+  // For the prefix and the sliding modes. It is updated for each frame.
+  CmvnTransform transform_;
+
+  // For the global mode. It is never changed.
+  std::shared_ptr<const CmvnTransform> global_;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_ONLINE_CMVN_H_
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file is copied/modified from kaldi/src/feat/feature-functions.cc
+
+#include "kaldi-native-fbank/csrc/online-delta-feature.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/simd.h"
+
+namespace knf {
+
+std::ostream &operator<<(std::ostream &os, const DeltaFeaturesOptions &opts) {
+  os << opts.ToString();
+  return os;
+}
+
+template <class C>
+OnlineDeltaFeature<C>::OnlineDeltaFeature(
+    const DeltaFeaturesOptions &opts, const OnlineGenericBaseFeature<C> *src)
+    : opts_(opts), src_(src), src_dim_(src->Dim()) {
+  if (opts.order < 0 || opts.window < 1) {
+    fprintf(stderr, "Invalid delta options:\n%s\n", opts.ToString().c_str());
+    exit(-1);
+  }
+
+  if (src->OutputDtype() != FeatureDtype::kFloat32) {
+    fprintf(stderr,
+            "OnlineDeltaFeature requires frame_opts.output_dtype to be "
+            "float32\n");
+    exit(-1);
+  }
+
+  // The delta of order i is the delta of order i - 1 convolved with
+  // [-window, ..., window] / (2 * sum_{j=1}^{window} j^2)
+  scales_.resize(opts.order + 1);
+  scales_[0] = {1.0f};
+  for (int32_t i = 1; i <= opts.order; ++i) {
+    const std::vector<float> &prev = scales_[i - 1];
+    std::vector<float> &cur = scales_[i];
+    int32_t window = opts.window;
+    cur.resize(prev.size() + 2 * window);
+
+    float normalizer = 0;
+    for (int32_t j = -window; j <= window; ++j) {
+      normalizer += j * j;
+      for (int32_t k = 0; k != static_cast<int32_t>(prev.size()); ++k) {
+        cur[j + k + window] += j * prev[k];
+      }
+    }
+
+    for (auto &s : cur) {
+      s /= normalizer;
+    }
+  }
+
+  ring_size_ = 2 * opts.order * opts.window + 1;
+  ring_.resize(static_cast<int64_t>(ring_size_) * src_dim_);
+}
+
+template <class C>
+void OnlineDeltaFeature<C>::Update() {
+  if (input_finished_) {
+    return;
+  }
+
+  int32_t context = opts_.order * opts_.window;
+  int32_t n = src_->NumFramesReady();
+  for (; num_src_frames_ < n; ++num_src_frames_) {
+    int32_t i = num_src_frames_;
+    memcpy(ring_.data() + static_cast<int64_t>(i % ring_size_) * src_dim_,
+           src_->GetFrame(i), src_dim_ * sizeof(float));
+
+    // Frame i completes the right context of frame i - context
+    if (i >= context) {
+      ComputeFrame(i - context, i);
+    }
+  }
+
+  if (n > 0 && src_->IsLastFrame(n - 1)) {
+    for (int32_t t = features_.Size(); t < n; ++t) {
+      ComputeFrame(t, n - 1);
+    }
+    input_finished_ = true;
+  }
+}
+
+template <class C>
+void OnlineDeltaFeature<C>::ComputeFrame(int32_t t, int32_t last) {
+  const auto &kernels = GetSimdKernels();
+
+  std::vector<float> out(Dim());
+  for (int32_t i = 0; i <= opts_.order; ++i) {
+    const std::vector<float> &scales = scales_[i];
+    int32_t max_offset = (scales.size() - 1) / 2;
+    float *p = out.data() + i * src_dim_;
+    for (int32_t j = -max_offset; j <= max_offset; ++j) {
+      float s = scales[j + max_offset];
+      if (s != 0) {
+        int32_t k = std::min(std::max(t + j, 0), last);
+        kernels.axpy(s, Row(k), p, src_dim_);
+      }
+    }
+  }
+
+  features_.PushBack(std::move(out));
+}
+
+template class OnlineDeltaFeature<FbankComputer>;
+template class OnlineDeltaFeature<MfccComputer>;
+template class OnlineDeltaFeature<WhisperFeatureComputer>;
+
+}  // namespace knf
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Delta and delta-delta features computed incrementally as the frames of
+// an online feature extractor become available.
+//
+// See also kaldi/src/feat/feature-functions.h and
+// OnlineDeltaFeature in kaldi/src/feat/online-feature.h
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_ONLINE_DELTA_FEATURE_H_
+#define KALDI_NATIVE_FBANK_CSRC_ONLINE_DELTA_FEATURE_H_
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+struct DeltaFeaturesOptions {
+  // Order of the deltas. 1 for delta, 2 for delta + delta-delta
+  int32_t order = 2;
+
+  // The delta of order i is a regression over 2 * window + 1 deltas of
+  // order i - 1, so output frame t depends on the input frames in
+  // [t - order * window, t + order * window]
+  int32_t window = 2;
+
+  std::string ToString() const {
+    std::ostringstream os;
+    os << "order: " << order << "\n";
+    os << "window: " << window << "\n";
+    return os.str();
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const DeltaFeaturesOptions &opts);
+
+/// It appends the deltas up to the given order to each frame of an
+/// OnlineGenericBaseFeature, like add-deltas in Kaldi. Frames before the
+/// first one and after the last one are replaced by the first and the last
+/// frame, respectively.
+///
+/// The frames of the source are copied into a ring buffer of the last
+/// 2 * order * window + 1 frames, so the source can pop its frames once
+/// they are read by Update(). A delta frame is computed as soon as its
+/// right context is available, i.e., with a latency of order * window
+/// frames, and the remaining ones after the input of the source is
+/// finished.
+///
+/// The output of frame t is [x_t, delta_t, delta-delta_t, ...], of
+/// dimension src->Dim() * (order + 1).
+template <class C>
+class OnlineDeltaFeature {
+ public:
+  /// @param src  Not owned. Its frame_opts.output_dtype must be "float32".
+  OnlineDeltaFeature(const DeltaFeaturesOptions &opts,
+                     const OnlineGenericBaseFeature<C> *src);
+
+  int32_t Dim() const { return src_dim_ * (opts_.order + 1); }
+
+  float FrameShiftInSeconds() const { return src_->FrameShiftInSeconds(); }
+
+  /// Read the frames of src that have not been read yet and compute the
+  /// delta frames that become ready. Call it after src->AcceptWaveform()
+  /// and src->InputFinished().
+  void Update();
+
+  int32_t NumFramesReady() const { return features_.Size(); }
+
+  // It returns true only if the input of src is finished, Update() has
+  // been called after that, and this frame is the last frame.
+  bool IsLastFrame(int32_t frame) const {
+    return input_finished_ && frame == NumFramesReady() - 1;
+  }
+
+  // Delta features are always float32
+  FeatureDtype OutputDtype() const { return FeatureDtype::kFloat32; }
+
+  const float *GetFrame(int32_t frame) const { return features_.At(frame); }
+
+  // discard the first n frames
+  void Pop(int32_t n) { features_.Pop(n); }
+
+ private:
+  // Compute output frame t from the frames in the ring buffer. Input
+  // frames after last are replaced by frame last.
+  void ComputeFrame(int32_t t, int32_t last);
+
+  const float *Row(int32_t i) const {
+    return ring_.data() + static_cast<int64_t>(i % ring_size_) * src_dim_;
+  }
+
+  DeltaFeaturesOptions opts_;
+  const OnlineGenericBaseFeature<C> *src_;  // Not owned
+  int32_t src_dim_;
+
+  // scales_[i] holds the 2 * i * window + 1 regression weights of the delta
+  // of order i with respect to the input frames, centered at the current
+  // frame. scales_[0] is [1].
+  std::vector<std::vector<float>> scales_;
+
+  // Input frame i is at row i % ring_size_
+  int32_t ring_size_;
+  std::vector<float> ring_;
+
+  // Number of frames read from src_
+  int32_t num_src_frames_ = 0;
+
+  bool input_finished_ = false;
+
+  RecyclingVector features_;
+};
+
+using OnlineDeltaFbank = OnlineDeltaFeature<FbankComputer>;
+using OnlineDeltaMfcc = OnlineDeltaFeature<MfccComputer>;
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_ONLINE_DELTA_FEATURE_H_
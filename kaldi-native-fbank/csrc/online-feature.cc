@@ -23,19 +23,33 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "kaldi-native-fbank/csrc/feature-window.h"
 #include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/simd.h"
 
 namespace knf {
 
-RecyclingVector::RecyclingVector(int32_t items_to_hold)
+RecyclingVector::RecyclingVector(
+    int32_t items_to_hold, FeatureDtype dtype /*= FeatureDtype::kFloat32*/)
     : items_to_hold_(items_to_hold == 0 ? -1 : items_to_hold),
-      first_available_index_(0) {}
+      first_available_index_(0),
+      dtype_(dtype) {}
 
 const float *RecyclingVector::At(int32_t index) const {
+  if (dtype_ != FeatureDtype::kFloat32) {
+    fprintf(stderr,
+            "The features are stored as %s. Use GetHalfFrame() instead of "
+            "GetFrame(), or set output_dtype to float32\n",
+            FeatureDtypeName(dtype_));
+    exit(-1);
+  }
+
   if (index < first_available_index_) {
     KNF_LOG(FATAL) << "Attempted to retrieve feature vector that was "
                       "already removed by the RecyclingVector (index = "
@@ -48,39 +62,124 @@ const float *RecyclingVector::At(int32_t index) const {
   return items_.at(index - first_available_index_).data();
 }
 
+const uint16_t *RecyclingVector::HalfAt(int32_t index) const {
+  if (dtype_ == FeatureDtype::kFloat32) {
+    fprintf(stderr,
+            "The features are stored as float32. Use GetFrame() instead of "
+            "GetHalfFrame()\n");
+    exit(-1);
+  }
+
+  if (index < first_available_index_) {
+    KNF_LOG(FATAL) << "Attempted to retrieve feature vector that was "
+                      "already removed by the RecyclingVector (index = "
+                   << index << "; "
+                   << "first_available_index = " << first_available_index_
+                   << "; "
+                   << "size = " << Size() << ")";
+  }
+  // 'at' does size checking.
+  return half_items_.at(index - first_available_index_).data();
+}
+
 void RecyclingVector::PushBack(std::vector<float> item) {
   // Note: -1 is a larger number when treated as unsigned
-  if (items_.size() == static_cast<size_t>(items_to_hold_)) {
-    items_.pop_front();
-    ++first_available_index_;
+  if (static_cast<size_t>(NumItems()) ==
+      static_cast<size_t>(items_to_hold_)) {
+    PopFront();
   }
-  items_.push_back(std::move(item));
+
+  if (dtype_ == FeatureDtype::kFloat32) {
+    items_.push_back(std::move(item));
+    return;
+  }
+
+  // The item has just been computed and is still in the cache
+  const SimdKernels &kernels = GetSimdKernels();
+  std::vector<uint16_t> half(item.size());
+  if (dtype_ == FeatureDtype::kFloat16) {
+    kernels.float_to_half(item.data(), half.data(), item.size());
+  } else {
+    kernels.float_to_bfloat16(item.data(), half.data(), item.size());
+  }
+  bytes_allocated_ += CapacityInBytes(half);
+  half_items_.push_back(std::move(half));
 }
 
 int32_t RecyclingVector::Size() const {
-  return first_available_index_ + static_cast<int32_t>(items_.size());
+  return first_available_index_ + NumItems();
 }
 
 // discard the first n frames
 void RecyclingVector::Pop(int32_t n) {
-  for (int32_t i = 0; i < n && !items_.empty(); ++i) {
+  for (int32_t i = 0; i < n && NumItems() > 0; ++i) {
+    PopFront();
+  }
+}
+
+int32_t RecyclingVector::NumItems() const {
+  return static_cast<int32_t>(dtype_ == FeatureDtype::kFloat32
+                                  ? items_.size()
+                                  : half_items_.size());
+}
+
+void RecyclingVector::PopFront() {
+  if (dtype_ == FeatureDtype::kFloat32) {
     items_.pop_front();
-    ++first_available_index_;
+  } else {
+    half_items_.pop_front();
   }
+  ++first_available_index_;
 }
 
 template <class C>
 OnlineGenericBaseFeature<C>::OnlineGenericBaseFeature(
-    const typename C::Options &opts)
+    const typename C::Options &opts,
+    const OnlineCmvnOptions &cmvn_opts /*= {}*/)
     : computer_(opts),
       window_function_(computer_.GetFrameOptions()),
+      cmvn_(cmvn_opts, computer_.Dim()),
+      features_(-1, computer_.GetFrameOptions().OutputDtype()),
       input_finished_(false),
       waveform_offset_(0) {}
 
 template <class C>
-void OnlineGenericBaseFeature<C>::AcceptWaveform(float sampling_rate,
-                                                 const float *waveform,
-                                                 int32_t n) {
+OnlineGenericBaseFeature<C>::OnlineGenericBaseFeature(
+    const FeatureExtractorConfig<C> &config)
+    : computer_(config.GetComputer()),
+      window_function_(config.GetWindowFunction()),
+      cmvn_(config.GetCmvn()),
+      features_(-1, computer_.GetFrameOptions().OutputDtype()),
+      input_finished_(false),
+      waveform_offset_(0) {}
+
+template <class C>
+OnlineGenericBaseFeature<C>::OnlineGenericBaseFeature(
+    const FeatureExtractorConfig<C> &config,
+    const OnlineCmvnOptions &cmvn_opts)
+    : computer_(config.GetComputer()),
+      window_function_(config.GetWindowFunction()),
+      cmvn_(cmvn_opts, computer_.Dim()),
+      features_(-1, computer_.GetFrameOptions().OutputDtype()),
+      input_finished_(false),
+      waveform_offset_(0) {}
+
+template <class C>
+void OnlineGenericBaseFeature<C>::MaybeCreateResampler(float sampling_rate) {
+  if (resampler_) {
+    KNF_CHECK_EQ(sampling_rate, resampler_->GetInputSamplingRate());
+    return;
+  }
+
+  resampler_ =
+      CreateResamplerIfNeeded(sampling_rate, computer_.GetFrameOptions());
+}
+
+template <class C>
+template <typename T, typename F>
+void OnlineGenericBaseFeature<C>::AcceptWaveformImpl(float sampling_rate,
+                                                     const T *waveform,
+                                                     int32_t n, F convert) {
   if (n == 0) {
     return;  // Nothing to do.
   }
@@ -89,21 +188,105 @@ void OnlineGenericBaseFeature<C>::AcceptWaveform(float sampling_rate,
     KNF_LOG(FATAL) << "AcceptWaveform called after InputFinished() was called.";
   }
 
-  KNF_CHECK_EQ(sampling_rate, computer_.GetFrameOptions().samp_freq);
+  MaybeCreateResampler(sampling_rate);
+
+#if KNF_ENABLE_PROFILING
+  size_t old_capacity = waveform_remainder_.capacity();
+  size_t old_resample_capacity = resample_buffer_.capacity();
+#endif
+
+  if (resampler_) {
+    const float *p;
+    if constexpr (std::is_same_v<T, float>) {
+      p = waveform;
+    } else {
+      resample_buffer_.resize(n);
+      convert(waveform, n, resample_buffer_.data());
+      p = resample_buffer_.data();
+    }
+    // The output is appended to waveform_remainder_ directly
+    resampler_->Resample(p, n, false, &waveform_remainder_);
+  } else if constexpr (std::is_same_v<T, float>) {
+    // A single pass over the samples
+    waveform_remainder_.insert(waveform_remainder_.end(), waveform,
+                               waveform + n);
+  } else {
+    // resize() zero-fills the tail before it is overwritten by convert()
+    size_t old_size = waveform_remainder_.size();
+    waveform_remainder_.resize(old_size + n);
+    convert(waveform, n, waveform_remainder_.data() + old_size);
+  }
 
-  waveform_remainder_.insert(waveform_remainder_.end(), waveform, waveform + n);
+#if KNF_ENABLE_PROFILING
+  CountReallocation(waveform_remainder_, old_capacity, &stats_);
+  CountReallocation(resample_buffer_, old_resample_capacity, &stats_);
+#endif
 
   ComputeFeatures();
 }
 
+template <class C>
+void OnlineGenericBaseFeature<C>::AcceptWaveform(float sampling_rate,
+                                                 const float *waveform,
+                                                 int32_t n) {
+  AcceptWaveformImpl(sampling_rate, waveform, n, nullptr);
+}
+
+template <class C>
+void OnlineGenericBaseFeature<C>::AcceptWaveform(float sampling_rate,
+                                                 const int16_t *waveform,
+                                                 int32_t n,
+                                                 bool normalize /*= true*/) {
+  float scale = normalize ? 1.0f / 32768 : 1.0f;
+  AcceptWaveformImpl(sampling_rate, waveform, n,
+                     [scale](const int16_t *in, int32_t n, float *out) {
+                       GetSimdKernels().int16_to_float(in, scale, out, n);
+                     });
+}
+
+template <class C>
+void OnlineGenericBaseFeature<C>::AcceptWaveform(float sampling_rate,
+                                                 const int32_t *waveform,
+                                                 int32_t n,
+                                                 bool normalize /*= true*/) {
+  float scale = normalize ? 1.0f / 2147483648.0f : 1.0f;
+  AcceptWaveformImpl(sampling_rate, waveform, n,
+                     [scale](const int32_t *in, int32_t n, float *out) {
+                       GetSimdKernels().int32_to_float(in, scale, out, n);
+                     });
+}
+
+template <class C>
+void OnlineGenericBaseFeature<C>::AcceptWaveform(float sampling_rate,
+                                                 const double *waveform,
+                                                 int32_t n) {
+  AcceptWaveformImpl(sampling_rate, waveform, n,
+                     [](const double *in, int32_t n, float *out) {
+                       GetSimdKernels().double_to_float(in, 1.0f, out, n);
+                     });
+}
+
 template <class C>
 void OnlineGenericBaseFeature<C>::InputFinished() {
+  if (resampler_ && !input_finished_) {
+#if KNF_ENABLE_PROFILING
+    size_t old_capacity = waveform_remainder_.capacity();
+#endif
+    // Flush the samples that are delayed by the filter
+    resampler_->Resample(nullptr, 0, true, &waveform_remainder_);
+#if KNF_ENABLE_PROFILING
+    CountReallocation(waveform_remainder_, old_capacity, &stats_);
+#endif
+  }
+
   input_finished_ = true;
   ComputeFeatures();
 }
 
 template <class C>
 void OnlineGenericBaseFeature<C>::ComputeFeatures() {
+  KNF_PROFILE_STATS(&stats_);
+
   const FrameExtractionOptions &frame_opts = computer_.GetFrameOptions();
 
   int64_t num_samples_total = waveform_offset_ + waveform_remainder_.size();
@@ -119,18 +302,31 @@ void OnlineGenericBaseFeature<C>::ComputeFeatures() {
   float vtln_warp = 1.0;
 
   std::vector<float> window;
+  std::vector<float> scratch;  // for dithering
   bool need_raw_log_energy = computer_.NeedRawLogEnergy();
 
+#if KNF_ENABLE_PROFILING
+  int64_t old_features_bytes = features_.BytesAllocated();
+#endif
+
   for (int32_t frame = num_frames_old; frame < num_frames_new; ++frame) {
     std::fill(window.begin(), window.end(), 0);
     float raw_log_energy = 0.0;
     ExtractWindow(waveform_offset_, waveform_remainder_, frame, frame_opts,
                   window_function_, &window,
-                  need_raw_log_energy ? &raw_log_energy : nullptr);
+                  need_raw_log_energy ? &raw_log_energy : nullptr, &scratch);
 
     std::vector<float> this_feature(computer_.Dim());
 
     computer_.Compute(raw_log_energy, vtln_warp, &window, this_feature.data());
+
+    if (cmvn_.Enabled()) {
+      KNF_PROFILE_SCOPE(kProfileCmvn);
+      cmvn_.Apply(this_feature.data());
+    }
+#if KNF_ENABLE_PROFILING
+    stats_.bytes_allocated += CapacityInBytes(this_feature);
+#endif
     features_.PushBack(std::move(this_feature));
   }
 
@@ -158,12 +354,49 @@ void OnlineGenericBaseFeature<C>::ComputeFeatures() {
       waveform_offset_ += samples_to_discard;
 
       waveform_remainder_.swap(new_remainder);
+
+#if KNF_ENABLE_PROFILING
+      stats_.bytes_allocated += CapacityInBytes(waveform_remainder_);
+#endif
     }
   }
+
+#if KNF_ENABLE_PROFILING
+  stats_.frames_processed += num_frames_new - num_frames_old;
+
+  // window and scratch are allocated in the first frame and reused
+  stats_.bytes_allocated += CapacityInBytes(window) + CapacityInBytes(scratch);
+  stats_.bytes_allocated += features_.BytesAllocated() - old_features_bytes;
+  stats_.samples_buffered = waveform_remainder_.size();
+#endif
+}
+
+template <class C>
+void OnlineGenericBaseFeature<C>::GetFrames(
+    int32_t frame, int32_t n, float *out,
+    FeatureLayout layout /*= FeatureLayout::kFrameMajor*/,
+    int32_t stride /*= 0*/) const {
+  if (OutputDtype() != FeatureDtype::kFloat32) {
+    fprintf(stderr,
+            "GetFrames() requires output_dtype float32. Given: %s. Use "
+            "GetHalfFrame() instead\n",
+            FeatureDtypeName(OutputDtype()));
+    exit(-1);
+  }
+  KNF_CHECK_LE(frame + n, NumFramesReady());
+
+  std::vector<const float *> frames(n);
+  for (int32_t i = 0; i != n; ++i) {
+    frames[i] = features_.At(frame + i);
+  }
+
+  WriteFrames(frames.data(), n, Dim(), layout, stride, out);
 }
 
 template class OnlineGenericBaseFeature<FbankComputer>;
 template class OnlineGenericBaseFeature<MfccComputer>;
 template class OnlineGenericBaseFeature<WhisperFeatureComputer>;
+template class OnlineGenericBaseFeature<MultiFeatureComputer>;
+template class OnlineGenericBaseFeature<SpectrogramComputer>;
 
 }  // namespace knf
@@ -23,11 +23,18 @@
 
 #include <cstdint>
 #include <deque>
+#include <memory>
 #include <vector>
 
 #include "kaldi-native-fbank/csrc/feature-fbank.h"
+#include "kaldi-native-fbank/csrc/feature-layout.h"
 #include "kaldi-native-fbank/csrc/feature-mfcc.h"
+#include "kaldi-native-fbank/csrc/feature-multi.h"
+#include "kaldi-native-fbank/csrc/feature-spectrogram.h"
 #include "kaldi-native-fbank/csrc/feature-window.h"
+#include "kaldi-native-fbank/csrc/online-cmvn.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+#include "kaldi-native-fbank/csrc/resample.h"
 #include "kaldi-native-fbank/csrc/whisper-feature.h"
 
 namespace knf {
@@ -42,16 +49,27 @@ namespace knf {
 class RecyclingVector {
  public:
   /// By default it does not remove any elements.
-  explicit RecyclingVector(int32_t items_to_hold = -1);
+  /// @param dtype  Element type of the stored items. Items are converted
+  ///               to it in PushBack().
+  explicit RecyclingVector(int32_t items_to_hold = -1,
+                           FeatureDtype dtype = FeatureDtype::kFloat32);
 
   ~RecyclingVector() = default;
   RecyclingVector(const RecyclingVector &) = delete;
   RecyclingVector &operator=(const RecyclingVector &) = delete;
 
+  FeatureDtype Dtype() const { return dtype_; }
+
   // The pointer is owned by RecyclingVector
   // Users should not free it
+  //
+  // It is valid only if Dtype() is kFloat32.
   const float *At(int32_t index) const;
 
+  // Like At(), but valid only if Dtype() is kFloat16 or kBFloat16.
+  // It returns the bits of the 16-bit values.
+  const uint16_t *HalfAt(int32_t index) const;
+
   void PushBack(std::vector<float> item);
 
   /// This method returns the size as if no "recycling" had happened,
@@ -62,10 +80,60 @@ class RecyclingVector {
   // discard the first n frames
   void Pop(int32_t n);
 
+  // Bytes allocated by PushBack() to convert items to Dtype(). Items in
+  // float32 are allocated by the caller and not counted here.
+  int64_t BytesAllocated() const { return bytes_allocated_; }
+
  private:
+  // Number of items that are held
+  int32_t NumItems() const;
+
+  void PopFront();
+
   std::deque<std::vector<float>> items_;
+
+  // Used instead of items_ if dtype_ is kFloat16 or kBFloat16
+  std::deque<std::vector<uint16_t>> half_items_;
+
   int32_t items_to_hold_;
   int32_t first_available_index_;
+  FeatureDtype dtype_;
+  int64_t bytes_allocated_ = 0;
+};
+
+/// It holds the immutable state that is needed to compute features with
+/// a given config, e.g., the window function, the mel banks, the DCT matrix
+/// and the FFT plan. Computing them is relatively expensive, so you can
+/// create it once per config and use it to construct many streams. A stream
+/// constructed in this way shares the tables with this object and
+/// keeps only its own mutable state.
+///
+/// It is safe to construct streams from the same config in different threads.
+template <class C>
+class FeatureExtractorConfig {
+ public:
+  /// @param cmvn_opts  CMVN of the streams constructed from this config.
+  ///                   If its mode is "global", the stats file is read
+  ///                   here once and the streams share the result.
+  explicit FeatureExtractorConfig(const typename C::Options &opts,
+                                  const OnlineCmvnOptions &cmvn_opts = {})
+      : computer_(opts),
+        window_function_(computer_.GetFrameOptions()),
+        cmvn_(cmvn_opts, computer_.Dim()) {}
+
+  const C &GetComputer() const { return computer_; }
+
+  const FeatureWindowFunction &GetWindowFunction() const {
+    return window_function_;
+  }
+
+  // The initial state of the CMVN of a stream
+  const OnlineCmvn &GetCmvn() const { return cmvn_; }
+
+ private:
+  C computer_;
+  FeatureWindowFunction window_function_;
+  OnlineCmvn cmvn_;
 };
 
 /// This is a templated class for online feature extraction;
@@ -75,34 +143,82 @@ template <class C>
 class OnlineGenericBaseFeature {
  public:
   // Constructor from options class
-  explicit OnlineGenericBaseFeature(const typename C::Options &opts);
+  //
+  // @param cmvn_opts  If its mode is not "none", each frame is normalized
+  //                   before it is stored. See online-cmvn.h
+  explicit OnlineGenericBaseFeature(const typename C::Options &opts,
+                                    const OnlineCmvnOptions &cmvn_opts = {});
+
+  // Constructor from a shared config. It is much cheaper than the one
+  // above since no tables are computed. The CMVN options of config are used.
+  explicit OnlineGenericBaseFeature(const FeatureExtractorConfig<C> &config);
+
+  // Like the above, but cmvn_opts replaces the CMVN options of config
+  OnlineGenericBaseFeature(const FeatureExtractorConfig<C> &config,
+                           const OnlineCmvnOptions &cmvn_opts);
 
   int32_t Dim() const { return computer_.Dim(); }
 
+  const C &GetComputer() const { return computer_; }
+
   float FrameShiftInSeconds() const {
     return computer_.GetFrameOptions().frame_shift_ms / 1000.0f;
   }
 
   int32_t NumFramesReady() const { return features_.Size(); }
 
+  FeatureDtype OutputDtype() const { return features_.Dtype(); }
+
   // Note: IsLastFrame() will only ever return true if you have called
   // InputFinished() (and this frame is the last frame).
   bool IsLastFrame(int32_t frame) const {
     return input_finished_ && frame == NumFramesReady() - 1;
   }
 
+  // It is valid only if frame_opts.output_dtype is "float32"
   const float *GetFrame(int32_t frame) const { return features_.At(frame); }
 
+  // It is valid only if frame_opts.output_dtype is "float16" or "bfloat16".
+  // It returns the bits of Dim() 16-bit values.
+  const uint16_t *GetHalfFrame(int32_t frame) const {
+    return features_.HalfAt(frame);
+  }
+
+  // Write frames [frame, frame + n) into out, e.g., an input tensor of a
+  // model, with the given layout. See WriteFrames() in feature-layout.h.
+  // It is valid only if frame_opts.output_dtype is "float32".
+  void GetFrames(int32_t frame, int32_t n, float *out,
+                 FeatureLayout layout = FeatureLayout::kFrameMajor,
+                 int32_t stride = 0) const;
+
   // This would be called from the application, when you get
   // more wave data.  Note: the sampling_rate is only provided so
   // the code can assert that it matches the sampling rate
-  // expected in the options.
+  // expected in the options, unless allow_downsample or allow_upsample
+  // is set, in which case the input is resampled.
   //
   // @param sampling_rate The sampling_rate of the input waveform
   // @param waveform Pointer to a 1-D array of size n
   // @param n Number of entries in waveform
   void AcceptWaveform(float sampling_rate, const float *waveform, int32_t n);
 
+  // Like the above, but for 16-bit and 32-bit integer samples, e.g., PCM
+  // from a telephony gateway. The samples are converted while they are
+  // appended to the internal buffer, so no temporary float copy is needed.
+  //
+  // @param normalize If true, samples are divided by 32768 (int16) or
+  //                  2147483648 (int32) so that they are in [-1, 1).
+  //                  If false, they are used as they are, e.g., for models
+  //                  trained with Kaldi, which expects int16 range.
+  void AcceptWaveform(float sampling_rate, const int16_t *waveform, int32_t n,
+                      bool normalize = true);
+
+  void AcceptWaveform(float sampling_rate, const int32_t *waveform, int32_t n,
+                      bool normalize = true);
+
+  // Samples are converted to float. No scaling is done.
+  void AcceptWaveform(float sampling_rate, const double *waveform, int32_t n);
+
   // InputFinished() tells the class you won't be providing any
   // more waveform.  This will help flush out the last frame or two
   // of features, in the case where snip-edges == false; it also
@@ -112,6 +228,16 @@ class OnlineGenericBaseFeature {
   // discard the first n frames
   void Pop(int32_t n) { features_.Pop(n); }
 
+  // Return a snapshot of the stats of this stream. All fields are 0 unless
+  // it is built with KNF_ENABLE_PROFILING. See profiling.h
+  ProfileStats GetStats() const {
+#if KNF_ENABLE_PROFILING
+    return stats_;
+#else
+    return {};
+#endif
+  }
+
  private:
   // This function computes any additional feature frames that it is possible to
   // compute from 'waveform_remainder_', which at this point may contain more
@@ -121,10 +247,22 @@ class OnlineGenericBaseFeature {
   // waveform_remainder_ while incrementing waveform_offset_ by the same amount.
   void ComputeFeatures();
 
+  // Create resampler_ if sampling_rate differs from the one in the options
+  void MaybeCreateResampler(float sampling_rate);
+
+  // Append samples to waveform_remainder_ and compute features.
+  // convert(waveform, n, out) writes n samples as float to out. It is not
+  // used if T is float.
+  template <typename T, typename F>
+  void AcceptWaveformImpl(float sampling_rate, const T *waveform, int32_t n,
+                          F convert);
+
   C computer_;  // class that does the MFCC or PLP or filterbank computation
 
   FeatureWindowFunction window_function_;
 
+  OnlineCmvn cmvn_;
+
   // features_ is the Mfcc or Plp or Fbank features that we have already
   // computed.
 
@@ -142,11 +280,32 @@ class OnlineGenericBaseFeature {
   // will be required for the next phase of computation).
   // It is a 1-D tensor
   std::vector<float> waveform_remainder_;
+
+  // Not null if the input is resampled. See
+  // FrameExtractionOptions::allow_downsample
+  std::unique_ptr<LinearResample> resampler_;
+
+  // Input samples converted to float before resampling
+  std::vector<float> resample_buffer_;
+
+#if KNF_ENABLE_PROFILING
+  ProfileStats stats_;
+#endif
 };
 
 using OnlineFbank = OnlineGenericBaseFeature<FbankComputer>;
 using OnlineMfcc = OnlineGenericBaseFeature<MfccComputer>;
 using OnlineWhisperFbank = OnlineGenericBaseFeature<WhisperFeatureComputer>;
+using OnlineMultiFeature = OnlineGenericBaseFeature<MultiFeatureComputer>;
+using OnlineSpectrogram = OnlineGenericBaseFeature<SpectrogramComputer>;
+
+using FbankExtractorConfig = FeatureExtractorConfig<FbankComputer>;
+using MfccExtractorConfig = FeatureExtractorConfig<MfccComputer>;
+using WhisperFbankExtractorConfig =
+    FeatureExtractorConfig<WhisperFeatureComputer>;
+using MultiFeatureExtractorConfig =
+    FeatureExtractorConfig<MultiFeatureComputer>;
+using SpectrogramExtractorConfig = FeatureExtractorConfig<SpectrogramComputer>;
 
 }  // namespace knf
 
@@ -0,0 +1,153 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/online-lfr-feature.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/simd.h"
+
+namespace knf {
+
+std::ostream &operator<<(std::ostream &os, const LfrOptions &opts) {
+  os << opts.ToString();
+  return os;
+}
+
+template <class C>
+OnlineLfrFeature<C>::OnlineLfrFeature(const LfrOptions &opts,
+                                      const OnlineGenericBaseFeature<C> *src)
+    : opts_(opts), src_(src), src_dim_(src->Dim()) {
+  if (opts.lfr_m < 1 || opts.lfr_n < 1) {
+    fprintf(stderr, "Invalid LFR options:\n%s\n", opts.ToString().c_str());
+    exit(-1);
+  }
+
+  if (src->OutputDtype() != FeatureDtype::kFloat32) {
+    fprintf(stderr,
+            "OnlineLfrFeature requires frame_opts.output_dtype to be "
+            "float32\n");
+    exit(-1);
+  }
+
+  ring_.resize(static_cast<int64_t>(opts.lfr_m) * src_dim_);
+}
+
+template <class C>
+void OnlineLfrFeature<C>::SetCmvn(const std::vector<float> &neg_mean,
+                                  const std::vector<float> &inv_stddev) {
+  if (static_cast<int32_t>(neg_mean.size()) != Dim() ||
+      static_cast<int32_t>(inv_stddev.size()) != Dim()) {
+    fprintf(stderr,
+            "Expect CMVN vectors of size %d. Given: %d and %d\n", Dim(),
+            static_cast<int32_t>(neg_mean.size()),
+            static_cast<int32_t>(inv_stddev.size()));
+    exit(-1);
+  }
+
+  neg_mean_ = neg_mean;
+  inv_stddev_ = inv_stddev;
+}
+
+template <class C>
+void OnlineLfrFeature<C>::Update() {
+  if (input_finished_) {
+    return;
+  }
+
+  int32_t m = opts_.lfr_m;
+  int32_t n = opts_.lfr_n;
+  int32_t left = (m - 1) / 2;
+
+  int32_t num_src_frames = src_->NumFramesReady();
+  for (; num_src_frames_ < num_src_frames; ++num_src_frames_) {
+    int32_t k = num_src_frames_;
+    memcpy(ring_.data() + static_cast<int64_t>(k % m) * src_dim_,
+           src_->GetFrame(k), src_dim_ * sizeof(float));
+
+    // Frame k is the last one of output frame i
+    int32_t i = NumFramesReady();
+    if (i * n - left + m - 1 == k) {
+      ComputeFrame(i, k);
+    }
+  }
+
+  if (num_src_frames > 0 && src_->IsLastFrame(num_src_frames - 1)) {
+    // ceil(num_src_frames / n) frames in total
+    for (int32_t i = NumFramesReady(); i * n < num_src_frames; ++i) {
+      ComputeFrame(i, num_src_frames - 1);
+    }
+    input_finished_ = true;
+  }
+}
+
+template <class C>
+void OnlineLfrFeature<C>::ComputeFrame(int32_t i, int32_t last) {
+  int32_t m = opts_.lfr_m;
+  int32_t begin = i * opts_.lfr_n - (m - 1) / 2;
+  int32_t dim = Dim();
+
+  if (num_dead_ > 0 && num_dead_ >= num_frames_) {
+    // The source and destination do not overlap
+    memcpy(features_.data(),
+           features_.data() + static_cast<int64_t>(num_dead_) * dim,
+           static_cast<int64_t>(num_frames_) * dim * sizeof(float));
+    num_dead_ = 0;
+  }
+
+  int32_t row = num_dead_ + num_frames_;
+  features_.resize(static_cast<int64_t>(row + 1) * dim);
+  float *p = features_.data() + static_cast<int64_t>(row) * dim;
+
+  for (int32_t j = 0; j != m; ++j, p += src_dim_) {
+    int32_t k = std::min(std::max(begin + j, 0), last);
+    memcpy(p, ring_.data() + static_cast<int64_t>(k % m) * src_dim_,
+           src_dim_ * sizeof(float));
+  }
+
+  if (!neg_mean_.empty()) {
+    const auto &kernels = GetSimdKernels();
+    p -= dim;
+    kernels.axpy(1, neg_mean_.data(), p, dim);
+    kernels.multiply(inv_stddev_.data(), p, dim);
+  }
+
+  ++num_frames_;
+}
+
+template <class C>
+void OnlineLfrFeature<C>::Pop(int32_t n) {
+  n = std::min(n, num_frames_);
+  if (n <= 0) {
+    return;
+  }
+
+  num_dead_ += n;
+  num_popped_ += n;
+  num_frames_ -= n;
+}
+
+template class OnlineLfrFeature<FbankComputer>;
+template class OnlineLfrFeature<MfccComputer>;
+
+}  // namespace knf
@@ -0,0 +1,148 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Low frame rate (LFR) features, as used by Paraformer and SenseVoice in
+// FunASR. Every lfr_n frames, lfr_m consecutive frames of an online feature
+// extractor are stacked into one output frame.
+//
+// See also apply_lfr() in funasr/frontends/wav_frontend.py
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_ONLINE_LFR_FEATURE_H_
+#define KALDI_NATIVE_FBANK_CSRC_ONLINE_LFR_FEATURE_H_
+
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+struct LfrOptions {
+  // Number of frames to stack
+  int32_t lfr_m = 7;
+
+  // Number of input frames per output frame
+  int32_t lfr_n = 6;
+
+  std::string ToString() const {
+    std::ostringstream os;
+    os << "lfr_m: " << lfr_m << "\n";
+    os << "lfr_n: " << lfr_n << "\n";
+    return os.str();
+  }
+};
+
+std::ostream &operator<<(std::ostream &os, const LfrOptions &opts);
+
+/// Output frame i is the concatenation of the input frames
+/// [i * lfr_n - (lfr_m - 1) / 2, i * lfr_n - (lfr_m - 1) / 2 + lfr_m).
+/// Frames before the first one are replaced by the first frame and frames
+/// after the last one by the last frame, so an input of T frames gives
+/// ceil(T / lfr_n) output frames, the same as FunASR.
+///
+/// Input frames are read by Update() into a ring buffer of the last lfr_m
+/// frames, so the source can pop its frames after that. Output frames are
+/// stored contiguously in row-major order and can be passed to a model
+/// without copying. See GetFrames().
+template <class C>
+class OnlineLfrFeature {
+ public:
+  /// @param src  Not owned. Its frame_opts.output_dtype must be "float32".
+  OnlineLfrFeature(const LfrOptions &opts,
+                   const OnlineGenericBaseFeature<C> *src);
+
+  int32_t Dim() const { return src_dim_ * opts_.lfr_m; }
+
+  float FrameShiftInSeconds() const {
+    return src_->FrameShiftInSeconds() * opts_.lfr_n;
+  }
+
+  /// Normalize each output frame with x[i] = (x[i] + neg_mean[i]) *
+  /// inv_stddev[i], like am.mvn of FunASR models. Both must be of size
+  /// Dim(). It affects only the frames computed after this call.
+  void SetCmvn(const std::vector<float> &neg_mean,
+               const std::vector<float> &inv_stddev);
+
+  /// Read the frames of src that have not been read yet and compute the
+  /// output frames that become ready. Call it after src->AcceptWaveform()
+  /// and src->InputFinished().
+  void Update();
+
+  int32_t NumFramesReady() const { return num_popped_ + num_frames_; }
+
+  // It returns true only if the input of src is finished, Update() has
+  // been called after that, and this frame is the last frame.
+  bool IsLastFrame(int32_t frame) const {
+    return input_finished_ && frame == NumFramesReady() - 1;
+  }
+
+  /// Return a row-major matrix of shape [NumFramesReady() - frame, Dim()]
+  /// holding the frames starting at the given one. It is valid until the
+  /// next call of Update() or Pop().
+  const float *GetFrames(int32_t frame) const {
+    return features_.data() +
+           static_cast<int64_t>(frame - num_popped_ + num_dead_) * Dim();
+  }
+
+  const float *GetFrame(int32_t frame) const { return GetFrames(frame); }
+
+  // LFR features are always float32
+  FeatureDtype OutputDtype() const { return FeatureDtype::kFloat32; }
+
+  // discard the first n frames
+  void Pop(int32_t n);
+
+ private:
+  // Append output frame i. Input frames after last are replaced by frame
+  // last.
+  void ComputeFrame(int32_t i, int32_t last);
+
+  LfrOptions opts_;
+  const OnlineGenericBaseFeature<C> *src_;  // Not owned
+  int32_t src_dim_;
+
+  // Empty if SetCmvn() is not called
+  std::vector<float> neg_mean_;
+  std::vector<float> inv_stddev_;
+
+  // Input frame k is at row k % lfr_m
+  std::vector<float> ring_;
+
+  // Number of frames read from src_
+  int32_t num_src_frames_ = 0;
+
+  bool input_finished_ = false;
+
+  // Output frames [num_popped_, num_popped_ + num_frames_) start at row
+  // num_dead_. Pop() only increases num_dead_. The popped rows are
+  // removed by ComputeFrame() once there are at least as many of them as
+  // live rows, so that each frame is moved O(1) times on average.
+  std::vector<float> features_;
+  int32_t num_popped_ = 0;
+  int32_t num_frames_ = 0;
+  int32_t num_dead_ = 0;
+};
+
+using OnlineLfrFbank = OnlineLfrFeature<FbankComputer>;
+using OnlineLfrMfcc = OnlineLfrFeature<MfccComputer>;
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_ONLINE_LFR_FEATURE_H_
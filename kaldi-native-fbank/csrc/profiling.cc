@@ -0,0 +1,146 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/profiling.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+namespace knf {
+
+const char *ProfileStageName(ProfileStage stage) {
+  switch (stage) {
+    case kProfileFraming:
+      return "framing";
+    case kProfileWindow:
+      return "window";
+    case kProfileFft:
+      return "fft";
+    case kProfilePowerSpectrum:
+      return "power_spectrum";
+    case kProfileMel:
+      return "mel";
+    case kProfileLog:
+      return "log";
+    case kProfileOverlapAdd:
+      return "overlap_add";
+    case kProfileCmvn:
+      return "cmvn";
+    default:
+      return "unknown";
+  }
+}
+
+void ProfileStats::Merge(const ProfileStats &other) {
+  for (int32_t i = 0; i != kNumProfileStages; ++i) {
+    cycles[i] += other.cycles[i];
+    calls[i] += other.calls[i];
+  }
+
+  frames_processed += other.frames_processed;
+  bytes_allocated += other.bytes_allocated;
+
+  samples_buffered = std::max(samples_buffered, other.samples_buffered);
+  queue_depth = std::max(queue_depth, other.queue_depth);
+}
+
+std::string ProfileStats::ToString() const {
+  std::ostringstream os;
+  os << "ProfileStats(";
+  for (int32_t i = 0; i != kNumProfileStages; ++i) {
+    os << ProfileStageName(static_cast<ProfileStage>(i)) << "=(cycles="
+       << cycles[i] << ", calls=" << calls[i] << "), ";
+  }
+  os << "frames_processed=" << frames_processed << ", ";
+  os << "samples_buffered=" << samples_buffered << ", ";
+  os << "bytes_allocated=" << bytes_allocated << ", ";
+  os << "queue_depth=" << queue_depth << ")";
+  return os.str();
+}
+
+std::string ToPrometheusText(const ProfileStats &stats,
+                             const std::string &prefix /*= "knf"*/,
+                             const std::string &labels /*= ""*/) {
+  std::ostringstream os;
+
+  // {labels} or {labels,stage="fft"}
+  auto label_set = [&labels](const std::string &stage) -> std::string {
+    std::string s = labels;
+    if (!stage.empty()) {
+      if (!s.empty()) {
+        s += ",";
+      }
+      s += "stage=\"" + stage + "\"";
+    }
+    return s.empty() ? "" : "{" + s + "}";
+  };
+
+  os << "# HELP " << prefix
+     << "_stage_cycles_total CPU cycles spent in each stage\n";
+  os << "# TYPE " << prefix << "_stage_cycles_total counter\n";
+  for (int32_t i = 0; i != kNumProfileStages; ++i) {
+    os << prefix << "_stage_cycles_total"
+       << label_set(ProfileStageName(static_cast<ProfileStage>(i))) << " "
+       << stats.cycles[i] << "\n";
+  }
+
+  os << "# HELP " << prefix
+     << "_stage_calls_total Number of times each stage is run\n";
+  os << "# TYPE " << prefix << "_stage_calls_total counter\n";
+  for (int32_t i = 0; i != kNumProfileStages; ++i) {
+    os << prefix << "_stage_calls_total"
+       << label_set(ProfileStageName(static_cast<ProfileStage>(i))) << " "
+       << stats.calls[i] << "\n";
+  }
+
+  struct Metric {
+    const char *name;
+    const char *type;
+    const char *help;
+    int64_t value;
+  };
+
+  Metric metrics[] = {
+      {"frames_processed_total", "counter", "Number of frames computed",
+       stats.frames_processed},
+      {"samples_buffered", "gauge", "Number of samples waiting for a frame",
+       stats.samples_buffered},
+      {"bytes_allocated_total", "counter", "Bytes allocated for buffers",
+       stats.bytes_allocated},
+      {"queue_depth", "gauge", "Number of chunks waiting in the queue",
+       stats.queue_depth},
+  };
+
+  for (const auto &m : metrics) {
+    os << "# HELP " << prefix << "_" << m.name << " " << m.help << "\n";
+    os << "# TYPE " << prefix << "_" << m.name << " " << m.type << "\n";
+    os << prefix << "_" << m.name << label_set("") << " " << m.value << "\n";
+  }
+
+  return os.str();
+}
+
+#if KNF_ENABLE_PROFILING
+ProfileStats *&CurrentProfileStats() {
+  thread_local ProfileStats *stats = nullptr;
+  return stats;
+}
+#endif
+
+}  // namespace knf
@@ -0,0 +1,198 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Optional instrumentation of the feature extraction pipeline.
+//
+// It is enabled by building with -DKALDI_NATIVE_FBANK_ENABLE_PROFILING=ON,
+// which defines KNF_ENABLE_PROFILING=1. Otherwise, all KNF_PROFILE_* macros
+// expand to nothing and GetStats() methods return zeros.
+//
+// Usage:
+//
+//   knf::OnlineFbank fbank(opts);
+//   ...
+//   knf::ProfileStats stats = fbank.GetStats();
+//   std::cout << knf::ToPrometheusText(stats, "knf_fbank", "stream=\"1\"");
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_PROFILING_H_
+#define KALDI_NATIVE_FBANK_CSRC_PROFILING_H_
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#if KNF_ENABLE_PROFILING && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#endif
+
+namespace knf {
+
+enum ProfileStage : int32_t {
+  kProfileFraming = 0,    // copy samples into frames
+  kProfileWindow,         // dither, dc removal, pre-emphasis and windowing
+  kProfileFft,            // forward or inverse FFT
+  kProfilePowerSpectrum,  // |X|^2
+  kProfileMel,            // mel filter banks
+  kProfileLog,            // log, and the DCT for MFCC
+  kProfileOverlapAdd,     // IStft only
+  kProfileCmvn,           // OnlineCmvn
+  kNumProfileStages,
+};
+
+// Return a name in snake_case, e.g., "power_spectrum"
+const char *ProfileStageName(ProfileStage stage);
+
+struct ProfileStats {
+  // Indexed by ProfileStage. cycles is the number of CPU cycles on x86 and
+  // nanoseconds on other platforms.
+  uint64_t cycles[kNumProfileStages] = {};
+  uint64_t calls[kNumProfileStages] = {};
+
+  int64_t frames_processed = 0;
+
+  // Number of input samples that are buffered but not yet consumed.
+  // It is a gauge.
+  int64_t samples_buffered = 0;
+
+  // Total bytes of the heap buffers allocated by the feature extractor.
+  // A buffer is counted with its capacity each time it is (re)allocated.
+  int64_t bytes_allocated = 0;
+
+  // Number of chunks waiting in the queue. Used only by AsyncOnlineFeature.
+  // It is a gauge.
+  int64_t queue_depth = 0;
+
+  // Counters are added. Gauges keep the larger of the two values, so that
+  // merging the stats of a call into running stats does not double them.
+  void Merge(const ProfileStats &other);
+
+  std::string ToString() const;
+};
+
+// Export stats in the Prometheus text format, e.g.,
+//
+//   knf_stage_cycles_total{stage="fft"} 12345
+//   knf_frames_processed_total 100
+//
+// @param stats  The stats to export.
+// @param prefix Prefix of the metric names.
+// @param labels If not empty, it is added to every metric, e.g.,
+//               stream="3",model="zipformer"
+std::string ToPrometheusText(const ProfileStats &stats,
+                             const std::string &prefix = "knf",
+                             const std::string &labels = "");
+
+// Number of bytes of the buffer that v has allocated
+template <typename T>
+int64_t CapacityInBytes(const std::vector<T> &v) {
+  return static_cast<int64_t>(v.capacity() * sizeof(T));
+}
+
+// Call it after an operation that may grow v. If the capacity of v is no
+// longer old_capacity, v has allocated a new buffer, which is added to
+// stats->bytes_allocated.
+template <typename T>
+void CountReallocation(const std::vector<T> &v, size_t old_capacity,
+                       ProfileStats *stats) {
+  if (v.capacity() != old_capacity) {
+    stats->bytes_allocated += CapacityInBytes(v);
+  }
+}
+
+inline uint64_t ReadCycleCounter() {
+#if KNF_ENABLE_PROFILING && (defined(__x86_64__) || defined(__i386__))
+  return __rdtsc();
+#else
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+#endif
+}
+
+#if KNF_ENABLE_PROFILING
+
+// The stats that KNF_PROFILE_SCOPE() on this thread writes to. It may
+// be null.
+ProfileStats *&CurrentProfileStats();
+
+// Make stats the current stats of this thread during its lifetime
+class ScopedProfileStats {
+ public:
+  explicit ScopedProfileStats(ProfileStats *stats)
+      : prev_(CurrentProfileStats()) {
+    CurrentProfileStats() = stats;
+  }
+
+  ~ScopedProfileStats() { CurrentProfileStats() = prev_; }
+
+  ScopedProfileStats(const ScopedProfileStats &) = delete;
+  ScopedProfileStats &operator=(const ScopedProfileStats &) = delete;
+
+ private:
+  ProfileStats *prev_;
+};
+
+class ScopedProfileTimer {
+ public:
+  explicit ScopedProfileTimer(ProfileStage stage)
+      : stats_(CurrentProfileStats()), stage_(stage) {
+    if (stats_) {
+      start_ = ReadCycleCounter();
+    }
+  }
+
+  ~ScopedProfileTimer() {
+    if (stats_) {
+      stats_->cycles[stage_] += ReadCycleCounter() - start_;
+      stats_->calls[stage_] += 1;
+    }
+  }
+
+  ScopedProfileTimer(const ScopedProfileTimer &) = delete;
+  ScopedProfileTimer &operator=(const ScopedProfileTimer &) = delete;
+
+ private:
+  ProfileStats *stats_;
+  ProfileStage stage_;
+  uint64_t start_ = 0;
+};
+
+#define KNF_PROFILE_CONCAT_IMPL(a, b) a##b
+#define KNF_PROFILE_CONCAT(a, b) KNF_PROFILE_CONCAT_IMPL(a, b)
+
+// Time the enclosing scope and attribute it to the given stage
+#define KNF_PROFILE_SCOPE(stage)                                   \
+  ::knf::ScopedProfileTimer KNF_PROFILE_CONCAT(knf_profile_timer_, \
+                                               __LINE__)(stage)
+
+// Record into *stats in the enclosing scope
+#define KNF_PROFILE_STATS(stats)                                   \
+  ::knf::ScopedProfileStats KNF_PROFILE_CONCAT(knf_profile_stats_, \
+                                               __LINE__)(stats)
+
+#else
+
+#define KNF_PROFILE_SCOPE(stage)
+#define KNF_PROFILE_STATS(stats)
+
+#endif  // KNF_ENABLE_PROFILING
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_PROFILING_H_
@@ -0,0 +1,351 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file is copied/modified from kaldi/src/feat/resample.cc
+
+#include "kaldi-native-fbank/csrc/resample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/kaldi-math.h"
+#include "kaldi-native-fbank/csrc/log.h"
+#include "kaldi-native-fbank/csrc/shared-cache.h"
+#include "kaldi-native-fbank/csrc/simd.h"
+
+namespace knf {
+
+struct LinearResample::Filter {
+  // The weights repeat every input_samples_in_unit input samples and
+  // every output_samples_in_unit output samples.
+  int32_t input_samples_in_unit = 0;
+  int32_t output_samples_in_unit = 0;
+
+  // first_index[i] is the first input sample that output sample i
+  // depends on, for 0 <= i < output_samples_in_unit.
+  // It may be negative.
+  std::vector<int32_t> first_index;
+
+  // weights[i] are the weights for output sample i, applied to input
+  // samples starting from first_index[i].
+  std::vector<std::vector<float>> weights;
+};
+
+namespace {
+
+using FilterKey = std::tuple<int32_t, int32_t, float, int32_t>;
+
+using FilterCache = SharedCache<FilterKey, LinearResample::Filter>;
+
+FilterCache &GetFilterCache() {
+  // It is never destroyed. See SharedCache
+  static auto *cache = new FilterCache;
+  return *cache;
+}
+
+// The windowed sinc filter. t is in seconds.
+double FilterFunc(double t, float filter_cutoff, int32_t num_zeros) {
+  double window, filter;
+  if (std::fabs(t) < num_zeros / (2.0 * filter_cutoff)) {
+    window = 0.5 * (1 + std::cos(M_2PI * filter_cutoff / num_zeros * t));
+  } else {
+    window = 0.0;  // outside support of the window function
+  }
+
+  if (t != 0) {
+    filter = std::sin(M_2PI * filter_cutoff * t) / (M_PI * t);
+  } else {
+    filter = 2 * filter_cutoff;  // limit of the function at t = 0
+  }
+
+  return filter * window;
+}
+
+std::shared_ptr<const LinearResample::Filter> CreateFilter(
+    int32_t samp_rate_in, int32_t samp_rate_out, float filter_cutoff,
+    int32_t num_zeros) {
+  auto filter = std::make_shared<LinearResample::Filter>();
+
+  int32_t base_freq = std::gcd(samp_rate_in, samp_rate_out);
+  filter->input_samples_in_unit = samp_rate_in / base_freq;
+  filter->output_samples_in_unit = samp_rate_out / base_freq;
+
+  int32_t n = filter->output_samples_in_unit;
+  filter->first_index.resize(n);
+  filter->weights.resize(n);
+
+  double window_width = num_zeros / (2.0 * filter_cutoff);
+
+  for (int32_t i = 0; i != n; ++i) {
+    double output_t = i / static_cast<double>(samp_rate_out);
+    double min_t = output_t - window_width;
+    double max_t = output_t + window_width;
+
+    // we do ceil on the min and floor on the max, because if we did it
+    // the other way around we would unnecessarily include indexes just
+    // outside the window, with zero coefficients.
+    int32_t min_input_index = std::ceil(min_t * samp_rate_in);
+    int32_t max_input_index = std::floor(max_t * samp_rate_in);
+    int32_t num_indices = max_input_index - min_input_index + 1;
+
+    filter->first_index[i] = min_input_index;
+    auto &weights = filter->weights[i];
+    weights.resize(num_indices);
+    for (int32_t j = 0; j != num_indices; ++j) {
+      int32_t input_index = min_input_index + j;
+      double input_t = input_index / static_cast<double>(samp_rate_in);
+      double delta_t = input_t - output_t;
+
+      // sign of delta_t doesn't matter.
+      weights[j] =
+          FilterFunc(delta_t, filter_cutoff, num_zeros) / samp_rate_in;
+    }
+  }
+
+  return filter;
+}
+
+// Like MelBanksCache, the filter is shared by all resamplers with the
+// same arguments and is freed when the last of them is destroyed.
+std::shared_ptr<const LinearResample::Filter> GetFilter(int32_t samp_rate_in,
+                                                        int32_t samp_rate_out,
+                                                        float filter_cutoff,
+                                                        int32_t num_zeros) {
+  FilterKey key{samp_rate_in, samp_rate_out, filter_cutoff, num_zeros};
+  return GetFilterCache().Get(key, [&]() {
+    return CreateFilter(samp_rate_in, samp_rate_out, filter_cutoff,
+                        num_zeros);
+  });
+}
+
+}  // namespace
+
+LinearResample::LinearResample(int32_t samp_rate_in_hz,
+                               int32_t samp_rate_out_hz,
+                               float filter_cutoff_hz, int32_t num_zeros)
+    : samp_rate_in_(samp_rate_in_hz),
+      samp_rate_out_(samp_rate_out_hz),
+      filter_cutoff_(filter_cutoff_hz),
+      num_zeros_(num_zeros) {
+  KNF_CHECK_GT(samp_rate_in_hz, 0);
+  KNF_CHECK_GT(samp_rate_out_hz, 0);
+  KNF_CHECK_GT(filter_cutoff_hz, 0);
+  KNF_CHECK_LE(filter_cutoff_hz * 2, samp_rate_in_hz);
+  KNF_CHECK_LE(filter_cutoff_hz * 2, samp_rate_out_hz);
+  KNF_CHECK_GT(num_zeros, 0);
+
+  filter_ = GetFilter(samp_rate_in_, samp_rate_out_, filter_cutoff_,
+                      num_zeros_);
+}
+
+int64_t LinearResample::GetNumOutputSamples(int64_t input_num_samp,
+                                            bool flush) const {
+  // For exact computation, we measure time in "ticks" of 1.0 / tick_freq,
+  // where tick_freq is the least common multiple of samp_rate_in_ and
+  // samp_rate_out_.
+  int64_t tick_freq = std::lcm<int64_t>(samp_rate_in_, samp_rate_out_);
+  int64_t ticks_per_input_period = tick_freq / samp_rate_in_;
+
+  // work out the number of ticks in the time interval
+  // [ 0, input_num_samp/samp_rate_in_ ).
+  int64_t interval_length_in_ticks = input_num_samp * ticks_per_input_period;
+  if (!flush) {
+    double window_width = num_zeros_ / (2.0 * filter_cutoff_);
+    // To count the window-width in ticks we take the floor. This
+    // is because since we're looking for the largest integer num-out-samp
+    // that fits in the interval, which is open on the right, a reduction
+    // in interval length of less than a tick will never make a difference.
+    int64_t window_width_ticks = std::floor(window_width * tick_freq);
+    interval_length_in_ticks -= window_width_ticks;
+  }
+
+  if (interval_length_in_ticks <= 0) {
+    return 0;
+  }
+
+  int64_t ticks_per_output_period = tick_freq / samp_rate_out_;
+
+  // Get the last output-sample in the closed interval, i.e. replacing [ ) with
+  // [ ]. Note: integer division rounds down. See
+  // http://en.wikipedia.org/wiki/Interval_(mathematics) for an explanation of
+  // the notation.
+  int64_t last_output_samp = interval_length_in_ticks / ticks_per_output_period;
+
+  // We need the last output-sample in the open interval, so if it takes us to
+  // the end of the interval exactly, subtract one.
+  if (last_output_samp * ticks_per_output_period == interval_length_in_ticks) {
+    last_output_samp--;
+  }
+
+  // First output-sample index is zero, so the number of output samples
+  // is the last output-sample plus one.
+  return last_output_samp + 1;
+}
+
+void LinearResample::GetIndexes(int64_t samp_out, int64_t *first_samp_in,
+                                int32_t *samp_out_wrapped) const {
+  // A unit is the smallest nonzero amount of time that is an exact
+  // multiple of the input and output sample periods. The unit index
+  // is the answer to "which numbered unit we are in".
+  int64_t unit_index = samp_out / filter_->output_samples_in_unit;
+
+  // samp_out_wrapped is equal to samp_out % output_samples_in_unit
+  *samp_out_wrapped = static_cast<int32_t>(
+      samp_out - unit_index * filter_->output_samples_in_unit);
+
+  *first_samp_in = filter_->first_index[*samp_out_wrapped] +
+                   unit_index * filter_->input_samples_in_unit;
+}
+
+void LinearResample::Resample(const float *input, int32_t input_dim,
+                              bool flush, std::vector<float> *output) {
+  int64_t tot_input_samp = input_sample_offset_ + input_dim;
+  int64_t tot_output_samp = GetNumOutputSamples(tot_input_samp, flush);
+
+  KNF_CHECK_GE(tot_output_samp, output_sample_offset_);
+
+  size_t old_size = output->size();
+  output->resize(old_size + (tot_output_samp - output_sample_offset_));
+  float *out = output->data() + old_size;
+
+  const SimdKernels &kernels = GetSimdKernels();
+  int32_t remainder_dim = input_remainder_.size();
+
+  // Loop over the output samples
+  for (int64_t samp_out = output_sample_offset_; samp_out < tot_output_samp;
+       ++samp_out) {
+    int64_t first_samp_in;
+    int32_t samp_out_wrapped;
+    GetIndexes(samp_out, &first_samp_in, &samp_out_wrapped);
+
+    const auto &weights = filter_->weights[samp_out_wrapped];
+    int32_t num_weights = weights.size();
+
+    // first_input_index is the first index into "input" that we have a
+    // weight for.
+    int32_t first_input_index =
+        static_cast<int32_t>(first_samp_in - input_sample_offset_);
+
+    float this_output;
+    if (first_input_index >= 0 &&
+        first_input_index + num_weights <= input_dim) {
+      // This is the common case
+      this_output = kernels.inner_product(input + first_input_index,
+                                          weights.data(), num_weights);
+    } else {
+      // Handle edge cases: samples from the previous call, or beyond the
+      // end of the input when flushing, which are treated as zeros.
+      this_output = 0;
+      for (int32_t i = 0; i != num_weights; ++i) {
+        float weight = weights[i];
+        int32_t input_index = first_input_index + i;
+        if (input_index < 0 && remainder_dim + input_index >= 0) {
+          this_output += weight * input_remainder_[remainder_dim + input_index];
+        } else if (input_index >= 0 && input_index < input_dim) {
+          this_output += weight * input[input_index];
+        } else if (input_index >= input_dim) {
+          // We're past the end of the input and are adding zero; should only
+          // happen if the user specified flush == true, or else we would not
+          // be trying to output this sample.
+          KNF_CHECK(flush);
+        }
+      }
+    }
+
+    *out++ = this_output;
+  }
+
+  if (flush) {
+    Reset();  // Reset the internal state.
+  } else {
+    SetRemainder(input, input_dim);
+    input_sample_offset_ = tot_input_samp;
+    output_sample_offset_ = tot_output_samp;
+  }
+}
+
+void LinearResample::SetRemainder(const float *input, int32_t input_dim) {
+  // max_remainder_needed is the width of the filter from side to side,
+  // measured in input samples. You might think it should be half that,
+  // but you have to consider that you might be wanting to output samples
+  // that are "in the past" relative to the beginning of the latest
+  // input... anyway, storing more remainder than needed is not harmful.
+  int32_t max_remainder_needed =
+      std::ceil(samp_rate_in_ * num_zeros_ / filter_cutoff_);
+
+  std::vector<float> remainder(max_remainder_needed);
+  int32_t old_dim = input_remainder_.size();
+
+  for (int32_t index = -max_remainder_needed; index < 0; ++index) {
+    // we interpret "index" as an offset from the end of "input" and
+    // from the end of input_remainder_.
+    int32_t input_index = index + input_dim;
+    if (input_index >= 0) {
+      remainder[index + max_remainder_needed] = input[input_index];
+    } else if (input_index + old_dim >= 0) {
+      remainder[index + max_remainder_needed] =
+          input_remainder_[input_index + old_dim];
+    }
+    // else leave it at zero.
+  }
+
+  input_remainder_.swap(remainder);
+}
+
+void LinearResample::Reset() {
+  input_sample_offset_ = 0;
+  output_sample_offset_ = 0;
+  input_remainder_.clear();
+}
+
+std::unique_ptr<LinearResample> CreateResamplerIfNeeded(
+    float sampling_rate, const FrameExtractionOptions &opts) {
+  float expected_sampling_rate = opts.samp_freq;
+  if (sampling_rate == expected_sampling_rate) {
+    return nullptr;
+  }
+
+  if ((sampling_rate > expected_sampling_rate && opts.allow_downsample) ||
+      (sampling_rate < expected_sampling_rate && opts.allow_upsample)) {
+    if (sampling_rate != static_cast<int32_t>(sampling_rate) ||
+        expected_sampling_rate != static_cast<int32_t>(expected_sampling_rate)) {
+      KNF_LOG(FATAL) << "Only integer sampling rates are supported for "
+                     << "resampling. Given " << sampling_rate << " and "
+                     << expected_sampling_rate;
+    }
+
+    // The same as ResampleWaveform() in Kaldi. The cutoff is a bit below
+    // the lower Nyquist frequency so that the transition band does not
+    // alias.
+    float min_freq = std::min(sampling_rate, expected_sampling_rate);
+    float cutoff = 0.99f * 0.5f * min_freq;
+    return std::make_unique<LinearResample>(
+        sampling_rate, expected_sampling_rate, cutoff, /*num_zeros*/ 6);
+  }
+
+  KNF_LOG(FATAL) << "Sampling frequency mismatch, expected "
+                 << expected_sampling_rate << ", got " << sampling_rate
+                 << "\nPerhaps you want to use the options allow_downsample "
+                 << "or allow_upsample";
+  return nullptr;
+}
+
+}  // namespace knf
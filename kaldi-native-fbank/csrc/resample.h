@@ -0,0 +1,119 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// This file is copied/modified from kaldi/src/feat/resample.h
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_RESAMPLE_H_
+#define KALDI_NATIVE_FBANK_CSRC_RESAMPLE_H_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/feature-window.h"
+
+namespace knf {
+
+/**
+   LinearResample is a streaming resampler for signals whose sampling rates
+   are integers (in Hz), e.g., from 8000 Hz or 44100 Hz to 16000 Hz.
+
+   It is a polyphase FIR filter with a windowed sinc. Since the input and
+   output sampling rates are integers, the filter weights repeat every
+   gcd(samp_rate_in, samp_rate_out) Hz, so only one period of them is
+   computed. The weights depend only on the constructor arguments and are
+   shared by all resamplers with the same arguments.
+
+   You can call Resample() many times with consecutive chunks of the input.
+   It keeps the tail of the input that is needed by the next call.
+ */
+class LinearResample {
+ public:
+  /// @param samp_rate_in_hz  Sampling rate of the input.
+  /// @param samp_rate_out_hz  Sampling rate of the output.
+  /// @param filter_cutoff_hz  The cutoff frequency of the lowpass filter.
+  ///                          It must be <= half of both sampling rates.
+  /// @param num_zeros  Controls the sharpness of the filter. A larger value
+  ///                   gives a sharper filter but it is slower.
+  LinearResample(int32_t samp_rate_in_hz, int32_t samp_rate_out_hz,
+                 float filter_cutoff_hz, int32_t num_zeros);
+
+  /// Resample a chunk of the input and append the result to output.
+  ///
+  /// @param input  Pointer to an array of size input_dim.
+  /// @param input_dim  Number of samples in input. It can be 0.
+  /// @param flush  True if this is the last chunk of the input. The filter
+  ///               state is reset afterwards so that the object can be
+  ///               used for a new signal.
+  /// @param output  The output samples are appended to it.
+  void Resample(const float *input, int32_t input_dim, bool flush,
+                std::vector<float> *output);
+
+  /// Reset the filter state so that the object can be used for a new signal.
+  void Reset();
+
+  int32_t GetInputSamplingRate() const { return samp_rate_in_; }
+
+  int32_t GetOutputSamplingRate() const { return samp_rate_out_; }
+
+  struct Filter;
+
+ private:
+  // Return the number of output samples that we can produce given
+  // input_num_samp input samples in total.
+  int64_t GetNumOutputSamples(int64_t input_num_samp, bool flush) const;
+
+  // Given an output-sample index, return the index of the first input sample
+  // that it depends on and the index of its weights in filter_->weights.
+  void GetIndexes(int64_t samp_out, int64_t *first_samp_in,
+                  int32_t *samp_out_wrapped) const;
+
+  // Save the tail of the input, which is needed by the next call to
+  // Resample().
+  void SetRemainder(const float *input, int32_t input_dim);
+
+ private:
+  int32_t samp_rate_in_;
+  int32_t samp_rate_out_;
+  float filter_cutoff_;
+  int32_t num_zeros_;
+
+  std::shared_ptr<const Filter> filter_;
+
+  // Number of input samples that we have already seen
+  int64_t input_sample_offset_ = 0;
+
+  // Number of output samples that we have already produced
+  int64_t output_sample_offset_ = 0;
+
+  // The tail of the input seen so far
+  std::vector<float> input_remainder_;
+};
+
+/// Return a resampler from sampling_rate to opts.samp_freq, like what Kaldi
+/// does for online feature extraction.
+///
+/// It returns nullptr if sampling_rate equals opts.samp_freq. It is an error
+/// if they differ and opts.allow_downsample (or opts.allow_upsample) is
+/// false.
+std::unique_ptr<LinearResample> CreateResamplerIfNeeded(
+    float sampling_rate, const FrameExtractionOptions &opts);
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_RESAMPLE_H_
@@ -20,6 +20,8 @@
 
 #include <algorithm>
 #include <cmath>
+#include <map>
+#include <utility>
 #include <vector>
 
 #include "kaldi-native-fbank/csrc/log.h"
@@ -27,6 +29,56 @@
 
 namespace knf {
 
+namespace {
+
+// kiss_fftr() uses a scratch buffer inside its config, so a config
+// cannot be used by two threads at the same time. We keep one config
+// per (n, inverse) per thread, which is shared by all Rfft instances
+// running on that thread. It is freed when the thread exits.
+class KissFftrPlans {
+ public:
+  KissFftrPlans() = default;
+  KissFftrPlans(const KissFftrPlans &) = delete;
+  KissFftrPlans &operator=(const KissFftrPlans &) = delete;
+
+  ~KissFftrPlans() {
+    for (auto &p : plans_) {
+      kiss_fftr_free(p.second);
+    }
+  }
+
+  kiss_fftr_cfg Get(int32_t n, bool inverse) {
+    auto key = std::make_pair(n, inverse);
+    auto iter = plans_.find(key);
+    if (iter != plans_.end()) {
+      return iter->second;
+    }
+
+    kiss_fftr_cfg cfg = kiss_fftr_alloc(n, inverse, nullptr, nullptr);
+    plans_[key] = cfg;
+    return cfg;
+  }
+
+  // Return a buffer of at least n elements
+  kiss_fft_cpx *GetBuffer(int32_t n) {
+    if (static_cast<int32_t>(buffer_.size()) < n) {
+      buffer_.resize(n);
+    }
+    return buffer_.data();
+  }
+
+ private:
+  std::map<std::pair<int32_t, bool>, kiss_fftr_cfg> plans_;
+  std::vector<kiss_fft_cpx> buffer_;
+};
+
+KissFftrPlans &GetKissFftrPlans() {
+  thread_local KissFftrPlans plans;
+  return plans;
+}
+
+}  // namespace
+
 class Rfft::RfftImpl {
  public:
   RfftImpl(int32_t n, bool inverse) : n_(n), inverse_(inverse) {
@@ -59,13 +111,12 @@ class Rfft::RfftImpl {
 
  private:
   void Forward(float *in_out) const {
-    kiss_fftr_cfg cfg = kiss_fftr_alloc(n_, 0, nullptr, nullptr);
+    KissFftrPlans &plans = GetKissFftrPlans();
+    kiss_fftr_cfg cfg = plans.Get(n_, false);
 
-    std::vector<kiss_fft_cpx> out(n_ / 2 + 1);
+    kiss_fft_cpx *out = plans.GetBuffer(n_ / 2 + 1);
 
-    kiss_fftr(cfg, in_out, out.data());
-
-    kiss_fftr_free(cfg);
+    kiss_fftr(cfg, in_out, out);
 
     in_out[0] = out[0].r;
     in_out[1] = out[n_ / 2].r;
@@ -77,7 +128,8 @@ class Rfft::RfftImpl {
   }
 
   void Reverse(float *in_out) const {
-    std::vector<kiss_fft_cpx> out(n_ / 2 + 1);
+    KissFftrPlans &plans = GetKissFftrPlans();
+    kiss_fft_cpx *out = plans.GetBuffer(n_ / 2 + 1);
     out[0].r = in_out[0];
     out[0].i = 0;
 
@@ -89,11 +141,9 @@ class Rfft::RfftImpl {
       out[i].i = in_out[2 * i + 1];
     }
 
-    kiss_fftr_cfg cfg = kiss_fftr_alloc(n_, 1, nullptr, nullptr);
-
-    kiss_fftri(cfg, out.data(), in_out);
+    kiss_fftr_cfg cfg = plans.Get(n_, true);
 
-    kiss_fftr_free(cfg);
+    kiss_fftri(cfg, out, in_out);
   }
 
  private:
@@ -106,6 +156,16 @@ Rfft::Rfft(int32_t n, bool inverse /*=false*/)
 
 Rfft::~Rfft() = default;
 
+Rfft::Rfft(const Rfft &other)
+    : impl_(std::make_unique<RfftImpl>(*other.impl_)) {}
+
+Rfft &Rfft::operator=(const Rfft &other) {
+  if (this != &other) {
+    impl_ = std::make_unique<RfftImpl>(*other.impl_);
+  }
+  return *this;
+}
+
 void Rfft::Compute(float *in_out) { impl_->Compute(in_out); }
 void Rfft::Compute(double *in_out) { impl_->Compute(in_out); }
 
@@ -35,6 +35,12 @@ class Rfft {
   explicit Rfft(int32_t n, bool inverse = false);
   ~Rfft();
 
+  // Copying is cheap. The FFT plan is not owned by an Rfft instance;
+  // it is computed once per thread and shared by all instances of the
+  // same size on that thread.
+  Rfft(const Rfft &other);
+  Rfft &operator=(const Rfft &other);
+
   /** @param in_out A 1-D array of size n.
    *             On return:
    *               in_out[0] = R[0]
@@ -0,0 +1,102 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_SHARED_CACHE_H_
+#define KALDI_NATIVE_FBANK_CSRC_SHARED_CACHE_H_
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>  // NOLINT
+#include <utility>
+
+namespace knf {
+
+// A thread-safe cache of immutable objects of type T, e.g., the mel banks
+// or the window tables, so that all users with the same config share a
+// single instance.
+//
+// The cache does not own the objects. An entry is freed as soon as the last
+// user of it is destroyed.
+//
+// A cache should be created with new and never deleted, so that it is
+// still valid in the destructors of static objects, e.g.,
+//
+//   static auto *cache = new SharedCache<Key, T>;
+template <typename Key, typename T>
+class SharedCache {
+ public:
+  // Return the object for the key. If it is not in the cache, it is
+  // created by create(), which returns a std::shared_ptr<const T>.
+  // create() is called without holding the lock since it may be slow.
+  template <typename F>
+  std::shared_ptr<const T> Get(const Key &key, F &&create) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto iter = entries_.find(key);
+      if (iter != entries_.end()) {
+        auto ans = iter->second.lock();
+        if (ans) {
+          return ans;
+        }
+      }
+    }
+
+    std::shared_ptr<const T> obj = std::forward<F>(create)();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Another thread may have created it in the meantime.
+    auto &entry = entries_[key];
+    auto ans = entry.lock();
+    if (ans) {
+      return ans;
+    }
+    entry = obj;
+
+    // Remove entries that are no longer used
+    for (auto iter = entries_.begin(); iter != entries_.end();) {
+      if (iter->second.expired()) {
+        iter = entries_.erase(iter);
+      } else {
+        ++iter;
+      }
+    }
+
+    return obj;
+  }
+
+  // Return the number of objects in the cache that are still being used.
+  int32_t Size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    int32_t ans = 0;
+    for (const auto &p : entries_) {
+      ans += !p.second.expired();
+    }
+    return ans;
+  }
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<Key, std::weak_ptr<const T>> entries_;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_SHARED_CACHE_H_
@@ -0,0 +1,1709 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if KNF_SIMD_X86
+#include <immintrin.h>
+#endif
+
+#if KNF_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+namespace knf {
+
+namespace {
+
+// The scalar kernels are the reference implementations. Their results are
+// identical to the loops they replace.
+
+float InnerProductScalar(const float *a, const float *b, int32_t n) {
+  float sum = 0;
+  for (int32_t i = 0; i != n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+float SumScalar(const float *x, int32_t n) {
+  float sum = 0;
+  for (int32_t i = 0; i != n; ++i) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+void AddScalarScalar(float c, float *x, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    x[i] += c;
+  }
+}
+
+void MultiplyScalar(const float *w, float *x, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    x[i] *= w[i];
+  }
+}
+
+void AxpyScalar(float a, const float *x, float *y, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    y[i] += a * x[i];
+  }
+}
+
+void SqrtScalar(float *x, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    x[i] = std::sqrt(x[i]);
+  }
+}
+
+void LogScalar(float floor, float *x, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    x[i] = std::log(std::max(x[i], floor));
+  }
+}
+
+// Constants for log_fast, which follows the range reduction of logf() of
+// Cephes.
+//
+// x is written as 2^e * m with sqrt(0.5) <= m < sqrt(2), and
+// log(x) = e * log(2) + log(1 + t) with t = m - 1. log(2) is split into a
+// high part, which is exact in float, and a low part.
+constexpr float kLogSqrtHalf = 0.707106781186547524f;
+constexpr float kLogLn2Hi = 0.693359375f;
+constexpr float kLogLn2Lo = -2.12194440e-4f;
+
+// log(1 + t) is approximated by t * Q(t), where Q(t) is
+// the Chebyshev interpolant of log(1 + t) / t of degree 4 on
+// [sqrt(0.5) - 1, sqrt(2) - 1]. Its absolute error is less than 2e-5.
+constexpr float kLogFastQ[5] = {
+    1.73486315e-1f, -2.70102283e-1f, 3.36687816e-1f,
+    -4.99502109e-1f, 9.99962170e-1f,
+};
+
+// For gauss, cos(t) and sin(t) / t for -pi <= t <= pi are approximated by
+// polynomials of degree 4 in t^2, which are Chebyshev interpolants on
+// [0, pi^2]. Their absolute errors are less than 5e-5 and 2e-5.
+constexpr float kCosP[5] = {
+    1.87708309e-5f, -1.33885088e-3f, 4.14934584e-2f,
+    -4.99788066e-1f, 9.99958232e-1f,
+};
+constexpr float kSinP[5] = {
+    2.19729638e-6f, -1.93749518e-4f, 8.31714416e-3f,
+    -1.66646831e-1f, 9.99996090e-1f,
+};
+constexpr float kPi = 3.14159265358979323846f;
+constexpr float kTwoPi = 6.28318530717958647692f;
+
+// The scalar versions of the fast kernels use the same operations in the
+// same order as the SIMD versions, so that the results are identical.
+
+// x must be a positive normal number
+inline float LogFast(float x) {
+  uint32_t i;
+  std::memcpy(&i, &x, sizeof(i));
+
+  // x = 2^e * m with 0.5 <= m < 1
+  float e = static_cast<float>(static_cast<int32_t>(i >> 23) - 126);
+  i = (i & 0x007fffff) | 0x3f000000;
+  float m;
+  std::memcpy(&m, &i, sizeof(m));
+
+  // If m < sqrt(0.5), use 2^(e-1) * 2m instead. t = m - 1
+  float t = m - 1.0f;
+  if (m < kLogSqrtHalf) {
+    e = e - 1.0f;
+    t = t + m;
+  }
+
+  float y = kLogFastQ[0];
+  for (int32_t k = 1; k != 5; ++k) {
+    y = y * t + kLogFastQ[k];
+  }
+  y = y * t;
+  y = y + e * kLogLn2Lo;
+  return y + e * kLogLn2Hi;
+}
+
+void LogFastScalar(float floor, float *x, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    x[i] = LogFast(std::max(x[i], floor));
+  }
+}
+
+inline void Gauss(float u1, float u2, float *c, float *s) {
+  float r = std::sqrt(LogFast(u1) * -2.0f);
+  float t = u2 * kTwoPi - kPi;
+  float t2 = t * t;
+
+  float y = kCosP[0];
+  float z = kSinP[0];
+  for (int32_t k = 1; k != 5; ++k) {
+    y = y * t2 + kCosP[k];
+    z = z * t2 + kSinP[k];
+  }
+  *c = r * y;
+  *s = r * (z * t);
+}
+
+void GaussScalar(const float *u1, const float *u2, float *out, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    Gauss(u1[i], u2[i], out + i, out + n + i);
+  }
+}
+
+void ComplexSquaredNormScalar(const float *in, float *out, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    float real = in[2 * i];
+    float im = in[2 * i + 1];
+    out[i] = real * real + im * im;
+  }
+}
+
+template <typename T>
+void ToFloatScalar(const T *in, float scale, float *out, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    out[i] = static_cast<float>(in[i]) * scale;
+  }
+}
+
+// Process x[i] for 0 <= i < end, from end - 1 down to 0, so that it can
+// be done in place. It is also used for the remaining samples of the
+// SIMD versions, which process blocks from the end of x.
+void PreemphasizeAndWindowTail(const float *w, float mean, float coeff,
+                               float *x, int32_t end) {
+  for (int32_t i = end - 1; i > 0; --i) {
+    float y = x[i] - mean;
+    float prev = x[i - 1] - mean;
+    x[i] = (y - coeff * prev) * w[i];
+  }
+
+  float y = x[0] - mean;
+  x[0] = (y - coeff * y) * w[0];
+}
+
+void PreemphasizeAndWindowScalar(const float *w, float mean, float coeff,
+                                 float *x, int32_t n) {
+  if (n > 0) {
+    PreemphasizeAndWindowTail(w, mean, coeff, x, n);
+  }
+}
+
+inline float PiecewiseUint8ToFloat(uint8_t v, const float *base,
+                                   const float *scale, const float *offset) {
+  int32_t k = v <= 64 ? 0 : (v <= 192 ? 1 : 2);
+  return base[k] + scale[k] * (static_cast<float>(v) - offset[k]);
+}
+
+void PiecewiseUint8ToFloatScalar(const uint8_t *in, const float *base,
+                                 const float *scale, const float *offset,
+                                 float *out, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    out[i] = PiecewiseUint8ToFloat(in[i], base, scale, offset);
+  }
+}
+
+inline uint16_t FloatToHalf(float f) {
+  uint32_t x;
+  memcpy(&x, &f, sizeof(x));
+  uint32_t sign = (x >> 16) & 0x8000;
+  uint32_t abs = x & 0x7fffffff;
+
+  if (abs > 0x7f800000) {
+    // NaN. It is quieted and its payload is truncated like F16C does.
+    return sign | 0x7e00 | ((abs >> 13) & 0x3ff);
+  }
+
+  if (abs >= 0x477ff000) {
+    // Not less than 65520, which is rounded to inf
+    return sign | 0x7c00;
+  }
+
+  if (abs < 0x38800000) {
+    // Less than 2^-14, i.e., a subnormal half or 0
+    if (abs < 0x33000000) {
+      return sign;  // Not larger than 2^-25, which is rounded to 0
+    }
+
+    uint32_t e = abs >> 23;
+    uint32_t m = (abs & 0x7fffff) | 0x800000;
+    int32_t shift = 126 - e;
+    uint32_t ans = m >> shift;
+    uint32_t rem = m & ((1u << shift) - 1);
+    uint32_t half = 1u << (shift - 1);
+    ans += (rem > half || (rem == half && (ans & 1)));
+    return sign | ans;
+  }
+
+  // Rebias the exponent from 127 to 15 and round to nearest even
+  uint32_t r = abs - 0x38000000;
+  return sign | ((r + 0xfff + ((r >> 13) & 1)) >> 13);
+}
+
+void FloatToHalfScalar(const float *in, uint16_t *out, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    out[i] = FloatToHalf(in[i]);
+  }
+}
+
+inline uint16_t FloatToBFloat16(float f) {
+  uint32_t x;
+  memcpy(&x, &f, sizeof(x));
+  if ((x & 0x7fffffff) > 0x7f800000) {
+    return (x >> 16) | 0x40;  // keep NaN a quiet NaN
+  }
+  return (x + 0x7fff + ((x >> 16) & 1)) >> 16;
+}
+
+void FloatToBFloat16Scalar(const float *in, uint16_t *out, int32_t n) {
+  for (int32_t i = 0; i != n; ++i) {
+    out[i] = FloatToBFloat16(in[i]);
+  }
+}
+
+constexpr SimdKernels kScalarKernels = {
+    InnerProductScalar,       SumScalar,
+    AddScalarScalar,          MultiplyScalar,
+    SqrtScalar,               LogScalar,
+    LogFastScalar,            ComplexSquaredNormScalar,
+    ToFloatScalar<int16_t>,   ToFloatScalar<int32_t>,
+    ToFloatScalar<double>,    PreemphasizeAndWindowScalar,
+    GaussScalar,              PiecewiseUint8ToFloatScalar,
+    FloatToHalfScalar,        FloatToBFloat16Scalar,
+    AxpyScalar,
+};
+
+#if KNF_SIMD_X86
+
+// Note: Element-wise kernels use a separate multiply and add instead of FMA
+// so that they give the same results as the scalar kernels. This file is
+// compiled with -ffp-contract=off so that the compiler does not fuse them
+// either. Only the reductions, i.e., inner_product and sum, may differ in
+// rounding.
+
+#define KNF_TARGET_SSE2 __attribute__((target("sse2")))
+#define KNF_TARGET_AVX2 __attribute__((target("avx2,fma,f16c")))
+#define KNF_TARGET_AVX512 __attribute__((target("avx512f")))
+
+// SSE2
+
+KNF_TARGET_SSE2 inline float HorizontalSumSse2(__m128 v) {
+  __m128 t = _mm_add_ps(v, _mm_movehl_ps(v, v));
+  t = _mm_add_ss(t, _mm_shuffle_ps(t, t, 1));
+  return _mm_cvtss_f32(t);
+}
+
+KNF_TARGET_SSE2 float InnerProductSse2(const float *a, const float *b,
+                                       int32_t n) {
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 =
+        _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    acc1 = _mm_add_ps(
+        acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+  }
+  float sum = HorizontalSumSse2(_mm_add_ps(acc0, acc1));
+  for (; i != n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+KNF_TARGET_SSE2 float SumSse2(const float *x, int32_t n) {
+  __m128 acc0 = _mm_setzero_ps();
+  __m128 acc1 = _mm_setzero_ps();
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm_add_ps(acc0, _mm_loadu_ps(x + i));
+    acc1 = _mm_add_ps(acc1, _mm_loadu_ps(x + i + 4));
+  }
+  float sum = HorizontalSumSse2(_mm_add_ps(acc0, acc1));
+  for (; i != n; ++i) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+KNF_TARGET_SSE2 void AddScalarSse2(float c, float *x, int32_t n) {
+  __m128 vc = _mm_set1_ps(c);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), vc));
+  }
+  for (; i != n; ++i) {
+    x[i] += c;
+  }
+}
+
+KNF_TARGET_SSE2 void MultiplySse2(const float *w, float *x, int32_t n) {
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(x + i, _mm_mul_ps(_mm_loadu_ps(x + i), _mm_loadu_ps(w + i)));
+  }
+  for (; i != n; ++i) {
+    x[i] *= w[i];
+  }
+}
+
+KNF_TARGET_SSE2 void AxpySse2(float a, const float *x, float *y,
+                              int32_t n) {
+  __m128 va = _mm_set1_ps(a);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 p = _mm_mul_ps(va, _mm_loadu_ps(x + i));
+    _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), p));
+  }
+  for (; i != n; ++i) {
+    y[i] += a * x[i];
+  }
+}
+
+KNF_TARGET_SSE2 void SqrtSse2(float *x, int32_t n) {
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(x + i, _mm_sqrt_ps(_mm_loadu_ps(x + i)));
+  }
+  for (; i != n; ++i) {
+    x[i] = std::sqrt(x[i]);
+  }
+}
+
+// Write 4 positive normal numbers x as 2^e * (1 + t) with
+// sqrt(0.5) <= 1 + t < sqrt(2)
+KNF_TARGET_SSE2 inline void LogSplitSse2(__m128 x, __m128 *e, __m128 *t) {
+  const __m128 one = _mm_set1_ps(1.0f);
+  __m128i i = _mm_castps_si128(x);
+
+  // x = 2^e * m with 0.5 <= m < 1
+  *e = _mm_cvtepi32_ps(
+      _mm_sub_epi32(_mm_srli_epi32(i, 23), _mm_set1_epi32(126)));
+  __m128 m = _mm_castsi128_ps(
+      _mm_or_si128(_mm_and_si128(i, _mm_set1_epi32(0x007fffff)),
+                   _mm_set1_epi32(0x3f000000)));
+
+  // If m < sqrt(0.5), use 2^(e-1) * 2m instead
+  __m128 mask = _mm_cmplt_ps(m, _mm_set1_ps(kLogSqrtHalf));
+  *e = _mm_sub_ps(*e, _mm_and_ps(mask, one));
+  *t = _mm_add_ps(_mm_sub_ps(m, one), _mm_and_ps(mask, m));
+}
+
+// See LogFast()
+KNF_TARGET_SSE2 inline __m128 LogFastSse2(__m128 x) {
+  __m128 e;
+  __m128 t;
+  LogSplitSse2(x, &e, &t);
+
+  __m128 y = _mm_set1_ps(kLogFastQ[0]);
+  for (int32_t k = 1; k != 5; ++k) {
+    y = _mm_add_ps(_mm_mul_ps(y, t), _mm_set1_ps(kLogFastQ[k]));
+  }
+  y = _mm_mul_ps(y, t);
+  y = _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(kLogLn2Lo)));
+  return _mm_add_ps(y, _mm_mul_ps(e, _mm_set1_ps(kLogLn2Hi)));
+}
+
+KNF_TARGET_SSE2 void LogFastSse2(float floor, float *x, int32_t n) {
+  __m128 f = _mm_set1_ps(floor);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm_storeu_ps(x + i, LogFastSse2(_mm_max_ps(_mm_loadu_ps(x + i), f)));
+  }
+  LogFastScalar(floor, x + i, n - i);
+}
+
+KNF_TARGET_SSE2 void GaussSse2(const float *u1, const float *u2, float *out,
+                               int32_t n) {
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 r = _mm_sqrt_ps(_mm_mul_ps(LogFastSse2(_mm_loadu_ps(u1 + i)),
+                                      _mm_set1_ps(-2.0f)));
+    __m128 t = _mm_sub_ps(_mm_mul_ps(_mm_loadu_ps(u2 + i),
+                                     _mm_set1_ps(kTwoPi)),
+                          _mm_set1_ps(kPi));
+    __m128 t2 = _mm_mul_ps(t, t);
+
+    __m128 y = _mm_set1_ps(kCosP[0]);
+    __m128 z = _mm_set1_ps(kSinP[0]);
+    for (int32_t k = 1; k != 5; ++k) {
+      y = _mm_add_ps(_mm_mul_ps(y, t2), _mm_set1_ps(kCosP[k]));
+      z = _mm_add_ps(_mm_mul_ps(z, t2), _mm_set1_ps(kSinP[k]));
+    }
+    _mm_storeu_ps(out + i, _mm_mul_ps(r, y));
+    _mm_storeu_ps(out + n + i, _mm_mul_ps(r, _mm_mul_ps(z, t)));
+  }
+  for (; i != n; ++i) {
+    Gauss(u1[i], u2[i], out + i, out + n + i);
+  }
+}
+
+KNF_TARGET_SSE2 void ComplexSquaredNormSse2(const float *in, float *out,
+                                            int32_t n) {
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 a = _mm_loadu_ps(in + 2 * i);
+    __m128 b = _mm_loadu_ps(in + 2 * i + 4);
+    a = _mm_mul_ps(a, a);
+    b = _mm_mul_ps(b, b);
+    __m128 real = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 im = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm_storeu_ps(out + i, _mm_add_ps(real, im));
+  }
+  for (; i != n; ++i) {
+    float real = in[2 * i];
+    float im = in[2 * i + 1];
+    out[i] = real * real + im * im;
+  }
+}
+
+KNF_TARGET_SSE2 void Int16ToFloatSse2(const int16_t *in, float scale,
+                                      float *out, int32_t n) {
+  __m128 vs = _mm_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    // sign extension to int32
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(v, v), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(v, v), 16);
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), vs));
+    _mm_storeu_ps(out + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_SSE2 void Int32ToFloatSse2(const int32_t *in, float scale,
+                                      float *out, int32_t n) {
+  __m128 vs = _mm_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_cvtepi32_ps(v), vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_SSE2 void DoubleToFloatSse2(const double *in, float scale,
+                                       float *out, int32_t n) {
+  __m128 vs = _mm_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(in + i));
+    __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(in + i + 2));
+    _mm_storeu_ps(out + i, _mm_mul_ps(_mm_movelh_ps(lo, hi), vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_SSE2 void PreemphasizeAndWindowSse2(const float *w, float mean,
+                                               float coeff, float *x,
+                                               int32_t n) {
+  if (n == 0) {
+    return;
+  }
+
+  __m128 vm = _mm_set1_ps(mean);
+  __m128 vc = _mm_set1_ps(coeff);
+  int32_t i = n;
+  while (i - 4 >= 1) {
+    i -= 4;
+    __m128 y = _mm_sub_ps(_mm_loadu_ps(x + i), vm);
+    __m128 prev = _mm_sub_ps(_mm_loadu_ps(x + i - 1), vm);
+    y = _mm_sub_ps(y, _mm_mul_ps(vc, prev));
+    _mm_storeu_ps(x + i, _mm_mul_ps(y, _mm_loadu_ps(w + i)));
+  }
+  PreemphasizeAndWindowTail(w, mean, coeff, x, i);
+}
+
+// Return b if mask is set, else a
+KNF_TARGET_SSE2 inline __m128 SelectSse2(__m128 mask, __m128 a, __m128 b) {
+  return _mm_or_ps(_mm_andnot_ps(mask, a), _mm_and_ps(mask, b));
+}
+
+KNF_TARGET_SSE2 void PiecewiseUint8ToFloatSse2(const uint8_t *in,
+                                               const float *base,
+                                               const float *scale,
+                                               const float *offset,
+                                               float *out, int32_t n) {
+  __m128 b0 = _mm_set1_ps(base[0]);
+  __m128 b1 = _mm_set1_ps(base[1]);
+  __m128 b2 = _mm_set1_ps(base[2]);
+  __m128 s0 = _mm_set1_ps(scale[0]);
+  __m128 s1 = _mm_set1_ps(scale[1]);
+  __m128 s2 = _mm_set1_ps(scale[2]);
+  __m128 o0 = _mm_set1_ps(offset[0]);
+  __m128 o1 = _mm_set1_ps(offset[1]);
+  __m128 o2 = _mm_set1_ps(offset[2]);
+  __m128 t1 = _mm_set1_ps(64);
+  __m128 t2 = _mm_set1_ps(192);
+  __m128i zero = _mm_setzero_si128();
+
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    __m128i lo = _mm_unpacklo_epi8(v, zero);
+    __m128i hi = _mm_unpackhi_epi8(v, zero);
+    __m128i w[4] = {
+        _mm_unpacklo_epi16(lo, zero), _mm_unpackhi_epi16(lo, zero),
+        _mm_unpacklo_epi16(hi, zero), _mm_unpackhi_epi16(hi, zero)};
+
+    for (int32_t k = 0; k != 4; ++k) {
+      __m128 f = _mm_cvtepi32_ps(w[k]);
+      __m128 m1 = _mm_cmpgt_ps(f, t1);
+      __m128 m2 = _mm_cmpgt_ps(f, t2);
+      __m128 b = SelectSse2(m2, SelectSse2(m1, b0, b1), b2);
+      __m128 s = SelectSse2(m2, SelectSse2(m1, s0, s1), s2);
+      __m128 o = SelectSse2(m2, SelectSse2(m1, o0, o1), o2);
+      _mm_storeu_ps(out + i + 4 * k,
+                    _mm_add_ps(b, _mm_mul_ps(s, _mm_sub_ps(f, o))));
+    }
+  }
+  PiecewiseUint8ToFloatScalar(in + i, base, scale, offset, out + i, n - i);
+}
+
+// Rounded bfloat16 in the lower 16 bits of each lane
+KNF_TARGET_SSE2 inline __m128i FloatToBFloat16Sse2(__m128i x) {
+  __m128i lsb = _mm_and_si128(_mm_srli_epi32(x, 16), _mm_set1_epi32(1));
+  __m128i r = _mm_add_epi32(_mm_add_epi32(x, _mm_set1_epi32(0x7fff)), lsb);
+  __m128i q = _mm_or_si128(x, _mm_set1_epi32(0x400000));
+  __m128i nan = _mm_cmpgt_epi32(_mm_and_si128(x, _mm_set1_epi32(0x7fffffff)),
+                                _mm_set1_epi32(0x7f800000));
+  r = _mm_or_si128(_mm_and_si128(nan, q), _mm_andnot_si128(nan, r));
+  return _mm_srli_epi32(r, 16);
+}
+
+KNF_TARGET_SSE2 void FloatToBFloat16Sse2(const float *in, uint16_t *out,
+                                         int32_t n) {
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i a = FloatToBFloat16Sse2(_mm_castps_si128(_mm_loadu_ps(in + i)));
+    __m128i b =
+        FloatToBFloat16Sse2(_mm_castps_si128(_mm_loadu_ps(in + i + 4)));
+    // Sign-extend the lower 16 bits so that the signed saturation of
+    // _mm_packs_epi32() keeps them unchanged
+    a = _mm_srai_epi32(_mm_slli_epi32(a, 16), 16);
+    b = _mm_srai_epi32(_mm_slli_epi32(b, 16), 16);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i),
+                     _mm_packs_epi32(a, b));
+  }
+  FloatToBFloat16Scalar(in + i, out + i, n - i);
+}
+
+constexpr SimdKernels kSse2Kernels = {
+    InnerProductSse2,          SumSse2,
+    AddScalarSse2,             MultiplySse2,
+    SqrtSse2,                  LogScalar,
+    LogFastSse2,               ComplexSquaredNormSse2,
+    Int16ToFloatSse2,          Int32ToFloatSse2,
+    DoubleToFloatSse2,         PreemphasizeAndWindowSse2,
+    GaussSse2,                 PiecewiseUint8ToFloatSse2,
+    FloatToHalfScalar,         FloatToBFloat16Sse2,
+    AxpySse2,
+};
+
+// AVX2
+
+KNF_TARGET_AVX2 inline float HorizontalSumAvx2(__m256 v) {
+  __m128 t = _mm_add_ps(_mm256_castps256_ps128(v), _mm256_extractf128_ps(v, 1));
+  t = _mm_add_ps(t, _mm_movehl_ps(t, t));
+  t = _mm_add_ss(t, _mm_shuffle_ps(t, t, 1));
+  return _mm_cvtss_f32(t);
+}
+
+KNF_TARGET_AVX2 float InnerProductAvx2(const float *a, const float *b,
+                                       int32_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    acc0 =
+        _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8),
+                           _mm256_loadu_ps(b + i + 8), acc1);
+  }
+  for (; i + 8 <= n; i += 8) {
+    acc0 =
+        _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+  }
+  float sum = HorizontalSumAvx2(_mm256_add_ps(acc0, acc1));
+  for (; i != n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+KNF_TARGET_AVX2 float SumAvx2(const float *x, int32_t n) {
+  __m256 acc0 = _mm256_setzero_ps();
+  __m256 acc1 = _mm256_setzero_ps();
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(x + i));
+    acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(x + i + 8));
+  }
+  for (; i + 8 <= n; i += 8) {
+    acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(x + i));
+  }
+  float sum = HorizontalSumAvx2(_mm256_add_ps(acc0, acc1));
+  for (; i != n; ++i) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+KNF_TARGET_AVX2 void AddScalarAvx2(float c, float *x, int32_t n) {
+  __m256 vc = _mm256_set1_ps(c);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(x + i, _mm256_add_ps(_mm256_loadu_ps(x + i), vc));
+  }
+  for (; i != n; ++i) {
+    x[i] += c;
+  }
+}
+
+KNF_TARGET_AVX2 void MultiplyAvx2(const float *w, float *x, int32_t n) {
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(
+        x + i, _mm256_mul_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(w + i)));
+  }
+  for (; i != n; ++i) {
+    x[i] *= w[i];
+  }
+}
+
+KNF_TARGET_AVX2 void AxpyAvx2(float a, const float *x, float *y,
+                              int32_t n) {
+  __m256 va = _mm256_set1_ps(a);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 p = _mm256_mul_ps(va, _mm256_loadu_ps(x + i));
+    _mm256_storeu_ps(y + i, _mm256_add_ps(_mm256_loadu_ps(y + i), p));
+  }
+  for (; i != n; ++i) {
+    y[i] += a * x[i];
+  }
+}
+
+KNF_TARGET_AVX2 void SqrtAvx2(float *x, int32_t n) {
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(x + i, _mm256_sqrt_ps(_mm256_loadu_ps(x + i)));
+  }
+  for (; i != n; ++i) {
+    x[i] = std::sqrt(x[i]);
+  }
+}
+
+// See LogSplitSse2()
+KNF_TARGET_AVX2 inline void LogSplitAvx2(__m256 x, __m256 *e, __m256 *t) {
+  const __m256 one = _mm256_set1_ps(1.0f);
+  __m256i i = _mm256_castps_si256(x);
+
+  *e = _mm256_cvtepi32_ps(
+      _mm256_sub_epi32(_mm256_srli_epi32(i, 23), _mm256_set1_epi32(126)));
+  __m256 m = _mm256_castsi256_ps(
+      _mm256_or_si256(_mm256_and_si256(i, _mm256_set1_epi32(0x007fffff)),
+                      _mm256_set1_epi32(0x3f000000)));
+
+  __m256 mask = _mm256_cmp_ps(m, _mm256_set1_ps(kLogSqrtHalf), _CMP_LT_OQ);
+  *e = _mm256_sub_ps(*e, _mm256_and_ps(mask, one));
+  *t = _mm256_add_ps(_mm256_sub_ps(m, one), _mm256_and_ps(mask, m));
+}
+
+// See LogFast()
+KNF_TARGET_AVX2 inline __m256 LogFastAvx2(__m256 x) {
+  __m256 e;
+  __m256 t;
+  LogSplitAvx2(x, &e, &t);
+
+  __m256 y = _mm256_set1_ps(kLogFastQ[0]);
+  for (int32_t k = 1; k != 5; ++k) {
+    y = _mm256_add_ps(_mm256_mul_ps(y, t), _mm256_set1_ps(kLogFastQ[k]));
+  }
+  y = _mm256_mul_ps(y, t);
+  y = _mm256_add_ps(y, _mm256_mul_ps(e, _mm256_set1_ps(kLogLn2Lo)));
+  return _mm256_add_ps(y, _mm256_mul_ps(e, _mm256_set1_ps(kLogLn2Hi)));
+}
+
+KNF_TARGET_AVX2 void LogFastAvx2(float floor, float *x, int32_t n) {
+  __m256 f = _mm256_set1_ps(floor);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm256_storeu_ps(x + i,
+                     LogFastAvx2(_mm256_max_ps(_mm256_loadu_ps(x + i), f)));
+  }
+  LogFastScalar(floor, x + i, n - i);
+}
+
+KNF_TARGET_AVX2 void GaussAvx2(const float *u1, const float *u2, float *out,
+                               int32_t n) {
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 r = _mm256_sqrt_ps(_mm256_mul_ps(
+        LogFastAvx2(_mm256_loadu_ps(u1 + i)), _mm256_set1_ps(-2.0f)));
+    __m256 t = _mm256_sub_ps(
+        _mm256_mul_ps(_mm256_loadu_ps(u2 + i), _mm256_set1_ps(kTwoPi)),
+        _mm256_set1_ps(kPi));
+    __m256 t2 = _mm256_mul_ps(t, t);
+
+    __m256 y = _mm256_set1_ps(kCosP[0]);
+    __m256 z = _mm256_set1_ps(kSinP[0]);
+    for (int32_t k = 1; k != 5; ++k) {
+      y = _mm256_add_ps(_mm256_mul_ps(y, t2), _mm256_set1_ps(kCosP[k]));
+      z = _mm256_add_ps(_mm256_mul_ps(z, t2), _mm256_set1_ps(kSinP[k]));
+    }
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(r, y));
+    _mm256_storeu_ps(out + n + i, _mm256_mul_ps(r, _mm256_mul_ps(z, t)));
+  }
+  for (; i != n; ++i) {
+    Gauss(u1[i], u2[i], out + i, out + n + i);
+  }
+}
+
+KNF_TARGET_AVX2 void ComplexSquaredNormAvx2(const float *in, float *out,
+                                            int32_t n) {
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 a = _mm256_loadu_ps(in + 2 * i);
+    __m256 b = _mm256_loadu_ps(in + 2 * i + 8);
+    a = _mm256_mul_ps(a, a);
+    b = _mm256_mul_ps(b, b);
+    // [a01, a23, b01, b23 | a45, a67, b45, b67]
+    __m256 s = _mm256_hadd_ps(a, b);
+    s = _mm256_castpd_ps(
+        _mm256_permute4x64_pd(_mm256_castps_pd(s), _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm256_storeu_ps(out + i, s);
+  }
+  for (; i != n; ++i) {
+    float real = in[2 * i];
+    float im = in[2 * i + 1];
+    out[i] = real * real + im * im;
+  }
+}
+
+KNF_TARGET_AVX2 void Int16ToFloatAvx2(const int16_t *in, float scale,
+                                      float *out, int32_t n) {
+  __m256 vs = _mm256_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepi16_epi32(v));
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(f, vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_AVX2 void Int32ToFloatAvx2(const int32_t *in, float scale,
+                                      float *out, int32_t n) {
+  __m256 vs = _mm256_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(_mm256_cvtepi32_ps(v), vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_AVX2 void DoubleToFloatAvx2(const double *in, float scale,
+                                       float *out, int32_t n) {
+  __m256 vs = _mm256_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128 lo = _mm256_cvtpd_ps(_mm256_loadu_pd(in + i));
+    __m128 hi = _mm256_cvtpd_ps(_mm256_loadu_pd(in + i + 4));
+    __m256 f = _mm256_insertf128_ps(_mm256_castps128_ps256(lo), hi, 1);
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(f, vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_AVX2 void PreemphasizeAndWindowAvx2(const float *w, float mean,
+                                               float coeff, float *x,
+                                               int32_t n) {
+  if (n == 0) {
+    return;
+  }
+
+  __m256 vm = _mm256_set1_ps(mean);
+  __m256 vc = _mm256_set1_ps(coeff);
+  int32_t i = n;
+  while (i - 8 >= 1) {
+    i -= 8;
+    __m256 y = _mm256_sub_ps(_mm256_loadu_ps(x + i), vm);
+    __m256 prev = _mm256_sub_ps(_mm256_loadu_ps(x + i - 1), vm);
+    y = _mm256_sub_ps(y, _mm256_mul_ps(vc, prev));
+    _mm256_storeu_ps(x + i, _mm256_mul_ps(y, _mm256_loadu_ps(w + i)));
+  }
+  PreemphasizeAndWindowTail(w, mean, coeff, x, i);
+}
+
+KNF_TARGET_AVX2 void PiecewiseUint8ToFloatAvx2(const uint8_t *in,
+                                               const float *base,
+                                               const float *scale,
+                                               const float *offset,
+                                               float *out, int32_t n) {
+  __m256 b0 = _mm256_set1_ps(base[0]);
+  __m256 b1 = _mm256_set1_ps(base[1]);
+  __m256 b2 = _mm256_set1_ps(base[2]);
+  __m256 s0 = _mm256_set1_ps(scale[0]);
+  __m256 s1 = _mm256_set1_ps(scale[1]);
+  __m256 s2 = _mm256_set1_ps(scale[2]);
+  __m256 o0 = _mm256_set1_ps(offset[0]);
+  __m256 o1 = _mm256_set1_ps(offset[1]);
+  __m256 o2 = _mm256_set1_ps(offset[2]);
+  __m256 t1 = _mm256_set1_ps(64);
+  __m256 t2 = _mm256_set1_ps(192);
+
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i v = _mm_loadl_epi64(reinterpret_cast<const __m128i *>(in + i));
+    __m256 f = _mm256_cvtepi32_ps(_mm256_cvtepu8_epi32(v));
+    __m256 m1 = _mm256_cmp_ps(f, t1, _CMP_GT_OQ);
+    __m256 m2 = _mm256_cmp_ps(f, t2, _CMP_GT_OQ);
+    __m256 b = _mm256_blendv_ps(_mm256_blendv_ps(b0, b1, m1), b2, m2);
+    __m256 s = _mm256_blendv_ps(_mm256_blendv_ps(s0, s1, m1), s2, m2);
+    __m256 o = _mm256_blendv_ps(_mm256_blendv_ps(o0, o1, m1), o2, m2);
+    _mm256_storeu_ps(out + i,
+                     _mm256_add_ps(b, _mm256_mul_ps(s, _mm256_sub_ps(f, o))));
+  }
+  PiecewiseUint8ToFloatScalar(in + i, base, scale, offset, out + i, n - i);
+}
+
+KNF_TARGET_AVX2 void FloatToHalfAvx2(const float *in, uint16_t *out,
+                                     int32_t n) {
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m128i h = _mm256_cvtps_ph(_mm256_loadu_ps(in + i),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), h);
+  }
+  FloatToHalfScalar(in + i, out + i, n - i);
+}
+
+// Rounded bfloat16 in the lower 16 bits of each lane
+KNF_TARGET_AVX2 inline __m256i FloatToBFloat16Avx2(__m256i x) {
+  __m256i lsb =
+      _mm256_and_si256(_mm256_srli_epi32(x, 16), _mm256_set1_epi32(1));
+  __m256i r =
+      _mm256_add_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(0x7fff)), lsb);
+  __m256i q = _mm256_or_si256(x, _mm256_set1_epi32(0x400000));
+  __m256i nan = _mm256_cmpgt_epi32(
+      _mm256_and_si256(x, _mm256_set1_epi32(0x7fffffff)),
+      _mm256_set1_epi32(0x7f800000));
+  return _mm256_srli_epi32(_mm256_blendv_epi8(r, q, nan), 16);
+}
+
+KNF_TARGET_AVX2 void FloatToBFloat16Avx2(const float *in, uint16_t *out,
+                                         int32_t n) {
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i a =
+        FloatToBFloat16Avx2(_mm256_castps_si256(_mm256_loadu_ps(in + i)));
+    __m256i b =
+        FloatToBFloat16Avx2(_mm256_castps_si256(_mm256_loadu_ps(in + i + 8)));
+    // The pack works within 128-bit lanes, so reorder the 64-bit blocks
+    __m256i r = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xd8);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), r);
+  }
+  FloatToBFloat16Scalar(in + i, out + i, n - i);
+}
+
+constexpr SimdKernels kAvx2Kernels = {
+    InnerProductAvx2,          SumAvx2,
+    AddScalarAvx2,             MultiplyAvx2,
+    SqrtAvx2,                  LogScalar,
+    LogFastAvx2,               ComplexSquaredNormAvx2,
+    Int16ToFloatAvx2,          Int32ToFloatAvx2,
+    DoubleToFloatAvx2,         PreemphasizeAndWindowAvx2,
+    GaussAvx2,                 PiecewiseUint8ToFloatAvx2,
+    FloatToHalfAvx2,           FloatToBFloat16Avx2,
+    AxpyAvx2,
+};
+
+// AVX-512. The tail is handled with masked loads and stores.
+
+// The headers of GCC 12 trigger false -Wuninitialized warnings with
+// _mm512_undefined_ps().
+// See https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105593
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+KNF_TARGET_AVX512 inline __mmask16 TailMask(int32_t n) {
+  return static_cast<__mmask16>((1u << n) - 1);
+}
+
+KNF_TARGET_AVX512 float InnerProductAvx512(const float *a, const float *b,
+                                           int32_t n) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  int32_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    acc0 =
+        _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+    acc1 = _mm512_fmadd_ps(_mm512_loadu_ps(a + i + 16),
+                           _mm512_loadu_ps(b + i + 16), acc1);
+  }
+  for (; i + 16 <= n; i += 16) {
+    acc0 =
+        _mm512_fmadd_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i), acc0);
+  }
+  if (i != n) {
+    __mmask16 m = TailMask(n - i);
+    acc1 = _mm512_fmadd_ps(_mm512_maskz_loadu_ps(m, a + i),
+                           _mm512_maskz_loadu_ps(m, b + i), acc1);
+  }
+  return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+KNF_TARGET_AVX512 float SumAvx512(const float *x, int32_t n) {
+  __m512 acc0 = _mm512_setzero_ps();
+  __m512 acc1 = _mm512_setzero_ps();
+  int32_t i = 0;
+  for (; i + 32 <= n; i += 32) {
+    acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(x + i));
+    acc1 = _mm512_add_ps(acc1, _mm512_loadu_ps(x + i + 16));
+  }
+  for (; i + 16 <= n; i += 16) {
+    acc0 = _mm512_add_ps(acc0, _mm512_loadu_ps(x + i));
+  }
+  if (i != n) {
+    acc1 = _mm512_add_ps(acc1, _mm512_maskz_loadu_ps(TailMask(n - i), x + i));
+  }
+  return _mm512_reduce_add_ps(_mm512_add_ps(acc0, acc1));
+}
+
+KNF_TARGET_AVX512 void AddScalarAvx512(float c, float *x, int32_t n) {
+  __m512 vc = _mm512_set1_ps(c);
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(x + i, _mm512_add_ps(_mm512_loadu_ps(x + i), vc));
+  }
+  if (i != n) {
+    __mmask16 m = TailMask(n - i);
+    _mm512_mask_storeu_ps(x + i, m,
+                          _mm512_add_ps(_mm512_maskz_loadu_ps(m, x + i), vc));
+  }
+}
+
+KNF_TARGET_AVX512 void MultiplyAvx512(const float *w, float *x, int32_t n) {
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(
+        x + i, _mm512_mul_ps(_mm512_loadu_ps(x + i), _mm512_loadu_ps(w + i)));
+  }
+  if (i != n) {
+    __mmask16 m = TailMask(n - i);
+    _mm512_mask_storeu_ps(x + i, m,
+                          _mm512_mul_ps(_mm512_maskz_loadu_ps(m, x + i),
+                                        _mm512_maskz_loadu_ps(m, w + i)));
+  }
+}
+
+KNF_TARGET_AVX512 void AxpyAvx512(float a, const float *x, float *y,
+                                  int32_t n) {
+  __m512 va = _mm512_set1_ps(a);
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 p = _mm512_mul_ps(va, _mm512_loadu_ps(x + i));
+    _mm512_storeu_ps(y + i, _mm512_add_ps(_mm512_loadu_ps(y + i), p));
+  }
+  if (i != n) {
+    __mmask16 m = TailMask(n - i);
+    __m512 p = _mm512_mul_ps(va, _mm512_maskz_loadu_ps(m, x + i));
+    _mm512_mask_storeu_ps(y + i, m,
+                          _mm512_add_ps(_mm512_maskz_loadu_ps(m, y + i), p));
+  }
+}
+
+KNF_TARGET_AVX512 void SqrtAvx512(float *x, int32_t n) {
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(x + i, _mm512_sqrt_ps(_mm512_loadu_ps(x + i)));
+  }
+  if (i != n) {
+    __mmask16 m = TailMask(n - i);
+    _mm512_mask_storeu_ps(x + i, m,
+                          _mm512_sqrt_ps(_mm512_maskz_loadu_ps(m, x + i)));
+  }
+}
+
+// See LogSplitSse2()
+KNF_TARGET_AVX512 inline void LogSplitAvx512(__m512 x, __m512 *e,
+                                             __m512 *t) {
+  const __m512 one = _mm512_set1_ps(1.0f);
+  __m512i i = _mm512_castps_si512(x);
+
+  *e = _mm512_cvtepi32_ps(
+      _mm512_sub_epi32(_mm512_srli_epi32(i, 23), _mm512_set1_epi32(126)));
+  __m512 m = _mm512_castsi512_ps(
+      _mm512_or_epi32(_mm512_and_epi32(i, _mm512_set1_epi32(0x007fffff)),
+                      _mm512_set1_epi32(0x3f000000)));
+
+  __mmask16 mask =
+      _mm512_cmp_ps_mask(m, _mm512_set1_ps(kLogSqrtHalf), _CMP_LT_OQ);
+  *e = _mm512_mask_sub_ps(*e, mask, *e, one);
+  *t = _mm512_sub_ps(m, one);
+  *t = _mm512_mask_add_ps(*t, mask, *t, m);
+}
+
+// See LogFast()
+KNF_TARGET_AVX512 inline __m512 LogFastAvx512(__m512 x) {
+  __m512 e;
+  __m512 t;
+  LogSplitAvx512(x, &e, &t);
+
+  __m512 y = _mm512_set1_ps(kLogFastQ[0]);
+  for (int32_t k = 1; k != 5; ++k) {
+    y = _mm512_add_ps(_mm512_mul_ps(y, t), _mm512_set1_ps(kLogFastQ[k]));
+  }
+  y = _mm512_mul_ps(y, t);
+  y = _mm512_add_ps(y, _mm512_mul_ps(e, _mm512_set1_ps(kLogLn2Lo)));
+  return _mm512_add_ps(y, _mm512_mul_ps(e, _mm512_set1_ps(kLogLn2Hi)));
+}
+
+KNF_TARGET_AVX512 void LogFastAvx512(float floor, float *x, int32_t n) {
+  __m512 f = _mm512_set1_ps(floor);
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    _mm512_storeu_ps(
+        x + i, LogFastAvx512(_mm512_max_ps(_mm512_loadu_ps(x + i), f)));
+  }
+  if (i != n) {
+    __mmask16 m = TailMask(n - i);
+    _mm512_mask_storeu_ps(
+        x + i, m,
+        LogFastAvx512(_mm512_max_ps(_mm512_maskz_loadu_ps(m, x + i), f)));
+  }
+}
+
+KNF_TARGET_AVX512 void GaussAvx512(const float *u1, const float *u2,
+                                   float *out, int32_t n) {
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 r = _mm512_sqrt_ps(_mm512_mul_ps(
+        LogFastAvx512(_mm512_loadu_ps(u1 + i)), _mm512_set1_ps(-2.0f)));
+    __m512 t = _mm512_sub_ps(
+        _mm512_mul_ps(_mm512_loadu_ps(u2 + i), _mm512_set1_ps(kTwoPi)),
+        _mm512_set1_ps(kPi));
+    __m512 t2 = _mm512_mul_ps(t, t);
+
+    __m512 y = _mm512_set1_ps(kCosP[0]);
+    __m512 z = _mm512_set1_ps(kSinP[0]);
+    for (int32_t k = 1; k != 5; ++k) {
+      y = _mm512_add_ps(_mm512_mul_ps(y, t2), _mm512_set1_ps(kCosP[k]));
+      z = _mm512_add_ps(_mm512_mul_ps(z, t2), _mm512_set1_ps(kSinP[k]));
+    }
+    _mm512_storeu_ps(out + i, _mm512_mul_ps(r, y));
+    _mm512_storeu_ps(out + n + i, _mm512_mul_ps(r, _mm512_mul_ps(z, t)));
+  }
+  for (; i != n; ++i) {
+    Gauss(u1[i], u2[i], out + i, out + n + i);
+  }
+}
+
+KNF_TARGET_AVX512 void ComplexSquaredNormAvx512(const float *in, float *out,
+                                                int32_t n) {
+  const __m512i even = _mm512_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14, 16, 18,
+                                         20, 22, 24, 26, 28, 30);
+  const __m512i odd = _mm512_setr_epi32(1, 3, 5, 7, 9, 11, 13, 15, 17, 19, 21,
+                                        23, 25, 27, 29, 31);
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512 a = _mm512_loadu_ps(in + 2 * i);
+    __m512 b = _mm512_loadu_ps(in + 2 * i + 16);
+    a = _mm512_mul_ps(a, a);
+    b = _mm512_mul_ps(b, b);
+    __m512 real = _mm512_permutex2var_ps(a, even, b);
+    __m512 im = _mm512_permutex2var_ps(a, odd, b);
+    _mm512_storeu_ps(out + i, _mm512_add_ps(real, im));
+  }
+  for (; i != n; ++i) {
+    float real = in[2 * i];
+    float im = in[2 * i + 1];
+    out[i] = real * real + im * im;
+  }
+}
+
+KNF_TARGET_AVX512 void Int16ToFloatAvx512(const int16_t *in, float scale,
+                                          float *out, int32_t n) {
+  __m512 vs = _mm512_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(in + i));
+    __m512 f = _mm512_cvtepi32_ps(_mm512_cvtepi16_epi32(v));
+    _mm512_storeu_ps(out + i, _mm512_mul_ps(f, vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_AVX512 void Int32ToFloatAvx512(const int32_t *in, float scale,
+                                          float *out, int32_t n) {
+  __m512 vs = _mm512_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i v = _mm512_loadu_si512(in + i);
+    _mm512_storeu_ps(out + i, _mm512_mul_ps(_mm512_cvtepi32_ps(v), vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_AVX512 void DoubleToFloatAvx512(const double *in, float scale,
+                                           float *out, int32_t n) {
+  __m256 vs = _mm256_set1_ps(scale);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 f = _mm512_cvtpd_ps(_mm512_loadu_pd(in + i));
+    _mm256_storeu_ps(out + i, _mm256_mul_ps(f, vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+KNF_TARGET_AVX512 void PreemphasizeAndWindowAvx512(const float *w,
+                                                   float mean, float coeff,
+                                                   float *x, int32_t n) {
+  if (n == 0) {
+    return;
+  }
+
+  __m512 vm = _mm512_set1_ps(mean);
+  __m512 vc = _mm512_set1_ps(coeff);
+  int32_t i = n;
+  while (i - 16 >= 1) {
+    i -= 16;
+    __m512 y = _mm512_sub_ps(_mm512_loadu_ps(x + i), vm);
+    __m512 prev = _mm512_sub_ps(_mm512_loadu_ps(x + i - 1), vm);
+    y = _mm512_sub_ps(y, _mm512_mul_ps(vc, prev));
+    _mm512_storeu_ps(x + i, _mm512_mul_ps(y, _mm512_loadu_ps(w + i)));
+  }
+  PreemphasizeAndWindowTail(w, mean, coeff, x, i);
+}
+
+KNF_TARGET_AVX512 void PiecewiseUint8ToFloatAvx512(const uint8_t *in,
+                                                   const float *base,
+                                                   const float *scale,
+                                                   const float *offset,
+                                                   float *out, int32_t n) {
+  __m512 b0 = _mm512_set1_ps(base[0]);
+  __m512 b1 = _mm512_set1_ps(base[1]);
+  __m512 b2 = _mm512_set1_ps(base[2]);
+  __m512 s0 = _mm512_set1_ps(scale[0]);
+  __m512 s1 = _mm512_set1_ps(scale[1]);
+  __m512 s2 = _mm512_set1_ps(scale[2]);
+  __m512 o0 = _mm512_set1_ps(offset[0]);
+  __m512 o1 = _mm512_set1_ps(offset[1]);
+  __m512 o2 = _mm512_set1_ps(offset[2]);
+  __m512 t1 = _mm512_set1_ps(64);
+  __m512 t2 = _mm512_set1_ps(192);
+
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i));
+    __m512 f = _mm512_cvtepi32_ps(_mm512_cvtepu8_epi32(v));
+    __mmask16 m1 = _mm512_cmp_ps_mask(f, t1, _CMP_GT_OQ);
+    __mmask16 m2 = _mm512_cmp_ps_mask(f, t2, _CMP_GT_OQ);
+    __m512 b = _mm512_mask_blend_ps(m2, _mm512_mask_blend_ps(m1, b0, b1), b2);
+    __m512 s = _mm512_mask_blend_ps(m2, _mm512_mask_blend_ps(m1, s0, s1), s2);
+    __m512 o = _mm512_mask_blend_ps(m2, _mm512_mask_blend_ps(m1, o0, o1), o2);
+    _mm512_storeu_ps(out + i,
+                     _mm512_add_ps(b, _mm512_mul_ps(s, _mm512_sub_ps(f, o))));
+  }
+  PiecewiseUint8ToFloatScalar(in + i, base, scale, offset, out + i, n - i);
+}
+
+KNF_TARGET_AVX512 void FloatToHalfAvx512(const float *in, uint16_t *out,
+                                         int32_t n) {
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m256i h = _mm512_cvtps_ph(_mm512_loadu_ps(in + i),
+                                _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), h);
+  }
+  FloatToHalfScalar(in + i, out + i, n - i);
+}
+
+KNF_TARGET_AVX512 void FloatToBFloat16Avx512(const float *in, uint16_t *out,
+                                             int32_t n) {
+  __m512i one = _mm512_set1_epi32(1);
+  __m512i bias = _mm512_set1_epi32(0x7fff);
+  __m512i quiet = _mm512_set1_epi32(0x400000);
+  __m512i abs_mask = _mm512_set1_epi32(0x7fffffff);
+  __m512i inf = _mm512_set1_epi32(0x7f800000);
+
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    __m512i x = _mm512_castps_si512(_mm512_loadu_ps(in + i));
+    __m512i lsb = _mm512_and_si512(_mm512_srli_epi32(x, 16), one);
+    __m512i r = _mm512_add_epi32(_mm512_add_epi32(x, bias), lsb);
+    __mmask16 nan =
+        _mm512_cmpgt_epi32_mask(_mm512_and_si512(x, abs_mask), inf);
+    r = _mm512_mask_blend_epi32(nan, r, _mm512_or_si512(x, quiet));
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i),
+                        _mm512_cvtepi32_epi16(_mm512_srli_epi32(r, 16)));
+  }
+  FloatToBFloat16Scalar(in + i, out + i, n - i);
+}
+
+constexpr SimdKernels kAvx512Kernels = {
+    InnerProductAvx512,          SumAvx512,
+    AddScalarAvx512,             MultiplyAvx512,
+    SqrtAvx512,                  LogScalar,
+    LogFastAvx512,               ComplexSquaredNormAvx512,
+    Int16ToFloatAvx512,          Int32ToFloatAvx512,
+    DoubleToFloatAvx512,         PreemphasizeAndWindowAvx512,
+    GaussAvx512,                 PiecewiseUint8ToFloatAvx512,
+    FloatToHalfAvx512,           FloatToBFloat16Avx512,
+    AxpyAvx512,
+};
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+#endif  // KNF_SIMD_X86
+
+#if KNF_SIMD_NEON
+
+inline float HorizontalSumNeon(float32x4_t v) {
+#if defined(__aarch64__)
+  return vaddvq_f32(v);
+#else
+  float32x2_t t = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+  return vget_lane_f32(vpadd_f32(t, t), 0);
+#endif
+}
+
+float InnerProductNeon(const float *a, const float *b, int32_t n) {
+  float32x4_t acc0 = vdupq_n_f32(0);
+  float32x4_t acc1 = vdupq_n_f32(0);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = vaddq_f32(acc0, vmulq_f32(vld1q_f32(a + i), vld1q_f32(b + i)));
+    acc1 =
+        vaddq_f32(acc1, vmulq_f32(vld1q_f32(a + i + 4), vld1q_f32(b + i + 4)));
+  }
+  float sum = HorizontalSumNeon(vaddq_f32(acc0, acc1));
+  for (; i != n; ++i) {
+    sum += a[i] * b[i];
+  }
+  return sum;
+}
+
+float SumNeon(const float *x, int32_t n) {
+  float32x4_t acc0 = vdupq_n_f32(0);
+  float32x4_t acc1 = vdupq_n_f32(0);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    acc0 = vaddq_f32(acc0, vld1q_f32(x + i));
+    acc1 = vaddq_f32(acc1, vld1q_f32(x + i + 4));
+  }
+  float sum = HorizontalSumNeon(vaddq_f32(acc0, acc1));
+  for (; i != n; ++i) {
+    sum += x[i];
+  }
+  return sum;
+}
+
+void AddScalarNeon(float c, float *x, int32_t n) {
+  float32x4_t vc = vdupq_n_f32(c);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(x + i, vaddq_f32(vld1q_f32(x + i), vc));
+  }
+  for (; i != n; ++i) {
+    x[i] += c;
+  }
+}
+
+void MultiplyNeon(const float *w, float *x, int32_t n) {
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(x + i, vmulq_f32(vld1q_f32(x + i), vld1q_f32(w + i)));
+  }
+  for (; i != n; ++i) {
+    x[i] *= w[i];
+  }
+}
+
+void AxpyNeon(float a, const float *x, float *y, int32_t n) {
+  float32x4_t va = vdupq_n_f32(a);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t p = vmulq_f32(va, vld1q_f32(x + i));
+    vst1q_f32(y + i, vaddq_f32(vld1q_f32(y + i), p));
+  }
+  for (; i != n; ++i) {
+    y[i] += a * x[i];
+  }
+}
+
+void SqrtNeon(float *x, int32_t n) {
+  int32_t i = 0;
+#if defined(__aarch64__)
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(x + i, vsqrtq_f32(vld1q_f32(x + i)));
+  }
+#endif
+  for (; i != n; ++i) {
+    x[i] = std::sqrt(x[i]);
+  }
+}
+
+// See LogSplitSse2()
+inline void LogSplitNeon(float32x4_t x, float32x4_t *e, float32x4_t *t) {
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  uint32x4_t i = vreinterpretq_u32_f32(x);
+
+  *e = vcvtq_f32_s32(vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(i, 23)),
+                               vdupq_n_s32(126)));
+  float32x4_t m = vreinterpretq_f32_u32(
+      vorrq_u32(vandq_u32(i, vdupq_n_u32(0x007fffff)),
+                vdupq_n_u32(0x3f000000)));
+
+  uint32x4_t mask = vcltq_f32(m, vdupq_n_f32(kLogSqrtHalf));
+  *e = vsubq_f32(*e, vreinterpretq_f32_u32(
+                         vandq_u32(mask, vreinterpretq_u32_f32(one))));
+  *t = vaddq_f32(
+      vsubq_f32(m, one),
+      vreinterpretq_f32_u32(vandq_u32(mask, vreinterpretq_u32_f32(m))));
+}
+
+// See LogFast()
+inline float32x4_t LogFastNeon(float32x4_t x) {
+  float32x4_t e;
+  float32x4_t t;
+  LogSplitNeon(x, &e, &t);
+
+  float32x4_t y = vdupq_n_f32(kLogFastQ[0]);
+  for (int32_t k = 1; k != 5; ++k) {
+    y = vaddq_f32(vmulq_f32(y, t), vdupq_n_f32(kLogFastQ[k]));
+  }
+  y = vmulq_f32(y, t);
+  y = vaddq_f32(y, vmulq_f32(e, vdupq_n_f32(kLogLn2Lo)));
+  return vaddq_f32(y, vmulq_f32(e, vdupq_n_f32(kLogLn2Hi)));
+}
+
+void LogFastNeon(float floor, float *x, int32_t n) {
+  float32x4_t f = vdupq_n_f32(floor);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(x + i, LogFastNeon(vmaxq_f32(vld1q_f32(x + i), f)));
+  }
+  LogFastScalar(floor, x + i, n - i);
+}
+
+void GaussNeon(const float *u1, const float *u2, float *out, int32_t n) {
+  int32_t i = 0;
+#if defined(__aarch64__)
+  for (; i + 4 <= n; i += 4) {
+    float32x4_t r = vsqrtq_f32(
+        vmulq_f32(LogFastNeon(vld1q_f32(u1 + i)), vdupq_n_f32(-2.0f)));
+    float32x4_t t = vsubq_f32(
+        vmulq_f32(vld1q_f32(u2 + i), vdupq_n_f32(kTwoPi)), vdupq_n_f32(kPi));
+    float32x4_t t2 = vmulq_f32(t, t);
+
+    float32x4_t y = vdupq_n_f32(kCosP[0]);
+    float32x4_t z = vdupq_n_f32(kSinP[0]);
+    for (int32_t k = 1; k != 5; ++k) {
+      y = vaddq_f32(vmulq_f32(y, t2), vdupq_n_f32(kCosP[k]));
+      z = vaddq_f32(vmulq_f32(z, t2), vdupq_n_f32(kSinP[k]));
+    }
+    vst1q_f32(out + i, vmulq_f32(r, y));
+    vst1q_f32(out + n + i, vmulq_f32(r, vmulq_f32(z, t)));
+  }
+#endif
+  for (; i != n; ++i) {
+    Gauss(u1[i], u2[i], out + i, out + n + i);
+  }
+}
+
+void ComplexSquaredNormNeon(const float *in, float *out, int32_t n) {
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    float32x4x2_t v = vld2q_f32(in + 2 * i);  // de-interleave
+    float32x4_t real = vmulq_f32(v.val[0], v.val[0]);
+    float32x4_t im = vmulq_f32(v.val[1], v.val[1]);
+    vst1q_f32(out + i, vaddq_f32(real, im));
+  }
+  for (; i != n; ++i) {
+    float real = in[2 * i];
+    float im = in[2 * i + 1];
+    out[i] = real * real + im * im;
+  }
+}
+
+void Int16ToFloatNeon(const int16_t *in, float scale, float *out,
+                      int32_t n) {
+  float32x4_t vs = vdupq_n_f32(scale);
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    int16x8_t v = vld1q_s16(in + i);
+    float32x4_t lo = vcvtq_f32_s32(vmovl_s16(vget_low_s16(v)));
+    float32x4_t hi = vcvtq_f32_s32(vmovl_s16(vget_high_s16(v)));
+    vst1q_f32(out + i, vmulq_f32(lo, vs));
+    vst1q_f32(out + i + 4, vmulq_f32(hi, vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+void Int32ToFloatNeon(const int32_t *in, float scale, float *out,
+                      int32_t n) {
+  float32x4_t vs = vdupq_n_f32(scale);
+  int32_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    vst1q_f32(out + i, vmulq_f32(vcvtq_f32_s32(vld1q_s32(in + i)), vs));
+  }
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+void DoubleToFloatNeon(const double *in, float scale, float *out,
+                       int32_t n) {
+  int32_t i = 0;
+#if defined(__aarch64__)
+  float32x4_t vs = vdupq_n_f32(scale);
+  for (; i + 4 <= n; i += 4) {
+    float32x2_t lo = vcvt_f32_f64(vld1q_f64(in + i));
+    float32x2_t hi = vcvt_f32_f64(vld1q_f64(in + i + 2));
+    vst1q_f32(out + i, vmulq_f32(vcombine_f32(lo, hi), vs));
+  }
+#endif
+  ToFloatScalar(in + i, scale, out + i, n - i);
+}
+
+void PreemphasizeAndWindowNeon(const float *w, float mean, float coeff,
+                               float *x, int32_t n) {
+  if (n == 0) {
+    return;
+  }
+
+  float32x4_t vm = vdupq_n_f32(mean);
+  float32x4_t vc = vdupq_n_f32(coeff);
+  int32_t i = n;
+  while (i - 4 >= 1) {
+    i -= 4;
+    float32x4_t y = vsubq_f32(vld1q_f32(x + i), vm);
+    float32x4_t prev = vsubq_f32(vld1q_f32(x + i - 1), vm);
+    y = vsubq_f32(y, vmulq_f32(vc, prev));
+    vst1q_f32(x + i, vmulq_f32(y, vld1q_f32(w + i)));
+  }
+  PreemphasizeAndWindowTail(w, mean, coeff, x, i);
+}
+
+void PiecewiseUint8ToFloatNeon(const uint8_t *in, const float *base,
+                               const float *scale, const float *offset,
+                               float *out, int32_t n) {
+  float32x4_t b0 = vdupq_n_f32(base[0]);
+  float32x4_t b1 = vdupq_n_f32(base[1]);
+  float32x4_t b2 = vdupq_n_f32(base[2]);
+  float32x4_t s0 = vdupq_n_f32(scale[0]);
+  float32x4_t s1 = vdupq_n_f32(scale[1]);
+  float32x4_t s2 = vdupq_n_f32(scale[2]);
+  float32x4_t o0 = vdupq_n_f32(offset[0]);
+  float32x4_t o1 = vdupq_n_f32(offset[1]);
+  float32x4_t o2 = vdupq_n_f32(offset[2]);
+  float32x4_t t1 = vdupq_n_f32(64);
+  float32x4_t t2 = vdupq_n_f32(192);
+
+  int32_t i = 0;
+  for (; i + 16 <= n; i += 16) {
+    uint8x16_t v = vld1q_u8(in + i);
+    uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+    uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+    uint32x4_t w[4] = {
+        vmovl_u16(vget_low_u16(lo)), vmovl_u16(vget_high_u16(lo)),
+        vmovl_u16(vget_low_u16(hi)), vmovl_u16(vget_high_u16(hi))};
+
+    for (int32_t k = 0; k != 4; ++k) {
+      float32x4_t f = vcvtq_f32_u32(w[k]);
+      uint32x4_t m1 = vcgtq_f32(f, t1);
+      uint32x4_t m2 = vcgtq_f32(f, t2);
+      float32x4_t b = vbslq_f32(m2, b2, vbslq_f32(m1, b1, b0));
+      float32x4_t s = vbslq_f32(m2, s2, vbslq_f32(m1, s1, s0));
+      float32x4_t o = vbslq_f32(m2, o2, vbslq_f32(m1, o1, o0));
+      vst1q_f32(out + i + 4 * k, vaddq_f32(b, vmulq_f32(s, vsubq_f32(f, o))));
+    }
+  }
+  PiecewiseUint8ToFloatScalar(in + i, base, scale, offset, out + i, n - i);
+}
+
+#if defined(__aarch64__)
+void FloatToHalfNeon(const float *in, uint16_t *out, int32_t n) {
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    float16x8_t h = vcombine_f16(vcvt_f16_f32(vld1q_f32(in + i)),
+                                 vcvt_f16_f32(vld1q_f32(in + i + 4)));
+    vst1q_u16(out + i, vreinterpretq_u16_f16(h));
+  }
+  FloatToHalfScalar(in + i, out + i, n - i);
+}
+#else
+// The conversion instructions are optional in ARMv7
+#define FloatToHalfNeon FloatToHalfScalar
+#endif
+
+// Rounded bfloat16 in the upper 16 bits of each lane
+inline uint32x4_t FloatToBFloat16Neon(uint32x4_t x) {
+  uint32x4_t lsb = vandq_u32(vshrq_n_u32(x, 16), vdupq_n_u32(1));
+  uint32x4_t r = vaddq_u32(vaddq_u32(x, vdupq_n_u32(0x7fff)), lsb);
+  uint32x4_t q = vorrq_u32(x, vdupq_n_u32(0x400000));
+  uint32x4_t nan = vcgtq_u32(vandq_u32(x, vdupq_n_u32(0x7fffffff)),
+                             vdupq_n_u32(0x7f800000));
+  return vbslq_u32(nan, q, r);
+}
+
+void FloatToBFloat16Neon(const float *in, uint16_t *out, int32_t n) {
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    uint32x4_t a =
+        FloatToBFloat16Neon(vreinterpretq_u32_f32(vld1q_f32(in + i)));
+    uint32x4_t b =
+        FloatToBFloat16Neon(vreinterpretq_u32_f32(vld1q_f32(in + i + 4)));
+    vst1q_u16(out + i, vcombine_u16(vshrn_n_u32(a, 16), vshrn_n_u32(b, 16)));
+  }
+  FloatToBFloat16Scalar(in + i, out + i, n - i);
+}
+
+constexpr SimdKernels kNeonKernels = {
+    InnerProductNeon,          SumNeon,
+    AddScalarNeon,             MultiplyNeon,
+    SqrtNeon,                  LogScalar,
+    LogFastNeon,               ComplexSquaredNormNeon,
+    Int16ToFloatNeon,          Int32ToFloatNeon,
+    DoubleToFloatNeon,         PreemphasizeAndWindowNeon,
+    GaussNeon,                 PiecewiseUint8ToFloatNeon,
+    FloatToHalfNeon,           FloatToBFloat16Neon,
+    AxpyNeon,
+};
+
+#endif  // KNF_SIMD_NEON
+
+bool IsSupported(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return true;
+#if KNF_SIMD_X86
+    case SimdLevel::kSse2:
+      return __builtin_cpu_supports("sse2");
+    case SimdLevel::kAvx2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma") &&
+             __builtin_cpu_supports("f16c");
+    case SimdLevel::kAvx512:
+      return __builtin_cpu_supports("avx512f");
+#endif
+#if KNF_SIMD_NEON
+    case SimdLevel::kNeon:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+SimdLevel DetectSimdLevel() {
+  SimdLevel level = SimdLevel::kNeon;
+
+  const char *env = std::getenv("KNF_SIMD_LEVEL");
+  if (env != nullptr && env[0] != '\0') {
+    bool found = false;
+    for (int32_t i = 0; i <= static_cast<int32_t>(SimdLevel::kNeon); ++i) {
+      if (std::strcmp(env, SimdLevelName(static_cast<SimdLevel>(i))) == 0) {
+        level = static_cast<SimdLevel>(i);
+        found = true;
+        break;
+      }
+    }
+
+    if (!found) {
+      fprintf(stderr,
+              "Unknown KNF_SIMD_LEVEL: '%s'. Valid values are: scalar, sse2, "
+              "avx2, avx512, neon. Ignore it\n",
+              env);
+    }
+  }
+
+  while (!IsSupported(level)) {
+    level = static_cast<SimdLevel>(static_cast<int32_t>(level) - 1);
+  }
+
+  return level;
+}
+
+}  // namespace
+
+const char *SimdLevelName(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::kScalar:
+      return "scalar";
+    case SimdLevel::kSse2:
+      return "sse2";
+    case SimdLevel::kAvx2:
+      return "avx2";
+    case SimdLevel::kAvx512:
+      return "avx512";
+    case SimdLevel::kNeon:
+      return "neon";
+  }
+  return "unknown";
+}
+
+SimdLevel GetSimdLevel() {
+  static const SimdLevel level = DetectSimdLevel();
+  return level;
+}
+
+const SimdKernels &GetSimdKernels() {
+  static const SimdKernels *kernels = GetSimdKernels(GetSimdLevel());
+  return *kernels;
+}
+
+const SimdKernels *GetSimdKernels(SimdLevel level) {
+  if (!IsSupported(level)) {
+    return nullptr;
+  }
+
+  switch (level) {
+    case SimdLevel::kScalar:
+      return &kScalarKernels;
+#if KNF_SIMD_X86
+    case SimdLevel::kSse2:
+      return &kSse2Kernels;
+    case SimdLevel::kAvx2:
+      return &kAvx2Kernels;
+    case SimdLevel::kAvx512:
+      return &kAvx512Kernels;
+#endif
+#if KNF_SIMD_NEON
+    case SimdLevel::kNeon:
+      return &kNeonKernels;
+#endif
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace knf
@@ -0,0 +1,152 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Runtime dispatch of SIMD kernels.
+//
+// The library is compiled for the baseline ISA of the target. Kernels for
+// newer instruction sets are compiled with function-level target attributes
+// and selected at startup according to the CPU, so a single binary works on
+// all machines.
+//
+// The environment variable KNF_SIMD_LEVEL can be set to one of
+// scalar, sse2, avx2, avx512 and neon to force a level, e.g., for testing.
+// If the given level is not supported by the CPU, the best supported level
+// below it is used.
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_SIMD_H_
+#define KALDI_NATIVE_FBANK_CSRC_SIMD_H_
+
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define KNF_SIMD_X86 1
+#endif
+
+#if defined(__ARM_NEON) || defined(__aarch64__)
+#define KNF_SIMD_NEON 1
+#endif
+
+namespace knf {
+
+enum class SimdLevel : int32_t {
+  kScalar = 0,
+  kSse2 = 1,
+  kAvx2 = 2,  // AVX2 + FMA + F16C
+  kAvx512 = 3,  // AVX-512F
+  kNeon = 4,
+};
+
+const char *SimdLevelName(SimdLevel level);
+
+struct SimdKernels {
+  // Return sum_i a[i] * b[i]
+  float (*inner_product)(const float *a, const float *b, int32_t n);
+
+  // Return sum_i x[i]
+  float (*sum)(const float *x, int32_t n);
+
+  // x[i] += c
+  void (*add_scalar)(float c, float *x, int32_t n);
+
+  // x[i] *= w[i]
+  void (*multiply)(const float *w, float *x, int32_t n);
+
+  // x[i] = sqrt(x[i])
+  void (*sqrt)(float *x, int32_t n);
+
+  // x[i] = log(max(x[i], floor)).
+  //
+  // All levels use std::log(), so the log kernel gives the same result at
+  // every SIMD level. Its input, e.g., the output of the mel filter banks,
+  // may still differ between levels and from Kaldi in rounding.
+  void (*log)(float floor, float *x, int32_t n);
+
+  // The same as log, but with a polynomial approximation. floor must be a
+  // positive normal number and x[i] must not be inf. The relative error is
+  // less than 1e-4. All levels, including the scalar one, give identical
+  // results. It is used only if FrameExtractionOptions::accuracy is "fast".
+  void (*log_fast)(float floor, float *x, int32_t n);
+
+  // out[i] = in[2*i]^2 + in[2*i+1]^2, for 0 <= i < n.
+  // out may alias in as long as out <= in.
+  void (*complex_squared_norm)(const float *in, float *out, int32_t n);
+
+  // out[i] = static_cast<float>(in[i]) * scale
+  void (*int16_to_float)(const int16_t *in, float scale, float *out,
+                         int32_t n);
+  void (*int32_to_float)(const int32_t *in, float scale, float *out,
+                         int32_t n);
+  void (*double_to_float)(const double *in, float scale, float *out,
+                          int32_t n);
+
+  // y[i] = x[i] - mean
+  // x[i] = w[i] * (y[i] - coeff * y[i-1]), with y[-1] = y[0]
+  void (*preemphasize_and_window)(const float *w, float mean, float coeff,
+                                  float *x, int32_t n);
+
+  // Box-Muller transform with polynomial approximations of log, cos and sin.
+  // For 0 < u1[i] < 1 and 0 <= u2[i] <= 1, let r = sqrt(-2 * log(u1[i]))
+  // and t = 2 * pi * u2[i] - pi. Then
+  //
+  //   out[i] = r * cos(t)
+  //   out[n + i] = r * sin(t)
+  //
+  // Given uniform random u1 and u2, they are independent samples from the
+  // standard normal distribution. The absolute error of cos and sin is less
+  // than 5e-5. All levels give identical results.
+  void (*gauss)(const float *u1, const float *u2, float *out, int32_t n);
+
+  // Piecewise linear map of bytes, e.g., to decompress Kaldi's compressed
+  // matrices. For v = in[i],
+  //
+  //   out[i] = base[k] + scale[k] * (v - offset[k])
+  //
+  // where k = 0 if v <= 64, k = 1 if 64 < v <= 192 and k = 2 otherwise.
+  // All levels give identical results.
+  void (*piecewise_uint8_to_float)(const uint8_t *in, const float *base,
+                                   const float *scale, const float *offset,
+                                   float *out, int32_t n);
+
+  // out[i] = in[i] as IEEE half precision, rounded to nearest even.
+  // Values too large for half become inf. NaNs stay NaN. All levels give
+  // identical results.
+  void (*float_to_half)(const float *in, uint16_t *out, int32_t n);
+
+  // out[i] = in[i] as bfloat16, rounded to nearest even. NaNs stay NaN.
+  // All levels give identical results.
+  void (*float_to_bfloat16)(const float *in, uint16_t *out, int32_t n);
+
+  // y[i] += a * x[i]
+  void (*axpy)(float a, const float *x, float *y, int32_t n);
+};
+
+// Return the level used by GetSimdKernels(). It is determined on the first
+// call and cached.
+SimdLevel GetSimdLevel();
+
+// Kernels of the best supported level, or of the level given by
+// KNF_SIMD_LEVEL.
+const SimdKernels &GetSimdKernels();
+
+// Return nullptr if the level is not supported by this CPU or by this build.
+const SimdKernels *GetSimdKernels(SimdLevel level);
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_SIMD_H_
@@ -19,10 +19,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <mutex>  // NOLINT
 #include <sstream>
 #include <string>
 
 #include "kaldi-native-fbank/csrc/feature-window.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
 #include "kaldi-native-fbank/csrc/rfft.h"
 
 namespace knf {
@@ -51,6 +53,11 @@ class Stft::Impl {
   }
 
   StftResult Compute(const float *data, int32_t n) const {
+#if KNF_ENABLE_PROFILING
+    ProfileStats stats;
+    KNF_PROFILE_STATS(&stats);
+#endif
+
     int32_t n_fft = config_.n_fft;
     int32_t hop_length = config_.hop_length;
 
@@ -75,12 +82,20 @@ class Stft::Impl {
     std::vector<float> tmp(config_.n_fft);
 
     for (int32_t i = 0; i < num_frames; ++i) {
-      tmp = {p + i * hop_length, p + i * hop_length + n_fft};
+      {
+        KNF_PROFILE_SCOPE(kProfileFraming);
+        tmp = {p + i * hop_length, p + i * hop_length + n_fft};
+      }
+
       if (window_) {
+        KNF_PROFILE_SCOPE(kProfileWindow);
         window_->Apply(tmp.data());
       }
 
-      rfft.Compute(tmp.data());
+      {
+        KNF_PROFILE_SCOPE(kProfileFft);
+        rfft.Compute(tmp.data());
+      }
 
       for (int32_t k = 0; k < n_fft / 2; ++k) {
         if (k == 0) {
@@ -102,9 +117,28 @@ class Stft::Impl {
       }
     }
 
+#if KNF_ENABLE_PROFILING
+    stats.frames_processed = num_frames;
+    stats.bytes_allocated = CapacityInBytes(samples) + CapacityInBytes(tmp) +
+                            CapacityInBytes(ans.real) +
+                            CapacityInBytes(ans.imag);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stats_.Merge(stats);
+#endif
+
     return ans;
   }
 
+  ProfileStats GetStats() const {
+#if KNF_ENABLE_PROFILING
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+#else
+    return {};
+#endif
+  }
+
   std::vector<float> Pad(const float *data, int32_t n) const {
     int32_t pad_amount = config_.n_fft / 2;
     std::vector<float> ans(n + config_.n_fft);
@@ -129,6 +163,11 @@ class Stft::Impl {
  private:
   StftConfig config_;
   std::unique_ptr<FeatureWindowFunction> window_;
+
+#if KNF_ENABLE_PROFILING
+  mutable std::mutex mutex_;
+  mutable ProfileStats stats_;
+#endif
 };
 
 Stft::Stft(const StftConfig &config) : impl_(std::make_unique<Impl>(config)) {}
@@ -139,4 +178,6 @@ StftResult Stft::Compute(const float *data, int32_t n) const {
   return impl_->Compute(data, n);
 }
 
+ProfileStats Stft::GetStats() const { return impl_->GetStats(); }
+
 }  // namespace knf
@@ -24,6 +24,8 @@
 #include <string>
 #include <vector>
 
+#include "kaldi-native-fbank/csrc/profiling.h"
+
 namespace knf {
 
 struct StftConfig {
@@ -54,6 +56,9 @@ class Stft {
   ~Stft();
   StftResult Compute(const float *data, int32_t n) const;
 
+  // Accumulated over all calls of Compute(). See profiling.h
+  ProfileStats GetStats() const;
+
  private:
   class Impl;
   std::unique_ptr<Impl> impl_;
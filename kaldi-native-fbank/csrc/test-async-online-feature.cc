@@ -0,0 +1,160 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/async-online-feature.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/bounded-queue.h"
+#include "kaldi-native-fbank/csrc/test-utils.h"
+#include "kaldi-native-fbank/csrc/thread-pool.h"
+
+namespace knf {
+
+TEST(BoundedQueue, Basic) {
+  BoundedQueue<int32_t> q(3);
+  EXPECT_EQ(q.Capacity(), 4);
+  EXPECT_TRUE(q.Empty());
+
+  for (int32_t i = 0; i != 4; ++i) {
+    EXPECT_TRUE(q.TryPush(int32_t(i)));
+  }
+  EXPECT_FALSE(q.TryPush(10));
+
+  int32_t v;
+  for (int32_t i = 0; i != 4; ++i) {
+    EXPECT_TRUE(q.TryPop(&v));
+    EXPECT_EQ(v, i);
+  }
+  EXPECT_FALSE(q.TryPop(&v));
+  EXPECT_TRUE(q.Empty());
+}
+
+TEST(BoundedQueue, MultiProducer) {
+  constexpr int32_t kNumProducers = 4;
+  constexpr int32_t kNumItems = 10000;
+
+  BoundedQueue<int32_t> q(64);
+
+  std::vector<std::thread> producers;
+  for (int32_t p = 0; p != kNumProducers; ++p) {
+    producers.emplace_back([&q, p]() {
+      for (int32_t i = 0; i != kNumItems; ++i) {
+        while (!q.TryPush(p * kNumItems + i)) {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  // Items of the same producer must come out in order
+  std::vector<int32_t> last(kNumProducers, -1);
+  int32_t count = 0;
+  int32_t v;
+  while (count != kNumProducers * kNumItems) {
+    if (!q.TryPop(&v)) {
+      std::this_thread::yield();
+      continue;
+    }
+    int32_t p = v / kNumItems;
+    int32_t i = v % kNumItems;
+    EXPECT_EQ(i, last[p] + 1);
+    last[p] = i;
+    ++count;
+  }
+
+  for (auto &t : producers) {
+    t.join();
+  }
+}
+
+TEST(AsyncOnlineFeature, Fbank) {
+  FbankOptions opts = GetTestFbankOptions(80);
+
+  FbankExtractorConfig config(opts);
+  ThreadPool pool(2);
+
+  constexpr int32_t kNumStreams = 4;
+  std::vector<std::vector<float>> waves;
+  std::vector<std::unique_ptr<AsyncOnlineFbank>> streams;
+  std::atomic<int32_t> num_callbacks{0};
+
+  AsyncOnlineFeatureOptions async_opts;
+  async_opts.max_pending_chunks = 4;
+
+  for (int32_t i = 0; i != kNumStreams; ++i) {
+    waves.push_back(GetTestWave(16000 + 1000 * i, 0, 0.01f * (i + 1)));
+    streams.push_back(std::make_unique<AsyncOnlineFbank>(
+        config, &pool, async_opts,
+        [&num_callbacks](int32_t) { ++num_callbacks; }));
+  }
+
+  // Interleave the streams with small chunks so that the queues are
+  // likely to be full at some point.
+  constexpr int32_t kChunk = 160;
+  for (int32_t start = 0; start < 20000; start += kChunk) {
+    for (int32_t i = 0; i != kNumStreams; ++i) {
+      int32_t n = std::min<int32_t>(
+          kChunk, std::max<int32_t>(0, waves[i].size() - start));
+      if (n == 0) {
+        continue;
+      }
+
+      while (!streams[i]->AcceptWaveformAsync(16000, waves[i].data() + start,
+                                              n)) {
+        streams[i]->Wait();
+      }
+    }
+  }
+
+  for (auto &s : streams) {
+    while (!s->InputFinishedAsync()) {
+      s->Wait();
+    }
+  }
+
+  for (int32_t i = 0; i != kNumStreams; ++i) {
+    streams[i]->Wait();
+
+    OnlineFbank expected(config);
+    expected.AcceptWaveform(16000, waves[i].data(), waves[i].size());
+    expected.InputFinished();
+
+    int32_t num_frames = expected.NumFramesReady();
+    ASSERT_EQ(streams[i]->NumFramesReady(), num_frames);
+    EXPECT_TRUE(streams[i]->IsLastFrame(num_frames - 1));
+
+    std::vector<float> frame(streams[i]->Dim());
+    for (int32_t f = 0; f != num_frames; ++f) {
+      streams[i]->GetFrame(f, frame.data());
+      const float *p = expected.GetFrame(f);
+      for (int32_t d = 0; d != expected.Dim(); ++d) {
+        EXPECT_EQ(frame[d], p[d]) << i << ", " << f << ", " << d;
+      }
+    }
+  }
+
+  EXPECT_GT(num_callbacks, 0);
+}
+
+}  // namespace knf
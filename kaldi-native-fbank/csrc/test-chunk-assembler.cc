@@ -0,0 +1,125 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/chunk-assembler.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/test-utils.h"
+
+namespace knf {
+
+// @param pop_every  Chunks are popped after every pop_every chunks are
+//                   read, so that a larger value needs a larger ring buffer
+static void TestChunkAssembler(
+    int32_t chunk_size, int32_t left_context, int32_t stride,
+    int32_t pop_every, FeatureLayout layout = FeatureLayout::kFrameMajor) {
+  FbankOptions opts = GetTestFbankOptions(8);
+  std::vector<float> wave = GetTestWave(16000);
+
+  OnlineFbank fbank(opts);
+  fbank.AcceptWaveform(16000, wave.data(), wave.size());
+  fbank.InputFinished();
+  int32_t num_frames = fbank.NumFramesReady();
+  int32_t dim = fbank.Dim();
+
+  ChunkAssemblerOptions chunk_opts;
+  chunk_opts.chunk_size = chunk_size;
+  chunk_opts.left_context = left_context;
+  chunk_opts.padding_value = -23;
+
+  OnlineFbank src(opts);
+  FbankChunkAssembler assembler(chunk_opts, &src);
+  int32_t num_rows = assembler.ChunkFrames();
+  EXPECT_EQ(num_rows, chunk_size + left_context);
+
+  bool frame_major = layout == FeatureLayout::kFrameMajor;
+  int32_t num_cols = frame_major ? dim : num_rows;
+  int32_t row_stride = stride == 0 ? num_cols : stride;
+  std::vector<float> out((frame_major ? num_rows : dim) * row_stride);
+
+  int32_t i = 0;
+  auto read_chunks = [&]() {
+    for (; i < assembler.NumChunksReady(); ++i) {
+      std::fill(out.begin(), out.end(), 100);
+      assembler.GetChunk(i, out.data(), stride, layout);
+
+      for (int32_t r = 0; r != num_rows; ++r) {
+        int32_t f = i * chunk_size - left_context + r;
+        for (int32_t d = 0; d != dim; ++d) {
+          float expected = (f < 0 || f >= num_frames)
+                               ? chunk_opts.padding_value
+                               : fbank.GetFrame(f)[d];
+          float v = frame_major ? out[r * row_stride + d]
+                                : out[d * row_stride + r];
+          ASSERT_EQ(v, expected) << i << " " << r << " " << d;
+        }
+      }
+
+      // Padding of a row is not touched
+      for (int32_t k = 0; k != static_cast<int32_t>(out.size()); ++k) {
+        if (k % row_stride >= num_cols) {
+          ASSERT_EQ(out[k], 100);
+        }
+      }
+
+      if ((i + 1) % pop_every == 0) {
+        assembler.Pop(pop_every);
+      }
+    }
+  };
+
+  for (int32_t k = 0; k < static_cast<int32_t>(wave.size()); k += 1000) {
+    int32_t n = std::min<int32_t>(1000, wave.size() - k);
+    src.AcceptWaveform(16000, wave.data() + k, n);
+    assembler.Update();
+    src.Pop(src.NumFramesReady());
+
+    EXPECT_EQ(assembler.NumChunksReady(), src.NumFramesReady() / chunk_size);
+    read_chunks();
+  }
+  src.InputFinished();
+  assembler.Update();
+
+  EXPECT_EQ(assembler.NumChunksReady(),
+            (num_frames + chunk_size - 1) / chunk_size);
+  read_chunks();
+}
+
+TEST(ChunkAssembler, Chunks) {
+  TestChunkAssembler(16, 0, 0, 1);
+  TestChunkAssembler(16, 7, 0, 1);
+  TestChunkAssembler(5, 12, 0, 1);
+  TestChunkAssembler(7, 3, 16, 1);
+}
+
+TEST(ChunkAssembler, FeatureMajor) {
+  TestChunkAssembler(16, 7, 0, 1, FeatureLayout::kFeatureMajor);
+  TestChunkAssembler(7, 3, 12, 1, FeatureLayout::kFeatureMajor);
+}
+
+TEST(ChunkAssembler, Grow) {
+  // The ring buffer has to hold the frames of several chunks
+  TestChunkAssembler(4, 3, 0, 5);
+  TestChunkAssembler(9, 2, 12, 1000);
+}
+
+}  // namespace knf
@@ -0,0 +1,231 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/compressed-matrix.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace knf {
+
+// Each column has a different range, like features
+static std::vector<float> RandomMatrix(int32_t num_rows, int32_t num_cols) {
+  std::vector<float> m(num_rows * num_cols);
+  uint32_t seed = 20260101;
+  for (int32_t r = 0; r != num_rows; ++r) {
+    for (int32_t c = 0; c != num_cols; ++c) {
+      seed = seed * 1664525u + 1013904223u;
+      float u = (seed >> 8) / 16777216.0f;  // [0, 1)
+      m[r * num_cols + c] = (c + 1) * (2 * u - 1) + 0.5f * c;
+    }
+  }
+  return m;
+}
+
+static float MaxAbsDiff(const std::vector<float> &a,
+                        const std::vector<float> &b) {
+  float ans = 0;
+  for (size_t i = 0; i != a.size(); ++i) {
+    ans = std::max(ans, std::abs(a[i] - b[i]));
+  }
+  return ans;
+}
+
+TEST(CompressedMatrix, RoundTrip) {
+  int32_t num_rows = 100;
+  int32_t num_cols = 40;
+  std::vector<float> m = RandomMatrix(num_rows, num_cols);
+  float min_value = *std::min_element(m.begin(), m.end());
+  float max_value = *std::max_element(m.begin(), m.end());
+  float range = max_value - min_value;
+
+  std::vector<float> out(m.size());
+
+  CompressedMatrix cm2(m.data(), num_rows, num_cols,
+                       CompressionMethod::kTwoByteAuto);
+  EXPECT_EQ(std::string(cm2.Token()), "CM2");
+  EXPECT_EQ(cm2.Data().size(), 16 + m.size() * 2);
+  cm2.CopyToMatrix(out.data());
+  EXPECT_LE(MaxAbsDiff(m, out), range / 65535);
+
+  CompressedMatrix cm3(m.data(), num_rows, num_cols,
+                       CompressionMethod::kOneByteAuto);
+  EXPECT_EQ(std::string(cm3.Token()), "CM3");
+  EXPECT_EQ(cm3.Data().size(), 16 + m.size());
+  cm3.CopyToMatrix(out.data());
+  EXPECT_LE(MaxAbsDiff(m, out), range / 255);
+
+  CompressedMatrix cm(m.data(), num_rows, num_cols,
+                      CompressionMethod::kSpeechFeature);
+  EXPECT_EQ(std::string(cm.Token()), "CM");
+  EXPECT_EQ(cm.Data().size(), 16 + num_cols * 8 + m.size());
+  EXPECT_EQ(cm.NumRows(), num_rows);
+  EXPECT_EQ(cm.NumCols(), num_cols);
+  cm.CopyToMatrix(out.data());
+
+  // Column c is in the range [0.5c - (c + 1), 0.5c + (c + 1)]. The
+  // widest piece is a half of it, which is mapped to 64 values.
+  for (int32_t c = 0; c != num_cols; ++c) {
+    float err = 0;
+    for (int32_t r = 0; r != num_rows; ++r) {
+      err = std::max(err, std::abs(m[r * num_cols + c] -
+                                   out[r * num_cols + c]));
+    }
+    EXPECT_LE(err, (c + 1) / 64.0f + range / 65535) << c;
+  }
+
+  // Decompress the bytes directly gives the same result
+  std::vector<float> out2(m.size());
+  CompressedMatrix::Decompress(cm.Token(), cm.Data().data(), out2.data());
+  EXPECT_EQ(out, out2);
+
+  int32_t r = 0;
+  int32_t c = 0;
+  EXPECT_EQ(CompressedMatrix::Parse(cm.Token(), cm.Data().data(),
+                                    cm.Data().size(), &r, &c),
+            static_cast<int64_t>(cm.Data().size()));
+  EXPECT_EQ(r, num_rows);
+  EXPECT_EQ(c, num_cols);
+  EXPECT_EQ(CompressedMatrix::Parse("CM4", cm.Data().data(),
+                                    cm.Data().size(), &r, &c),
+            -1);
+}
+
+TEST(CompressedMatrix, Automatic) {
+  std::vector<float> m = RandomMatrix(9, 3);
+  EXPECT_EQ(std::string(CompressedMatrix(m.data(), 8, 3).Token()), "CM2");
+  EXPECT_EQ(std::string(CompressedMatrix(m.data(), 9, 3).Token()), "CM");
+}
+
+TEST(CompressedMatrix, Rows) {
+  int32_t num_rows = 20;
+  int32_t num_cols = 7;
+  std::vector<float> m = RandomMatrix(num_rows, num_cols);
+  std::vector<const float *> rows(num_rows);
+  for (int32_t i = 0; i != num_rows; ++i) {
+    rows[i] = m.data() + i * num_cols;
+  }
+
+  CompressedMatrix a(m.data(), num_rows, num_cols);
+  CompressedMatrix b(rows.data(), num_rows, num_cols);
+  EXPECT_EQ(a.Data(), b.Data());
+}
+
+// Decode bytes produced by Kaldi with the formula of Kaldi
+TEST(CompressedMatrix, KaldiFormat) {
+  float min_value = -2;
+  float range = 4;
+  int32_t num_rows = 256;
+  int32_t num_cols = 2;
+  uint16_t percentiles[2][4] = {{0, 1000, 30000, 65535},
+                                {20000, 20001, 20002, 20003}};
+
+  std::vector<uint8_t> data(16 + num_cols * 8 + num_rows * num_cols);
+  memcpy(&data[0], &min_value, 4);
+  memcpy(&data[4], &range, 4);
+  memcpy(&data[8], &num_rows, 4);
+  memcpy(&data[12], &num_cols, 4);
+  memcpy(&data[16], percentiles, sizeof(percentiles));
+  for (int32_t c = 0; c != num_cols; ++c) {
+    for (int32_t r = 0; r != num_rows; ++r) {
+      data[16 + num_cols * 8 + c * num_rows + r] = (r + 100 * c) % 256;
+    }
+  }
+
+  auto uint16_to_float = [&](uint16_t v) {
+    return min_value + range * 1.52590218966964e-05f * v;
+  };
+
+  std::vector<float> out(num_rows * num_cols);
+  CompressedMatrix::Decompress("CM", data.data(), out.data());
+
+  for (int32_t c = 0; c != num_cols; ++c) {
+    float p0 = uint16_to_float(percentiles[c][0]);
+    float p25 = uint16_to_float(percentiles[c][1]);
+    float p75 = uint16_to_float(percentiles[c][2]);
+    float p100 = uint16_to_float(percentiles[c][3]);
+    for (int32_t r = 0; r != num_rows; ++r) {
+      int32_t v = data[16 + num_cols * 8 + c * num_rows + r];
+      float expected;
+      if (v <= 64) {
+        expected = p0 + (p25 - p0) * v * (1 / 64.0f);
+      } else if (v <= 192) {
+        expected = p25 + (p75 - p25) * (v - 64) * (1 / 128.0f);
+      } else {
+        expected = p75 + (p100 - p75) * (v - 192) * (1 / 63.0f);
+      }
+      EXPECT_NEAR(out[r * num_cols + c], expected, 1e-6f) << r << " " << c;
+    }
+  }
+
+  // CM3 with the same global header
+  std::vector<uint8_t> data3(16 + num_rows);
+  memcpy(&data3[0], &data[0], 16);
+  int32_t one = 1;
+  memcpy(&data3[12], &one, 4);
+  for (int32_t r = 0; r != num_rows; ++r) {
+    data3[16 + r] = r;
+  }
+  CompressedMatrix::Decompress("CM3", data3.data(), out.data());
+  for (int32_t r = 0; r != num_rows; ++r) {
+    EXPECT_NEAR(out[r], min_value + range * (1.0f / 255.0f) * r, 1e-6f) << r;
+  }
+}
+
+TEST(CompressedMatrix, Empty) {
+  CompressedMatrix m;
+  EXPECT_EQ(m.NumRows(), 0);
+  EXPECT_EQ(m.NumCols(), 0);
+  EXPECT_EQ(std::string(m.Token()), "CM");
+  EXPECT_EQ(m.Data(), std::vector<uint8_t>(16, 0));
+
+  std::vector<float> v;
+  CompressedMatrix m2(v.data(), 0, 3);
+  EXPECT_EQ(m2.Data(), std::vector<uint8_t>(16, 0));
+}
+
+TEST(CompressedMatrix, Constant) {
+  std::vector<float> m(30 * 4, -1.25f);
+  std::vector<float> out(m.size());
+  for (auto method :
+       {CompressionMethod::kSpeechFeature, CompressionMethod::kTwoByteAuto,
+        CompressionMethod::kOneByteAuto}) {
+    CompressedMatrix cm(m.data(), 30, 4, method);
+    cm.CopyToMatrix(out.data());
+    // the range is 1 + 1.25
+    EXPECT_LE(MaxAbsDiff(m, out), 2.25f / 64);
+  }
+}
+
+TEST(CompressedMatrix, FewRows) {
+  for (int32_t num_rows = 1; num_rows <= 5; ++num_rows) {
+    std::vector<float> m = RandomMatrix(num_rows, 3);
+    std::vector<float> out(m.size());
+    CompressedMatrix cm(m.data(), num_rows, 3,
+                        CompressionMethod::kSpeechFeature);
+    cm.CopyToMatrix(out.data());
+    EXPECT_LE(MaxAbsDiff(m, out), 6.0f / 63) << num_rows;
+  }
+}
+
+}  // namespace knf
@@ -0,0 +1,115 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/dct.h"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/kaldi-math.h"
+#include "kaldi-native-fbank/csrc/mel-computations.h"
+
+namespace knf {
+
+static std::vector<float> ReferenceDct(const std::vector<float> &in,
+                                       int32_t num_ceps,
+                                       const std::vector<float> &lifter) {
+  int32_t num_bins = in.size();
+  std::vector<float> ans(num_ceps);
+  for (int32_t k = 0; k != num_ceps; ++k) {
+    double norm = (k == 0) ? std::sqrt(1.0 / num_bins)
+                           : std::sqrt(2.0 / num_bins);
+    double sum = 0;
+    for (int32_t n = 0; n != num_bins; ++n) {
+      sum += in[n] * std::cos(M_PI / num_bins * (n + 0.5) * k);
+    }
+    ans[k] = norm * sum * (lifter.empty() ? 1 : lifter[k]);
+  }
+  return ans;
+}
+
+static void TestDct(int32_t num_ceps, int32_t num_bins, float lifter_q) {
+  std::vector<float> lifter;
+  if (lifter_q != 0) {
+    lifter.resize(num_ceps);
+    ComputeLifterCoeffs(lifter_q, &lifter);
+  }
+
+  Dct dct(num_ceps, num_bins, lifter);
+
+  constexpr int32_t kNumFrames = 7;
+  std::vector<float> in(kNumFrames * num_bins);
+  for (int32_t i = 0; i != static_cast<int32_t>(in.size()); ++i) {
+    in[i] = 1 + std::sin(0.3 * i) * std::cos(0.07 * i * i);
+  }
+
+  std::vector<float> batched(kNumFrames * num_ceps);
+  std::vector<float *> rows(kNumFrames);
+  for (int32_t f = 0; f != kNumFrames; ++f) {
+    rows[f] = batched.data() + f * num_ceps;
+  }
+  dct.Compute(in.data(), kNumFrames, rows.data());
+
+  for (int32_t f = 0; f != kNumFrames; ++f) {
+    std::vector<float> x(in.begin() + f * num_bins,
+                         in.begin() + (f + 1) * num_bins);
+    std::vector<float> expected = ReferenceDct(x, num_ceps, lifter);
+
+    std::vector<float> out(num_ceps);
+    dct.Compute(x.data(), out.data());
+
+    for (int32_t k = 0; k != num_ceps; ++k) {
+      EXPECT_NEAR(out[k], expected[k], 1e-4) << k;
+      EXPECT_NEAR(batched[f * num_ceps + k], expected[k], 1e-4) << k;
+    }
+
+    std::vector<float> log_x(num_bins);
+    for (int32_t n = 0; n != num_bins; ++n) {
+      log_x[n] = std::log(x[n]);
+    }
+    expected = ReferenceDct(log_x, num_ceps, lifter);
+
+    out.assign(num_ceps, 0);
+    out[0] = 100;
+    std::vector<float> tmp = x;
+    dct.ComputeLog(tmp.data(), out.data(), /*skip_c0*/ true);
+    EXPECT_EQ(out[0], 100);
+    for (int32_t k = 1; k != num_ceps; ++k) {
+      EXPECT_NEAR(out[k], expected[k], 1e-4) << k;
+    }
+  }
+}
+
+TEST(Dct, Matrix) {
+  TestDct(13, 23, 22);
+  TestDct(13, 40, 0);
+
+  EXPECT_FALSE(Dct(13, 23).UseFft());
+}
+
+TEST(Dct, Fft) {
+  TestDct(40, 40, 22);
+  TestDct(64, 64, 0);
+  TestDct(33, 64, 22);
+
+  EXPECT_TRUE(Dct(40, 40).UseFft());
+}
+
+}  // namespace knf
@@ -0,0 +1,101 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/feature-layout.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+TEST(FeatureLayout, WriteFrames) {
+  // Sizes that are and are not multiples of the tile size
+  for (int32_t num_frames : {1, 16, 37}) {
+    for (int32_t dim : {3, 32, 80}) {
+      std::vector<float> m(num_frames * dim);
+      std::vector<const float *> frames(num_frames);
+      for (int32_t t = 0; t != num_frames; ++t) {
+        for (int32_t d = 0; d != dim; ++d) {
+          m[t * dim + d] = t * 1000 + d;
+        }
+        frames[t] = m.data() + t * dim;
+      }
+
+      for (int32_t padding : {0, 5}) {
+        int32_t stride = dim + padding;
+        std::vector<float> out(num_frames * stride, -1);
+        WriteFrames(frames.data(), num_frames, dim,
+                    FeatureLayout::kFrameMajor, padding ? stride : 0,
+                    out.data());
+        for (int32_t t = 0; t != num_frames; ++t) {
+          for (int32_t d = 0; d != stride; ++d) {
+            EXPECT_EQ(out[t * stride + d], d < dim ? t * 1000 + d : -1);
+          }
+        }
+
+        stride = num_frames + padding;
+        out.assign(dim * stride, -1);
+        WriteFrames(frames.data(), num_frames, dim,
+                    FeatureLayout::kFeatureMajor, padding ? stride : 0,
+                    out.data());
+        for (int32_t d = 0; d != dim; ++d) {
+          for (int32_t t = 0; t != stride; ++t) {
+            EXPECT_EQ(out[d * stride + t], t < num_frames ? t * 1000 + d : -1);
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(FeatureLayout, OnlineFeatureGetFrames) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+
+  std::vector<float> wave(8000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i);
+  }
+
+  OnlineFbank fbank(opts);
+  fbank.AcceptWaveform(16000, wave.data(), wave.size());
+  fbank.InputFinished();
+
+  int32_t dim = fbank.Dim();
+  int32_t n = fbank.NumFramesReady() - 3;
+  ASSERT_GT(n, 0);
+
+  std::vector<float> a(n * dim);
+  fbank.GetFrames(3, n, a.data());
+
+  std::vector<float> b(dim * n);
+  fbank.GetFrames(3, n, b.data(), FeatureLayout::kFeatureMajor);
+
+  for (int32_t t = 0; t != n; ++t) {
+    const float *p = fbank.GetFrame(3 + t);
+    for (int32_t d = 0; d != dim; ++d) {
+      EXPECT_EQ(a[t * dim + d], p[d]);
+      EXPECT_EQ(b[d * n + t], p[d]);
+    }
+  }
+}
+
+}  // namespace knf
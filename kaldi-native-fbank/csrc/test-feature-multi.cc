@@ -0,0 +1,168 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/feature-multi.h"
+
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/mel-computations.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+template <class C>
+static void CheckHead(const OnlineMultiFeature &multi, int32_t head,
+                      const typename C::Options &opts,
+                      const std::vector<float> &wave) {
+  OnlineGenericBaseFeature<C> feature(opts);
+  feature.AcceptWaveform(16000, wave.data(), wave.size());
+  feature.InputFinished();
+
+  const MultiFeatureComputer &computer = multi.GetComputer();
+  ASSERT_EQ(computer.HeadDim(head), feature.Dim());
+  ASSERT_EQ(multi.NumFramesReady(), feature.NumFramesReady());
+
+  int32_t offset = computer.HeadOffset(head);
+  for (int32_t i = 0; i != feature.NumFramesReady(); ++i) {
+    std::vector<float> expected(feature.GetFrame(i),
+                                feature.GetFrame(i) + feature.Dim());
+    std::vector<float> actual(multi.GetFrame(i) + offset,
+                              multi.GetFrame(i) + offset + feature.Dim());
+    EXPECT_EQ(actual, expected) << head << " " << i;
+  }
+}
+
+TEST(MultiFeatureComputer, CompareWithSeparateComputers) {
+  MultiFeatureOptions opts;
+  opts.frame_opts.dither = 0;
+
+  FbankOptions fbank_opts;
+  fbank_opts.mel_opts.num_bins = 80;
+  opts.fbank.push_back(fbank_opts);
+
+  // Energy after windowing, put last
+  fbank_opts.mel_opts.num_bins = 40;
+  fbank_opts.use_energy = true;
+  fbank_opts.raw_energy = false;
+  fbank_opts.htk_compat = true;
+  opts.fbank.push_back(fbank_opts);
+
+  // Linear magnitude
+  fbank_opts.use_energy = false;
+  fbank_opts.use_log_fbank = false;
+  fbank_opts.use_power = false;
+  opts.fbank.push_back(fbank_opts);
+
+  MfccOptions mfcc_opts;
+  opts.mfcc.push_back(mfcc_opts);
+
+  opts.use_power_spectrum = true;
+  opts.use_energy = true;
+
+  std::vector<float> wave(8000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i) + 0.5f * std::cos(0.37f * i);
+  }
+
+  OnlineMultiFeature multi(opts);
+  multi.AcceptWaveform(16000, wave.data(), wave.size());
+  multi.InputFinished();
+
+  const MultiFeatureComputer &computer = multi.GetComputer();
+  int32_t num_fft_bins = opts.frame_opts.PaddedWindowSize() / 2 + 1;
+  ASSERT_EQ(computer.NumHeads(), 6);
+  EXPECT_EQ(multi.Dim(), 80 + 41 + 40 + 13 + num_fft_bins + 1);
+
+  // The frame_opts of each head is replaced by the shared one
+  for (int32_t h = 0; h != 3; ++h) {
+    opts.fbank[h].frame_opts = opts.frame_opts;
+    CheckHead<FbankComputer>(multi, h, opts.fbank[h], wave);
+  }
+
+  opts.mfcc[0].frame_opts = opts.frame_opts;
+  CheckHead<MfccComputer>(multi, 3, opts.mfcc[0], wave);
+
+  // Applying mel banks to the power spectrum gives linear fbank
+  fbank_opts = FbankOptions();
+  fbank_opts.frame_opts = opts.frame_opts;
+  fbank_opts.use_log_fbank = false;
+  fbank_opts.use_energy = true;  // raw, which is also the last head
+
+  OnlineFbank fbank(fbank_opts);
+  fbank.AcceptWaveform(16000, wave.data(), wave.size());
+  fbank.InputFinished();
+
+  auto mel_banks = MelBanksCache::Get(fbank_opts.mel_opts, opts.frame_opts, 1);
+  int32_t num_bins = fbank_opts.mel_opts.num_bins;
+  std::vector<float> mel(num_bins);
+  for (int32_t i = 0; i != multi.NumFramesReady(); ++i) {
+    const float *power = multi.GetFrame(i) + computer.HeadOffset(4);
+    mel_banks->Compute(power, mel.data());
+
+    const float *expected = fbank.GetFrame(i);
+    for (int32_t k = 0; k != num_bins; ++k) {
+      EXPECT_NEAR(mel[k], expected[k + 1], 1e-4f * expected[k + 1] + 1e-6f)
+          << i << " " << k;
+    }
+
+    EXPECT_EQ(multi.GetFrame(i)[computer.HeadOffset(5)], expected[0]) << i;
+  }
+}
+
+// Without a power spectrum head, the power spectrum is computed only for the
+// fft bins used by the heads
+TEST(MultiFeatureComputer, BandLimitedHeads) {
+  MultiFeatureOptions opts;
+  opts.frame_opts.dither = 0;
+
+  FbankOptions fbank_opts;
+  fbank_opts.mel_opts.num_bins = 23;
+  fbank_opts.mel_opts.high_freq = 4000;
+  opts.fbank.push_back(fbank_opts);
+
+  fbank_opts.mel_opts.low_freq = 1000;
+  fbank_opts.mel_opts.high_freq = 0;
+  fbank_opts.use_power = false;
+  opts.fbank.push_back(fbank_opts);
+
+  MfccOptions mfcc_opts;
+  mfcc_opts.mel_opts.low_freq = 300;
+  mfcc_opts.mel_opts.high_freq = 3400;
+  opts.mfcc.push_back(mfcc_opts);
+
+  std::vector<float> wave(8000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i) + 0.5f * std::cos(0.37f * i);
+  }
+
+  OnlineMultiFeature multi(opts);
+  multi.AcceptWaveform(16000, wave.data(), wave.size());
+  multi.InputFinished();
+
+  for (int32_t h = 0; h != 2; ++h) {
+    opts.fbank[h].frame_opts = opts.frame_opts;
+    CheckHead<FbankComputer>(multi, h, opts.fbank[h], wave);
+  }
+
+  opts.mfcc[0].frame_opts = opts.frame_opts;
+  CheckHead<MfccComputer>(multi, 2, opts.mfcc[0], wave);
+}
+
+}  // namespace knf
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/feature-spectrogram.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+template <class C>
+static std::vector<std::vector<float>> ComputeFeatures(
+    const typename C::Options &opts, const std::vector<float> &wave) {
+  OnlineGenericBaseFeature<C> feature(opts);
+  feature.AcceptWaveform(16000, wave.data(), wave.size());
+  feature.InputFinished();
+
+  std::vector<std::vector<float>> ans;
+  for (int32_t i = 0; i != feature.NumFramesReady(); ++i) {
+    ans.emplace_back(feature.GetFrame(i), feature.GetFrame(i) + feature.Dim());
+  }
+  return ans;
+}
+
+TEST(SpectrogramComputer, Compute) {
+  std::vector<float> wave(8000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i) + 0.5f * std::cos(0.37f * i);
+  }
+
+  // The power spectrum of MultiFeatureComputer is the reference
+  MultiFeatureOptions multi_opts;
+  multi_opts.frame_opts.dither = 0;
+  multi_opts.use_power_spectrum = true;
+  auto power = ComputeFeatures<MultiFeatureComputer>(multi_opts, wave);
+
+  // The energy of fbank is the reference for the zeroth bin
+  FbankOptions fbank_opts;
+  fbank_opts.frame_opts = multi_opts.frame_opts;
+  fbank_opts.use_energy = true;
+  auto raw_energy = ComputeFeatures<FbankComputer>(fbank_opts, wave);
+
+  fbank_opts.raw_energy = false;
+  auto energy = ComputeFeatures<FbankComputer>(fbank_opts, wave);
+
+  SpectrogramOptions opts;
+  opts.frame_opts = multi_opts.frame_opts;
+  opts.use_energy = false;
+  opts.use_log = false;
+  auto a = ComputeFeatures<SpectrogramComputer>(opts, wave);
+  EXPECT_EQ(a, power);
+
+  opts.use_energy = true;
+  opts.use_log = true;
+  auto b = ComputeFeatures<SpectrogramComputer>(opts, wave);
+
+  opts.raw_energy = false;
+  auto c = ComputeFeatures<SpectrogramComputer>(opts, wave);
+
+  // 4000 Hz is bin 128 of the 512-point fft
+  opts.high_freq = -4000;
+  auto d = ComputeFeatures<SpectrogramComputer>(opts, wave);
+
+  ASSERT_EQ(b.size(), power.size());
+  ASSERT_EQ(d.size(), power.size());
+  for (size_t i = 0; i != power.size(); ++i) {
+    ASSERT_EQ(b[i].size(), 257u);
+    EXPECT_EQ(b[i][0], raw_energy[i][0]);
+    EXPECT_EQ(c[i][0], energy[i][0]);
+
+    for (int32_t k = 1; k != 257; ++k) {
+      float eps = std::numeric_limits<float>::epsilon();
+      float expected = std::log(std::max(power[i][k], eps));
+      EXPECT_NEAR(b[i][k], expected, 1e-5f * std::max(std::abs(expected), 1.f))
+          << i << " " << k;
+    }
+
+    ASSERT_EQ(d[i].size(), 129u);
+    EXPECT_TRUE(std::equal(d[i].begin(), d[i].end(), c[i].begin())) << i;
+  }
+}
+
+}  // namespace knf
@@ -0,0 +1,162 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/feature-window.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace knf {
+
+TEST(WindowCache, Share) {
+  int32_t size = WindowCache::Size();
+  {
+    FeatureWindowFunction a("povey", 400);
+    FeatureWindowFunction b("povey", 400);
+    EXPECT_EQ(&a.GetWindow(), &b.GetWindow());
+    EXPECT_EQ(a.GetWindow(), GetWindow("povey", 400));
+
+    // blackman_coeff is ignored for windows other than blackman
+    FeatureWindowFunction c("povey", 400, 0.5);
+    EXPECT_EQ(&a.GetWindow(), &c.GetWindow());
+
+    FeatureWindowFunction d("blackman", 400, 0.42);
+    FeatureWindowFunction e("blackman", 400, 0.5);
+    EXPECT_NE(&d.GetWindow(), &e.GetWindow());
+
+    FeatureWindowFunction f("povey", 512);
+    EXPECT_NE(&a.GetWindow(), &f.GetWindow());
+
+    EXPECT_EQ(WindowCache::Size(), size + 4);
+  }
+
+  // Entries are released with the last user
+  EXPECT_EQ(WindowCache::Size(), size);
+}
+
+// It is the non-fused implementation of ProcessWindow()
+static void ProcessWindowReference(const FrameExtractionOptions &opts,
+                                   const std::vector<float> &window_function,
+                                   float *d, float *log_energy) {
+  int32_t n = opts.WindowSize();
+  if (opts.remove_dc_offset) {
+    float sum = 0;
+    for (int32_t i = 0; i != n; ++i) {
+      sum += d[i];
+    }
+    float mean = sum / n;
+    for (int32_t i = 0; i != n; ++i) {
+      d[i] -= mean;
+    }
+  }
+
+  if (log_energy) {
+    float energy = 0;
+    for (int32_t i = 0; i != n; ++i) {
+      energy += d[i] * d[i];
+    }
+    *log_energy = std::log(energy);
+  }
+
+  for (int32_t i = n - 1; i > 0; --i) {
+    d[i] -= opts.preemph_coeff * d[i - 1];
+  }
+  d[0] -= opts.preemph_coeff * d[0];
+
+  for (int32_t i = 0; i != n; ++i) {
+    d[i] *= window_function[i];
+  }
+}
+
+TEST(FeatureWindowFunction, ProcessWindow) {
+  std::mt19937 gen(20260);
+  std::uniform_real_distribution<float> dist(-1, 1);
+
+  FrameExtractionOptions opts;
+  opts.dither = 0;
+  FeatureWindowFunction window_function(opts);
+
+  for (bool remove_dc_offset : {true, false}) {
+    for (float preemph_coeff : {0.0f, 0.97f}) {
+      for (bool need_energy : {true, false}) {
+        opts.remove_dc_offset = remove_dc_offset;
+        opts.preemph_coeff = preemph_coeff;
+
+        std::vector<float> a(opts.WindowSize());
+        for (auto &f : a) {
+          f = dist(gen) + 0.25f;
+        }
+        std::vector<float> b = a;
+
+        float energy_a = 0;
+        float energy_b = 0;
+        ProcessWindow(opts, window_function, a.data(),
+                      need_energy ? &energy_a : nullptr);
+        ProcessWindowReference(opts, window_function.GetWindow(), b.data(),
+                               need_energy ? &energy_b : nullptr);
+
+        // The reductions may differ in rounding depending on the SIMD level
+        for (int32_t i = 0; i != static_cast<int32_t>(a.size()); ++i) {
+          EXPECT_NEAR(a[i], b[i], 1e-5) << i;
+        }
+        EXPECT_NEAR(energy_a, energy_b, 1e-4);
+      }
+    }
+  }
+}
+
+TEST(FeatureWindowFunction, FastDither) {
+  FrameExtractionOptions opts;
+  opts.dither = 1;
+  opts.preemph_coeff = 0;
+  opts.remove_dc_offset = false;
+  opts.window_type = "rectangular";
+  opts.accuracy = "fast";
+  FeatureWindowFunction window_function(opts);
+  EXPECT_TRUE(window_function.UseFastMath());
+
+  // Mean and variance of the dithering noise
+  double sum = 0;
+  double sum2 = 0;
+  int32_t n = 0;
+  std::vector<float> scratch;
+  const float *p = nullptr;
+  for (int32_t f = 0; f != 100; ++f) {
+    std::vector<float> d(opts.WindowSize());
+    ProcessWindow(opts, window_function, d.data(), nullptr, &scratch);
+    for (float x : d) {
+      sum += x;
+      sum2 += x * x;
+    }
+    n += d.size();
+
+    // The scratch buffer is allocated only once
+    if (f == 0) {
+      p = scratch.data();
+    }
+    EXPECT_EQ(scratch.data(), p);
+  }
+
+  EXPECT_NEAR(sum / n, 0, 0.02);
+  EXPECT_NEAR(sum2 / n, 1, 0.03);
+}
+
+}  // namespace knf
@@ -0,0 +1,222 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/kaldi-io.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+static std::string ReadFile(const std::string &filename) {
+  std::ifstream is(filename, std::ios::binary);
+  std::ostringstream os;
+  os << is.rdbuf();
+  return os.str();
+}
+
+TEST(ArkWriter, Format) {
+  std::vector<float> m = {1, 2, 3, 4, 5, 6};
+  {
+    ArkWriter writer("test-kaldi-io-format.ark", "test-kaldi-io-format.scp");
+    writer.Write("a", m.data(), 2, 3);
+    writer.Write("bb", m.data(), 1, 2);
+  }
+
+  std::string expected;
+  auto append = [&expected](const std::string &key, int32_t rows,
+                            int32_t cols, const float *data) {
+    expected += key + " ";
+    expected.append("\0BFM \4", 6);
+    expected.append(reinterpret_cast<const char *>(&rows), 4);
+    expected += '\4';
+    expected.append(reinterpret_cast<const char *>(&cols), 4);
+    expected.append(reinterpret_cast<const char *>(data),
+                    rows * cols * sizeof(float));
+  };
+  append("a", 2, 3, m.data());
+  append("bb", 1, 2, m.data());
+
+  EXPECT_EQ(ReadFile("test-kaldi-io-format.ark"), expected);
+
+  // 2 + 15 + 24 + 3 = 44
+  EXPECT_EQ(ReadFile("test-kaldi-io-format.scp"),
+            "a test-kaldi-io-format.ark:2\n"
+            "bb test-kaldi-io-format.ark:44\n");
+
+  std::remove("test-kaldi-io-format.ark");
+  std::remove("test-kaldi-io-format.scp");
+}
+
+TEST(ArkReader, RoundTrip) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+  OnlineFbank fbank(opts);
+
+  std::vector<float> wave(16000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i);
+  }
+  fbank.AcceptWaveform(16000, wave.data(), wave.size());
+  fbank.InputFinished();
+
+  std::vector<float> m = {1, 2, 3, 4, 5, 6};
+  {
+    ArkWriter writer("test-kaldi-io.ark");
+    writer.Write("fbank", fbank);
+    writer.Write("empty", nullptr, 0, 0);
+    writer.Write("m", m.data(), 3, 2);
+  }
+
+  ArkReader reader("test-kaldi-io.ark");
+  EXPECT_EQ(reader.Keys(), (std::vector<std::string>{"fbank", "empty", "m"}));
+
+  EXPECT_TRUE(reader.Contains("m"));
+  EXPECT_FALSE(reader.Contains("n"));
+  EXPECT_EQ(reader.Get("n").data, nullptr);
+
+  // The data of "m" starts at an odd offset in the file, so it is copied
+  // into an aligned buffer once
+  FloatMatrixView v = reader.Get("m");
+  ASSERT_EQ(v.num_rows, 3);
+  ASSERT_EQ(v.num_cols, 2);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(v.data) % alignof(float), 0);
+  EXPECT_EQ(std::vector<float>(v.data, v.data + 6), m);
+  EXPECT_EQ(reader.Get("m").data, v.data);
+
+  v = reader.Get("empty");
+  EXPECT_NE(v.data, nullptr);
+  EXPECT_EQ(v.num_rows, 0);
+  EXPECT_EQ(v.num_cols, 0);
+
+  v = reader.Get("fbank");
+  ASSERT_EQ(v.num_rows, fbank.NumFramesReady());
+  ASSERT_EQ(v.num_cols, fbank.Dim());
+  for (int32_t i = 0; i != v.num_rows; ++i) {
+    const float *f = fbank.GetFrame(i);
+    EXPECT_EQ(std::vector<float>(f, f + v.num_cols),
+              std::vector<float>(v.data + i * v.num_cols,
+                                 v.data + (i + 1) * v.num_cols));
+  }
+
+  std::remove("test-kaldi-io.ark");
+}
+
+TEST(ArkReader, Compressed) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+  OnlineFbank fbank(opts);
+
+  std::vector<float> wave(16000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i);
+  }
+  fbank.AcceptWaveform(16000, wave.data(), wave.size());
+  fbank.InputFinished();
+
+  std::vector<float> m = {1, 2, 3, 4, 5, 6};
+  CompressedMatrix cm3(m.data(), 3, 2, CompressionMethod::kOneByteAuto);
+  {
+    ArkWriter writer("test-kaldi-io-compressed.ark",
+                     "test-kaldi-io-compressed.scp");
+    writer.WriteCompressed("fbank", fbank);
+    writer.Write("m", m.data(), 3, 2);
+    writer.Write("cm3", cm3);
+    writer.Write("empty", CompressedMatrix());
+  }
+
+  // Size of "fbank " + "\0BCM " + header + column headers + bytes
+  int32_t offset = 6 + 5 + 16 + fbank.Dim() * 8 +
+                   fbank.NumFramesReady() * fbank.Dim();
+  EXPECT_EQ(ReadFile("test-kaldi-io-compressed.scp"),
+            "fbank test-kaldi-io-compressed.ark:6\n"
+            "m test-kaldi-io-compressed.ark:" +
+                std::to_string(offset + 2) +
+                "\n"
+                "cm3 test-kaldi-io-compressed.ark:" +
+                std::to_string(offset + 2 + 15 + 24 + 4) +
+                "\n"
+                "empty test-kaldi-io-compressed.ark:" +
+                std::to_string(offset + 2 + 15 + 24 + 4 + 6 + 16 + 6 + 6) +
+                "\n");
+
+  ArkReader reader("test-kaldi-io-compressed.ark");
+  EXPECT_EQ(reader.Keys(),
+            (std::vector<std::string>{"fbank", "m", "cm3", "empty"}));
+  EXPECT_TRUE(reader.IsCompressed("fbank"));
+  EXPECT_FALSE(reader.IsCompressed("m"));
+
+  FloatMatrixView v = reader.Get("fbank");
+  EXPECT_EQ(v.data, nullptr);
+  EXPECT_EQ(v.num_rows, fbank.NumFramesReady());
+  EXPECT_EQ(v.num_cols, fbank.Dim());
+
+  std::vector<float> out;
+  int32_t num_rows = 0;
+  int32_t num_cols = 0;
+  EXPECT_FALSE(reader.Read("n", &out, &num_rows, &num_cols));
+
+  ASSERT_TRUE(reader.Read("fbank", &out, &num_rows, &num_cols));
+  ASSERT_EQ(num_rows, fbank.NumFramesReady());
+  ASSERT_EQ(num_cols, fbank.Dim());
+  float max_diff = 0;
+  for (int32_t i = 0; i != num_rows; ++i) {
+    const float *f = fbank.GetFrame(i);
+    for (int32_t k = 0; k != num_cols; ++k) {
+      max_diff = std::max(max_diff, std::abs(f[k] - out[i * num_cols + k]));
+    }
+  }
+  EXPECT_LT(max_diff, 0.5f);
+
+  ASSERT_TRUE(reader.Read("m", &out, &num_rows, &num_cols));
+  EXPECT_EQ(out, m);
+
+  std::vector<float> expected(6);
+  cm3.CopyToMatrix(expected.data());
+  ASSERT_TRUE(reader.Read("cm3", &out, &num_rows, &num_cols));
+  EXPECT_EQ(num_rows, 3);
+  EXPECT_EQ(num_cols, 2);
+  EXPECT_EQ(out, expected);
+
+  ASSERT_TRUE(reader.Read("empty", &out, &num_rows, &num_cols));
+  EXPECT_EQ(num_rows, 0);
+  EXPECT_EQ(num_cols, 0);
+  EXPECT_TRUE(out.empty());
+
+  std::remove("test-kaldi-io-compressed.ark");
+  std::remove("test-kaldi-io-compressed.scp");
+}
+
+TEST(ArkReader, Empty) {
+  { ArkWriter writer("test-kaldi-io-empty.ark"); }
+
+  ArkReader reader("test-kaldi-io-empty.ark");
+  EXPECT_TRUE(reader.Keys().empty());
+
+  std::remove("test-kaldi-io-empty.ark");
+}
+
+}  // namespace knf
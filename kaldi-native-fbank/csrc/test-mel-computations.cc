@@ -0,0 +1,123 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/mel-computations.h"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/feature-fbank.h"
+#include "kaldi-native-fbank/csrc/feature-functions.h"
+#include "kaldi-native-fbank/csrc/feature-window.h"
+#include "kaldi-native-fbank/csrc/kaldi-math.h"
+
+namespace knf {
+
+TEST(MelBanksCache, Share) {
+  EXPECT_EQ(MelBanksCache::Size(), 0);
+
+  MelBanksOptions opts;
+  FrameExtractionOptions frame_opts;
+
+  auto a = MelBanksCache::Get(opts, frame_opts, 1.0f);
+  auto b = MelBanksCache::Get(opts, frame_opts, 1.0f);
+  EXPECT_EQ(a.get(), b.get());
+  EXPECT_EQ(MelBanksCache::Size(), 1);
+
+  // a different key
+  opts.num_bins = 80;
+  auto c = MelBanksCache::Get(opts, frame_opts, 1.0f);
+  EXPECT_NE(a.get(), c.get());
+  EXPECT_EQ(MelBanksCache::Size(), 2);
+
+  frame_opts.samp_freq = 8000;
+  auto d = MelBanksCache::Get(opts, frame_opts, 1.0f);
+  EXPECT_NE(c.get(), d.get());
+  EXPECT_EQ(MelBanksCache::Size(), 3);
+
+  a.reset();
+  b.reset();
+  c.reset();
+  d.reset();
+  EXPECT_EQ(MelBanksCache::Size(), 0);
+}
+
+TEST(MelBanksCache, Computers) {
+  FbankOptions opts;
+  opts.mel_opts.num_bins = 80;
+
+  {
+    FbankComputer a(opts);
+    FbankComputer b(opts);
+    EXPECT_EQ(MelBanksCache::Size(), 1);
+  }
+
+  EXPECT_EQ(MelBanksCache::Size(), 0);
+}
+
+static void TestComputeFromFft(const MelBanks &mel_banks, int32_t n) {
+  std::mt19937 gen(20260);
+  std::uniform_real_distribution<float> dist(-10, 10);
+
+  std::vector<float> fft(n);
+  for (auto &f : fft) {
+    f = dist(gen);
+  }
+
+  for (bool use_power : {true, false}) {
+    std::vector<float> power = fft;
+    ComputePowerSpectrum(&power);
+    if (!use_power) {
+      Sqrt(power.data(), n / 2 + 1);
+    }
+    std::vector<float> expected(mel_banks.NumBins());
+    mel_banks.Compute(power.data(), expected.data());
+
+    std::vector<float> buf = fft;
+    std::vector<float> mel(mel_banks.NumBins());
+    mel_banks.ComputeFromFft(buf.data(), n, use_power, mel.data());
+
+    EXPECT_EQ(mel, expected) << use_power;
+  }
+}
+
+TEST(MelBanks, ComputeFromFft) {
+  FrameExtractionOptions frame_opts;
+  MelBanksOptions opts;
+  opts.num_bins = 80;
+  int32_t n = frame_opts.PaddedWindowSize();
+
+  TestComputeFromFft(MelBanks(opts, frame_opts, 1.0f), n);
+
+  opts.low_freq = 0;
+  opts.is_librosa = true;
+  TestComputeFromFft(MelBanks(opts, frame_opts, 1.0f), n);
+
+  // Including the first and the last fft bin
+  int32_t num_cols = n / 2 + 1;
+  std::vector<float> weights(2 * num_cols);
+  weights[0] = 0.5f;
+  weights[1] = 1;
+  weights[2 * num_cols - 1] = 2;
+  weights[2 * num_cols - 5] = 0.25f;
+  TestComputeFromFft(MelBanks(weights.data(), 2, num_cols), n);
+}
+
+}  // namespace knf
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/multi-stream-online-feature.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/test-utils.h"
+
+namespace knf {
+
+template <class C>
+static void TestMultiStream(const typename C::Options &opts,
+                            const OnlineCmvnOptions &cmvn_opts = {}) {
+  constexpr int32_t kNumStreams = 5;
+  FeatureExtractorConfig<C> config(opts, cmvn_opts);
+  float samp_freq = opts.frame_opts.samp_freq;
+
+  std::vector<std::vector<float>> waves;
+  for (int32_t i = 0; i != kNumStreams; ++i) {
+    waves.push_back(GetTestWave(4000 + 1234 * i, 0, 0.01f * (i + 1)));
+  }
+
+  MultiStreamOnlineFeature<C> multi(config, kNumStreams);
+  EXPECT_EQ(multi.NumStreams(), kNumStreams);
+
+  // Feed the streams with chunks of different sizes
+  std::vector<int32_t> offsets(kNumStreams);
+  bool done = false;
+  while (!done) {
+    done = true;
+    for (int32_t i = 0; i != kNumStreams; ++i) {
+      int32_t chunk = 100 + 77 * i;
+      int32_t n = std::min<int32_t>(chunk, waves[i].size() - offsets[i]);
+      if (n == 0) {
+        continue;
+      }
+      multi.AcceptWaveform(i, samp_freq, waves[i].data() + offsets[i], n);
+      offsets[i] += n;
+      done = false;
+    }
+    multi.ComputeReady();
+  }
+
+  for (int32_t i = 0; i != kNumStreams; ++i) {
+    multi.InputFinished(i);
+  }
+  multi.ComputeReady();
+  EXPECT_EQ(multi.ComputeReady(), 0);
+
+  for (int32_t i = 0; i != kNumStreams; ++i) {
+    OnlineGenericBaseFeature<C> expected(config);
+    expected.AcceptWaveform(samp_freq, waves[i].data(), waves[i].size());
+    expected.InputFinished();
+
+    int32_t num_frames = expected.NumFramesReady();
+    ASSERT_EQ(multi.NumFramesReady(i), num_frames);
+    EXPECT_TRUE(multi.IsLastFrame(i, num_frames - 1));
+
+    for (int32_t f = 0; f != num_frames; ++f) {
+      if (expected.OutputDtype() != FeatureDtype::kFloat32) {
+        const uint16_t *a = expected.GetHalfFrame(f);
+        const uint16_t *b = multi.GetHalfFrame(i, f);
+        for (int32_t d = 0; d != expected.Dim(); ++d) {
+          EXPECT_EQ(a[d], b[d]) << i << ", " << f << ", " << d;
+        }
+        continue;
+      }
+
+      const float *a = expected.GetFrame(f);
+      const float *b = multi.GetFrame(i, f);
+      for (int32_t d = 0; d != expected.Dim(); ++d) {
+        EXPECT_EQ(a[d], b[d]) << i << ", " << f << ", " << d;
+      }
+    }
+  }
+}
+
+TEST(MultiStreamOnlineFeature, Fbank) {
+  FbankOptions opts = GetTestFbankOptions(80);
+  TestMultiStream<FbankComputer>(opts);
+
+  opts.frame_opts.snip_edges = false;
+  opts.use_energy = true;
+  TestMultiStream<FbankComputer>(opts);
+
+  opts.frame_opts.output_dtype = "float16";
+  TestMultiStream<FbankComputer>(opts);
+
+  // The energy is the last element and is computed before windowing
+  opts.frame_opts.output_dtype = "float32";
+  opts.htk_compat = true;
+  opts.raw_energy = true;
+  TestMultiStream<FbankComputer>(opts);
+}
+
+TEST(MultiStreamOnlineFeature, Cmvn) {
+  FbankOptions opts = GetTestFbankOptions(23);
+
+  // Each stream keeps its own statistics
+  OnlineCmvnOptions cmvn_opts;
+  cmvn_opts.mode = "prefix";
+  cmvn_opts.normalize_variance = true;
+  TestMultiStream<FbankComputer>(opts, cmvn_opts);
+
+  cmvn_opts.mode = "sliding";
+  cmvn_opts.cmn_window = 20;
+  TestMultiStream<FbankComputer>(opts, cmvn_opts);
+}
+
+TEST(MultiStreamOnlineFeature, Mfcc) {
+  MfccOptions opts;
+  opts.frame_opts.dither = 0;
+  TestMultiStream<MfccComputer>(opts);
+
+  opts.frame_opts.output_dtype = "bfloat16";
+  TestMultiStream<MfccComputer>(opts);
+
+  // The DCT is computed with an FFT instead of the matrix
+  opts.frame_opts.output_dtype = "float32";
+  opts.mel_opts.num_bins = 40;
+  opts.num_ceps = 40;
+  TestMultiStream<MfccComputer>(opts);
+}
+
+TEST(MultiStreamOnlineFeature, MfccEnergy) {
+  MfccOptions opts;
+  opts.frame_opts.dither = 0;
+  opts.raw_energy = false;
+  TestMultiStream<MfccComputer>(opts);
+
+  opts.htk_compat = true;
+  TestMultiStream<MfccComputer>(opts);
+
+  opts.use_energy = false;
+  TestMultiStream<MfccComputer>(opts);
+}
+
+TEST(MultiStreamOnlineFeature, Whisper) {
+  WhisperFeatureOptions opts;
+  TestMultiStream<WhisperFeatureComputer>(opts);
+
+  opts.log_mel = true;
+  TestMultiStream<WhisperFeatureComputer>(opts);
+}
+
+TEST(MultiStreamOnlineFeature, AddRemove) {
+  FbankOptions opts = GetTestFbankOptions(23);
+
+  MultiStreamOnlineFbank multi(opts);
+  EXPECT_EQ(multi.NumStreams(), 0);
+  EXPECT_EQ(multi.ComputeReady(), 0);
+
+  int32_t a = multi.AddStream();
+  int32_t b = multi.AddStream();
+  EXPECT_EQ(a, 0);
+  EXPECT_EQ(b, 1);
+
+  multi.RemoveStream(a);
+  EXPECT_EQ(multi.NumStreams(), 1);
+
+  // the ID of a removed stream is reused
+  EXPECT_EQ(multi.AddStream(), a);
+  EXPECT_EQ(multi.NumStreams(), 2);
+
+  std::vector<float> wave = GetTestWave(16000, 0, 0.02f);
+  multi.AcceptWaveform(b, 16000, wave.data(), wave.size());
+  EXPECT_EQ(multi.NumFramesReady(b), 0);
+
+  int32_t n = multi.ComputeReady();
+  EXPECT_GT(n, 0);
+  EXPECT_EQ(multi.NumFramesReady(a), 0);
+  EXPECT_EQ(multi.NumFramesReady(b), n);
+}
+
+}  // namespace knf
@@ -0,0 +1,211 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/online-cmvn.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/test-utils.h"
+
+namespace knf {
+
+static std::vector<std::vector<float>> ComputeFbank(
+    const OnlineCmvnOptions &cmvn_opts) {
+  FbankOptions opts = GetTestFbankOptions(23);
+
+  OnlineFbank fbank(opts, cmvn_opts);
+  std::vector<float> wave = GetTestWave(16000, 0.1f);
+
+  // Feed it in chunks so that frames are computed in several calls
+  for (size_t i = 0; i < wave.size(); i += 1234) {
+    int32_t n = std::min<size_t>(1234, wave.size() - i);
+    fbank.AcceptWaveform(16000, wave.data() + i, n);
+  }
+  fbank.InputFinished();
+
+  std::vector<std::vector<float>> ans;
+  for (int32_t i = 0; i != fbank.NumFramesReady(); ++i) {
+    const float *p = fbank.GetFrame(i);
+    ans.emplace_back(p, p + fbank.Dim());
+  }
+  return ans;
+}
+
+// Normalize frame t with the stats of frames [begin(t), t]
+template <typename F>
+static std::vector<std::vector<float>> Normalize(
+    const std::vector<std::vector<float>> &feats, bool normalize_variance,
+    F begin) {
+  int32_t dim = feats[0].size();
+  std::vector<std::vector<float>> ans = feats;
+  for (int32_t t = 0; t != static_cast<int32_t>(feats.size()); ++t) {
+    int32_t b = begin(t);
+    for (int32_t d = 0; d != dim; ++d) {
+      double sum = 0;
+      double sum_sq = 0;
+      for (int32_t k = b; k <= t; ++k) {
+        sum += feats[k][d];
+        sum_sq += static_cast<double>(feats[k][d]) * feats[k][d];
+      }
+      double mean = sum / (t - b + 1);
+      double var = std::max(sum_sq / (t - b + 1) - mean * mean, 1.0e-20);
+      ans[t][d] = feats[t][d] - mean;
+      if (normalize_variance) {
+        ans[t][d] /= std::sqrt(var);
+      }
+    }
+  }
+  return ans;
+}
+
+static void ExpectNear(const std::vector<std::vector<float>> &a,
+                       const std::vector<std::vector<float>> &b, float tol) {
+  ASSERT_EQ(a.size(), b.size());
+  for (size_t t = 0; t != a.size(); ++t) {
+    for (size_t d = 0; d != a[t].size(); ++d) {
+      EXPECT_NEAR(a[t][d], b[t][d], tol) << t << " " << d;
+    }
+  }
+}
+
+TEST(OnlineCmvn, None) {
+  OnlineCmvnOptions cmvn_opts;
+  EXPECT_FALSE(OnlineCmvn(cmvn_opts, 3).Enabled());
+
+  std::vector<std::vector<float>> feats = ComputeFbank(cmvn_opts);
+  std::vector<float> f = feats[10];
+  OnlineCmvn(cmvn_opts, f.size()).Apply(f.data());
+  EXPECT_EQ(f, feats[10]);
+}
+
+TEST(OnlineCmvn, Prefix) {
+  std::vector<std::vector<float>> raw = ComputeFbank({});
+
+  OnlineCmvnOptions cmvn_opts;
+  cmvn_opts.mode = "prefix";
+  ExpectNear(ComputeFbank(cmvn_opts),
+             Normalize(raw, false, [](int32_t) { return 0; }), 1e-4);
+
+  cmvn_opts.normalize_variance = true;
+  // The first frame has a variance of 0 and is mapped to 0
+  ExpectNear(ComputeFbank(cmvn_opts),
+             Normalize(raw, true, [](int32_t) { return 0; }), 1e-3);
+}
+
+TEST(OnlineCmvn, Sliding) {
+  std::vector<std::vector<float>> raw = ComputeFbank({});
+
+  OnlineCmvnOptions cmvn_opts;
+  cmvn_opts.mode = "sliding";
+  cmvn_opts.cmn_window = 10;
+  auto begin = [](int32_t t) { return std::max(0, t - 10 + 1); };
+  ExpectNear(ComputeFbank(cmvn_opts), Normalize(raw, false, begin), 1e-4);
+
+  cmvn_opts.normalize_variance = true;
+  ExpectNear(ComputeFbank(cmvn_opts), Normalize(raw, true, begin), 1e-3);
+
+  // A window longer than the input is the same as the prefix
+  cmvn_opts.cmn_window = 1000;
+  std::vector<std::vector<float>> a = ComputeFbank(cmvn_opts);
+  cmvn_opts.mode = "prefix";
+  EXPECT_EQ(a, ComputeFbank(cmvn_opts));
+}
+
+TEST(OnlineCmvn, Global) {
+  int32_t dim = 3;
+  // 4 frames: mean = {1, 2, 3}, var = {1, 4, 0.25}
+  std::vector<double> stats = {4, 8, 12, 4, 4 * (1 + 1), 4 * (4 + 4),
+                               4 * (9 + 0.25), 0};
+
+  {
+    std::ofstream os("test-online-cmvn.txt");
+    os << "  [\n  4 8 12 4 \n  8 32 37 0 ]\n";
+  }
+
+  {
+    // Binary format of Kaldi
+    std::ofstream os("test-online-cmvn.bin", std::ios::binary);
+    int32_t rows = 2;
+    int32_t cols = dim + 1;
+    os.write("\0BDM \4", 6);
+    os.write(reinterpret_cast<const char *>(&rows), 4);
+    os.write("\4", 1);
+    os.write(reinterpret_cast<const char *>(&cols), 4);
+    os.write(reinterpret_cast<const char *>(stats.data()),
+             stats.size() * sizeof(double));
+  }
+
+  for (const char *filename :
+       {"test-online-cmvn.txt", "test-online-cmvn.bin"}) {
+    OnlineCmvnOptions opts;
+    opts.mode = "global";
+    opts.global_cmvn_stats = filename;
+
+    OnlineCmvn cmvn(opts, dim);
+    EXPECT_TRUE(cmvn.Enabled());
+    std::vector<float> f = {2, 4, 3.5};
+    cmvn.Apply(f.data());
+    EXPECT_EQ(f, (std::vector<float>{1, 2, 0.5})) << filename;
+
+    // The stats do not change with the input
+    f = {2, 4, 3.5};
+    cmvn.Apply(f.data());
+    EXPECT_EQ(f, (std::vector<float>{1, 2, 0.5})) << filename;
+
+    opts.normalize_variance = true;
+    OnlineCmvn cmvn2(opts, dim);
+    f = {2, 4, 3.5};
+    cmvn2.Apply(f.data());
+    EXPECT_EQ(f, (std::vector<float>{1, 1, 1})) << filename;
+  }
+
+  // The stats are read when the config is constructed. Streams created
+  // from it do not read the file.
+  FbankOptions fbank_opts = GetTestFbankOptions(dim);
+
+  OnlineCmvnOptions cmvn_opts;
+  cmvn_opts.mode = "global";
+  cmvn_opts.global_cmvn_stats = "test-online-cmvn.txt";
+  FbankExtractorConfig config(fbank_opts, cmvn_opts);
+
+  std::remove("test-online-cmvn.txt");
+  std::remove("test-online-cmvn.bin");
+
+  std::vector<float> wave = GetTestWave(16000, 0.1f);
+  OnlineFbank raw(fbank_opts);
+  raw.AcceptWaveform(16000, wave.data(), wave.size());
+  for (int32_t i = 0; i != 2; ++i) {
+    OnlineFbank fbank(config);
+    fbank.AcceptWaveform(16000, wave.data(), wave.size());
+    ASSERT_EQ(fbank.NumFramesReady(), raw.NumFramesReady());
+    for (int32_t t = 0; t != fbank.NumFramesReady(); ++t) {
+      for (int32_t d = 0; d != dim; ++d) {
+        EXPECT_EQ(fbank.GetFrame(t)[d], raw.GetFrame(t)[d] - (d + 1));
+      }
+    }
+  }
+}
+
+}  // namespace knf
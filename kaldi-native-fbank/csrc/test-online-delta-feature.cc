@@ -0,0 +1,123 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/online-delta-feature.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/test-utils.h"
+
+namespace knf {
+
+// Weights of add-deltas in Kaldi with order 2 and window 2
+static const float kDelta[] = {-0.2f, -0.1f, 0, 0.1f, 0.2f};
+static const float kDeltaDelta[] = {0.04f, 0.04f, 0.01f, -0.04f, -0.1f,
+                                    -0.04f, 0.01f, 0.04f, 0.04f};
+
+TEST(OnlineDeltaFeature, CompareWithOffline) {
+  FbankOptions opts = GetTestFbankOptions(23);
+  std::vector<float> wave = GetTestWave(8000);
+
+  OnlineFbank fbank(opts);
+  fbank.AcceptWaveform(16000, wave.data(), wave.size());
+  fbank.InputFinished();
+
+  int32_t num_frames = fbank.NumFramesReady();
+  int32_t dim = fbank.Dim();
+  ASSERT_GT(num_frames, 10);
+
+  OnlineFbank src(opts);
+  DeltaFeaturesOptions delta_opts;
+  OnlineDeltaFbank delta(delta_opts, &src);
+  EXPECT_EQ(delta.Dim(), 3 * dim);
+
+  // Feed it in chunks and discard the frames of src once they are read
+  for (size_t i = 0; i < wave.size(); i += 999) {
+    int32_t n = std::min<size_t>(999, wave.size() - i);
+    src.AcceptWaveform(16000, wave.data() + i, n);
+    delta.Update();
+
+    // Latency of order * window frames
+    EXPECT_EQ(delta.NumFramesReady(),
+              std::max(src.NumFramesReady() - 4, 0));
+    src.Pop(src.NumFramesReady());
+  }
+  src.InputFinished();
+  delta.Update();
+
+  ASSERT_EQ(delta.NumFramesReady(), num_frames);
+  EXPECT_TRUE(delta.IsLastFrame(num_frames - 1));
+  EXPECT_FALSE(delta.IsLastFrame(num_frames - 2));
+
+  auto x = [&](int32_t t) {
+    return fbank.GetFrame(std::min(std::max(t, 0), num_frames - 1));
+  };
+
+  for (int32_t t = 0; t != num_frames; ++t) {
+    const float *p = delta.GetFrame(t);
+    for (int32_t d = 0; d != dim; ++d) {
+      double d1 = 0;
+      for (int32_t j = -2; j <= 2; ++j) {
+        d1 += kDelta[j + 2] * x(t + j)[d];
+      }
+
+      double d2 = 0;
+      for (int32_t j = -4; j <= 4; ++j) {
+        d2 += kDeltaDelta[j + 4] * x(t + j)[d];
+      }
+
+      EXPECT_EQ(p[d], x(t)[d]) << t << " " << d;
+      EXPECT_NEAR(p[dim + d], d1, 1e-4) << t << " " << d;
+      EXPECT_NEAR(p[2 * dim + d], d2, 1e-4) << t << " " << d;
+    }
+  }
+}
+
+TEST(OnlineDeltaFeature, FewFrames) {
+  FbankOptions opts = GetTestFbankOptions(23);
+  std::vector<float> wave = GetTestWave(8000);
+
+  // 2 frames, fewer than the context
+  OnlineFbank src(opts);
+  src.AcceptWaveform(16000, wave.data(), 560);
+  src.InputFinished();
+  ASSERT_EQ(src.NumFramesReady(), 2);
+
+  DeltaFeaturesOptions delta_opts;
+  delta_opts.order = 1;
+  OnlineDeltaFbank delta(delta_opts, &src);
+  delta.Update();
+  ASSERT_EQ(delta.NumFramesReady(), 2);
+
+  // Frame 0 sees [x0, x0, x0, x1, x1] and frame 1 sees
+  // [x0, x0, x1, x1, x1]. The delta of both is 0.3 * (x1 - x0).
+  int32_t dim = src.Dim();
+  const float *x0 = src.GetFrame(0);
+  const float *x1 = src.GetFrame(1);
+  for (int32_t t = 0; t != 2; ++t) {
+    const float *p = delta.GetFrame(t);
+    for (int32_t d = 0; d != dim; ++d) {
+      EXPECT_NEAR(p[dim + d], 0.3f * (x1[d] - x0[d]), 1e-4) << t << " " << d;
+    }
+  }
+}
+
+}  // namespace knf
@@ -16,15 +16,23 @@
  * limitations under the License.
  */
 
-#include "gtest/gtest.h"
 #include "kaldi-native-fbank/csrc/online-feature.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/simd.h"
+
 namespace knf {
 
 TEST(RecyclingVector, TestUnlimited) {
   RecyclingVector v(-1);
   constexpr int32_t N = 100;
   for (int32_t i = 0; i != N; ++i) {
-    std::unique_ptr<float[]> p(new float[3]{i, i + 1, i + 2});
+    std::vector<float> p = {1.0f * i, i + 1.0f, i + 2.0f};
     v.PushBack(std::move(p));
   }
   ASSERT_EQ(v.Size(), N);
@@ -42,7 +50,7 @@ TEST(RecyclingVector, Testlimited) {
   constexpr int32_t N = 10;
   RecyclingVector v(K);
   for (int32_t i = 0; i != N; ++i) {
-    std::unique_ptr<float[]> p(new float[3]{i, i + 1, i + 2});
+    std::vector<float> p = {1.0f * i, i + 1.0f, i + 2.0f};
     v.PushBack(std::move(p));
   }
 
@@ -56,4 +64,215 @@ TEST(RecyclingVector, Testlimited) {
     }
   }
 }
+
+TEST(RecyclingVector, Half) {
+  constexpr int32_t K = 3;
+  constexpr int32_t N = 10;
+  RecyclingVector v(K, FeatureDtype::kFloat16);
+  RecyclingVector w(-1, FeatureDtype::kBFloat16);
+  for (int32_t i = 0; i != N; ++i) {
+    std::vector<float> p = {1.0f * i, i + 1.0f, i + 2.0f};
+    v.PushBack(p);
+    w.PushBack(std::move(p));
+  }
+  ASSERT_EQ(v.Size(), N);
+  ASSERT_EQ(w.Size(), N);
+
+  v.Pop(1);
+  EXPECT_EQ(v.Size(), N);
+
+  // Small integers are exact in both types
+  const SimdKernels &kernels = GetSimdKernels();
+  for (int32_t i = N - K + 1; i != N; ++i) {
+    for (int32_t k = 0; k != 3; ++k) {
+      float f = i + k;
+      uint16_t h;
+      kernels.float_to_half(&f, &h, 1);
+      EXPECT_EQ(v.HalfAt(i)[k], h);
+
+      kernels.float_to_bfloat16(&f, &h, 1);
+      EXPECT_EQ(w.HalfAt(i)[k], h);
+    }
+  }
+}
+
+template <class F>
+static std::vector<float> ComputeFeatures(F *f, const std::vector<float> &wave) {
+  f->AcceptWaveform(16000, wave.data(), wave.size());
+  f->InputFinished();
+
+  std::vector<float> ans;
+  for (int32_t i = 0; i != f->NumFramesReady(); ++i) {
+    const float *p = f->GetFrame(i);
+    ans.insert(ans.end(), p, p + f->Dim());
+  }
+  return ans;
+}
+
+static std::vector<float> GetWave() {
+  std::vector<float> wave(16000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i) + 0.5f * std::cos(0.37f * i);
+  }
+  return wave;
+}
+
+TEST(FeatureExtractorConfig, Fbank) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+  opts.mel_opts.num_bins = 80;
+
+  FbankExtractorConfig config(opts);
+
+  std::vector<float> wave = GetWave();
+
+  OnlineFbank expected(opts);
+  OnlineFbank a(config);
+  OnlineFbank b(config);
+
+  std::vector<float> e = ComputeFeatures(&expected, wave);
+  EXPECT_FALSE(e.empty());
+  EXPECT_EQ(ComputeFeatures(&a, wave), e);
+  EXPECT_EQ(ComputeFeatures(&b, wave), e);
+}
+
+TEST(FeatureExtractorConfig, Mfcc) {
+  MfccOptions opts;
+  opts.frame_opts.dither = 0;
+  opts.mel_opts.num_bins = 40;
+  opts.num_ceps = 40;
+
+  MfccExtractorConfig config(opts);
+
+  std::vector<float> wave = GetWave();
+
+  OnlineMfcc expected(opts);
+  std::vector<float> e = ComputeFeatures(&expected, wave);
+  EXPECT_FALSE(e.empty());
+
+  for (int32_t i = 0; i != 3; ++i) {
+    OnlineMfcc m(config);
+    EXPECT_EQ(ComputeFeatures(&m, wave), e);
+  }
+}
+
+TEST(OnlineFbank, FastMath) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+  opts.mel_opts.num_bins = 80;
+  opts.use_energy = true;
+
+  std::vector<float> wave = GetWave();
+
+  OnlineFbank exact(opts);
+  std::vector<float> expected = ComputeFeatures(&exact, wave);
+
+  opts.frame_opts.accuracy = "fast";
+  OnlineFbank fast(opts);
+  std::vector<float> e = ComputeFeatures(&fast, wave);
+
+  ASSERT_EQ(e.size(), expected.size());
+  for (int32_t i = 0; i != static_cast<int32_t>(e.size()); ++i) {
+    float tol = 1e-4 * std::max(std::abs(expected[i]), 1.0f);
+    EXPECT_NEAR(e[i], expected[i], tol) << i;
+  }
+}
+
+TEST(OnlineMfcc, FastMath) {
+  MfccOptions opts;
+  opts.frame_opts.dither = 0;
+
+  std::vector<float> wave = GetWave();
+
+  OnlineMfcc exact(opts);
+  std::vector<float> expected = ComputeFeatures(&exact, wave);
+
+  opts.frame_opts.accuracy = "fast";
+  OnlineMfcc fast(opts);
+  std::vector<float> e = ComputeFeatures(&fast, wave);
+
+  ASSERT_EQ(e.size(), expected.size());
+  for (int32_t i = 0; i != static_cast<int32_t>(e.size()); ++i) {
+    // Each coefficient is a sum of num_bins log values
+    float tol = 1e-3 * std::max(std::abs(expected[i]), 1.0f);
+    EXPECT_NEAR(e[i], expected[i], tol) << i;
+  }
+}
+
+TEST(OnlineFbank, OutputDtype) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+  opts.mel_opts.num_bins = 80;
+
+  std::vector<float> wave = GetWave();
+
+  OnlineFbank fbank(opts);
+  EXPECT_EQ(fbank.OutputDtype(), FeatureDtype::kFloat32);
+  std::vector<float> expected = ComputeFeatures(&fbank, wave);
+
+  const SimdKernels &kernels = GetSimdKernels();
+  for (const char *dtype : {"float16", "bfloat16"}) {
+    opts.frame_opts.output_dtype = dtype;
+    OnlineFbank f(opts);
+    f.AcceptWaveform(16000, wave.data(), wave.size());
+    f.InputFinished();
+    ASSERT_EQ(f.NumFramesReady(), fbank.NumFramesReady());
+    EXPECT_STREQ(FeatureDtypeName(f.OutputDtype()), dtype);
+
+    std::vector<uint16_t> e(f.Dim());
+    for (int32_t i = 0; i != f.NumFramesReady(); ++i) {
+      if (f.OutputDtype() == FeatureDtype::kFloat16) {
+        kernels.float_to_half(fbank.GetFrame(i), e.data(), f.Dim());
+      } else {
+        kernels.float_to_bfloat16(fbank.GetFrame(i), e.data(), f.Dim());
+      }
+      const uint16_t *h = f.GetHalfFrame(i);
+      EXPECT_EQ(std::vector<uint16_t>(h, h + f.Dim()), e) << dtype << " " << i;
+    }
+  }
+}
+
+TEST(OnlineFbank, AcceptWaveformInt16) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+
+  std::vector<float> wave = GetWave();
+  std::vector<int16_t> samples(wave.size());
+  std::vector<int32_t> samples32(wave.size());
+  std::vector<double> samples64(wave.size());
+  std::vector<float> normalized(wave.size());
+  std::vector<float> unnormalized(wave.size());
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    samples[i] = static_cast<int16_t>(wave[i] * 20000);
+    samples32[i] = samples[i] * 65536;
+    samples64[i] = samples[i];
+    normalized[i] = samples[i] / 32768.0f;
+    unnormalized[i] = samples[i];
+  }
+
+  OnlineFbank a(opts);
+  OnlineFbank b(opts);
+  std::vector<float> expected = ComputeFeatures(&a, normalized);
+  std::vector<float> expected_unnormalized = ComputeFeatures(&b, unnormalized);
+
+  OnlineFbank c(opts);
+  OnlineFbank d(opts);
+  OnlineFbank e(opts);
+  OnlineFbank g(opts);
+  // Use chunks of different sizes to cover the tails of the SIMD kernels
+  int32_t n = samples.size();
+  for (int32_t start = 0, chunk = 1; start < n; start += chunk, chunk += 37) {
+    int32_t k = std::min(chunk, n - start);
+    c.AcceptWaveform(16000, samples.data() + start, k);
+    d.AcceptWaveform(16000, samples.data() + start, k, /*normalize*/ false);
+    e.AcceptWaveform(16000, samples32.data() + start, k);
+    g.AcceptWaveform(16000, samples64.data() + start, k);
+  }
+
+  EXPECT_EQ(ComputeFeatures(&c, {}), expected);
+  EXPECT_EQ(ComputeFeatures(&d, {}), expected_unnormalized);
+  EXPECT_EQ(ComputeFeatures(&e, {}), expected);
+  EXPECT_EQ(ComputeFeatures(&g, {}), expected_unnormalized);
+}
+
 }  // namespace knf
@@ -0,0 +1,194 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/online-lfr-feature.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/test-utils.h"
+
+namespace knf {
+
+// apply_lfr() of FunASR
+static std::vector<std::vector<float>> ApplyLfr(
+    const std::vector<std::vector<float>> &in, int32_t m, int32_t n) {
+  int32_t left = (m - 1) / 2;
+  std::vector<std::vector<float>> padded(left, in[0]);
+  padded.insert(padded.end(), in.begin(), in.end());
+
+  int32_t num_frames = in.size();
+  int32_t t = padded.size();
+  int32_t num_out = (num_frames + n - 1) / n;
+
+  std::vector<std::vector<float>> ans;
+  for (int32_t i = 0; i != num_out; ++i) {
+    std::vector<float> frame;
+    for (int32_t j = 0; j != m; ++j) {
+      const auto &row = padded[std::min(i * n + j, t - 1)];
+      frame.insert(frame.end(), row.begin(), row.end());
+    }
+    ans.push_back(frame);
+  }
+  return ans;
+}
+
+TEST(OnlineLfrFeature, CompareWithFunAsr) {
+  FbankOptions opts = GetTestFbankOptions(8);
+  std::vector<float> wave = GetTestWave(8000);
+
+  OnlineFbank fbank(opts);
+  fbank.AcceptWaveform(16000, wave.data(), wave.size());
+  fbank.InputFinished();
+
+  std::vector<std::vector<float>> features;
+  for (int32_t i = 0; i != fbank.NumFramesReady(); ++i) {
+    const float *p = fbank.GetFrame(i);
+    features.emplace_back(p, p + fbank.Dim());
+  }
+
+  for (auto mn : std::vector<std::pair<int32_t, int32_t>>{
+           {7, 6}, {1, 1}, {5, 1}, {4, 3}, {2, 5}}) {
+    // Also check that the last frames are correct for different lengths
+    for (int32_t num_frames : {1, 2, 3, 7, 12, 13, 48}) {
+      std::vector<std::vector<float>> in(features.begin(),
+                                         features.begin() + num_frames);
+      std::vector<std::vector<float>> expected =
+          ApplyLfr(in, mn.first, mn.second);
+
+      LfrOptions lfr_opts;
+      lfr_opts.lfr_m = mn.first;
+      lfr_opts.lfr_n = mn.second;
+
+      // Feed 3 frame shifts of samples at a time and discard the frames
+      // of src once they are read
+      OnlineFbank src(opts);
+      OnlineLfrFbank lfr(lfr_opts, &src);
+      EXPECT_EQ(lfr.Dim(), mn.first * src.Dim());
+
+      int32_t num_samples = 400 + (num_frames - 1) * 160;
+      for (int32_t i = 0; i < num_samples; i += 480) {
+        int32_t k = std::min(480, num_samples - i);
+        src.AcceptWaveform(16000, wave.data() + i, k);
+        lfr.Update();
+        src.Pop(src.NumFramesReady());
+      }
+      src.InputFinished();
+      lfr.Update();
+
+      ASSERT_EQ(lfr.NumFramesReady(), static_cast<int32_t>(expected.size()))
+          << mn.first << " " << mn.second << " " << num_frames;
+      EXPECT_TRUE(lfr.IsLastFrame(lfr.NumFramesReady() - 1));
+
+      // All frames are contiguous
+      const float *p = lfr.GetFrames(0);
+      for (const auto &f : expected) {
+        EXPECT_EQ(std::vector<float>(p, p + lfr.Dim()), f);
+        p += lfr.Dim();
+      }
+    }
+  }
+}
+
+TEST(OnlineLfrFeature, CmvnAndPop) {
+  FbankOptions opts = GetTestFbankOptions(8);
+  std::vector<float> wave = GetTestWave(8000);
+
+  OnlineFbank src(opts);
+  src.AcceptWaveform(16000, wave.data(), wave.size());
+  src.InputFinished();
+
+  LfrOptions lfr_opts;
+  OnlineLfrFbank a(lfr_opts, &src);
+  a.Update();
+
+  OnlineLfrFbank b(lfr_opts, &src);
+  int32_t dim = b.Dim();
+  std::vector<float> neg_mean(dim);
+  std::vector<float> inv_stddev(dim);
+  for (int32_t i = 0; i != dim; ++i) {
+    neg_mean[i] = -0.01f * i;
+    inv_stddev[i] = 1 + 0.1f * (i % 7);
+  }
+  b.SetCmvn(neg_mean, inv_stddev);
+  b.Update();
+
+  int32_t num_frames = a.NumFramesReady();
+  ASSERT_EQ(b.NumFramesReady(), num_frames);
+  ASSERT_GT(num_frames, 3);
+
+  b.Pop(2);
+  EXPECT_EQ(b.NumFramesReady(), num_frames);
+  for (int32_t t = 2; t != num_frames; ++t) {
+    const float *x = a.GetFrame(t);
+    const float *y = b.GetFrame(t);
+    for (int32_t i = 0; i != dim; ++i) {
+      EXPECT_EQ(y[i], (x[i] + neg_mean[i]) * inv_stddev[i]) << t << " " << i;
+    }
+  }
+
+  // Frames after the popped ones are still contiguous
+  EXPECT_EQ(b.GetFrames(2) + dim, b.GetFrame(3));
+}
+
+TEST(OnlineLfrFeature, PopWhileStreaming) {
+  FbankOptions opts = GetTestFbankOptions(8);
+  std::vector<float> wave = GetTestWave(8000);
+
+  LfrOptions lfr_opts;
+  lfr_opts.lfr_m = 3;
+  lfr_opts.lfr_n = 1;
+
+  OnlineFbank src_a(opts);
+  src_a.AcceptWaveform(16000, wave.data(), wave.size());
+  src_a.InputFinished();
+  OnlineLfrFbank a(lfr_opts, &src_a);
+  a.Update();
+  int32_t dim = a.Dim();
+
+  // Keep a few frames and pop the rest after each chunk, so that the popped
+  // frames are removed while new frames are appended
+  OnlineFbank src(opts);
+  OnlineLfrFbank b(lfr_opts, &src);
+  int32_t num_popped = 0;
+  for (size_t i = 0; i < wave.size(); i += 480) {
+    int32_t n = std::min<size_t>(480, wave.size() - i);
+    src.AcceptWaveform(16000, wave.data() + i, n);
+    if (i + n == wave.size()) {
+      src.InputFinished();
+    }
+    b.Update();
+
+    int32_t num_ready = b.NumFramesReady();
+    for (int32_t t = num_popped; t != num_ready; ++t) {
+      const float *x = a.GetFrame(t);
+      EXPECT_EQ(std::vector<float>(b.GetFrame(t), b.GetFrame(t) + dim),
+                std::vector<float>(x, x + dim))
+          << t;
+    }
+    int32_t k = std::max(num_ready - num_popped - 2, 0);
+    b.Pop(k);
+    num_popped += k;
+  }
+  EXPECT_EQ(b.NumFramesReady(), a.NumFramesReady());
+}
+
+}  // namespace knf
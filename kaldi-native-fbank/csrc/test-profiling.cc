@@ -0,0 +1,149 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/profiling.h"
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/multi-stream-online-feature.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/stft.h"
+
+namespace knf {
+
+TEST(Profiling, Prometheus) {
+  ProfileStats stats;
+  stats.cycles[kProfileFft] = 123;
+  stats.calls[kProfileFft] = 2;
+  stats.frames_processed = 10;
+  stats.queue_depth = 3;
+
+  std::string s = ToPrometheusText(stats, "knf", "stream=\"1\"");
+
+  EXPECT_NE(s.find("# TYPE knf_stage_cycles_total counter\n"),
+            std::string::npos);
+  EXPECT_NE(s.find("knf_stage_cycles_total{stream=\"1\",stage=\"fft\"} 123\n"),
+            std::string::npos);
+  EXPECT_NE(s.find("knf_stage_calls_total{stream=\"1\",stage=\"fft\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(s.find("knf_frames_processed_total{stream=\"1\"} 10\n"),
+            std::string::npos);
+  EXPECT_NE(s.find("# TYPE knf_queue_depth gauge\n"), std::string::npos);
+  EXPECT_NE(s.find("knf_queue_depth{stream=\"1\"} 3\n"), std::string::npos);
+
+  s = ToPrometheusText(stats);
+  EXPECT_NE(s.find("knf_stage_cycles_total{stage=\"fft\"} 123\n"),
+            std::string::npos);
+  EXPECT_NE(s.find("knf_frames_processed_total 10\n"), std::string::npos);
+}
+
+TEST(Profiling, Merge) {
+  ProfileStats a;
+  a.cycles[kProfileMel] = 1;
+  a.frames_processed = 2;
+
+  a.bytes_allocated = 8;
+  a.samples_buffered = 100;
+  a.queue_depth = 1;
+
+  ProfileStats b = a;
+  b.samples_buffered = 30;
+  b.queue_depth = 5;
+  b.Merge(a);
+  EXPECT_EQ(b.cycles[kProfileMel], 2);
+  EXPECT_EQ(b.frames_processed, 4);
+  EXPECT_EQ(b.bytes_allocated, 16);
+
+  // Gauges are not added
+  EXPECT_EQ(b.samples_buffered, 100);
+  EXPECT_EQ(b.queue_depth, 5);
+}
+
+TEST(Profiling, OnlineFbank) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+
+  std::vector<float> wave(16000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i);
+  }
+
+  OnlineFbank fbank(opts);
+  fbank.AcceptWaveform(16000, wave.data(), wave.size());
+  fbank.InputFinished();
+
+  StftConfig config;
+  config.n_fft = 512;
+  config.hop_length = 160;
+  config.win_length = 512;
+  config.window_type = "hann";
+  Stft stft(config);
+  StftResult r = stft.Compute(wave.data(), wave.size());
+
+  ProfileStats stats = fbank.GetStats();
+  ProfileStats stft_stats = stft.GetStats();
+
+#if KNF_ENABLE_PROFILING
+  EXPECT_EQ(stats.frames_processed, fbank.NumFramesReady());
+  EXPECT_EQ(stats.calls[kProfileFft], fbank.NumFramesReady());
+  EXPECT_EQ(stats.calls[kProfileMel], fbank.NumFramesReady());
+  EXPECT_EQ(stats.calls[kProfileWindow], fbank.NumFramesReady());
+  EXPECT_GT(stats.bytes_allocated, 0);
+
+  EXPECT_EQ(stft_stats.frames_processed, r.num_frames);
+  EXPECT_EQ(stft_stats.calls[kProfileFft], r.num_frames);
+#else
+  EXPECT_EQ(stats.frames_processed, 0);
+  EXPECT_EQ(stats.calls[kProfileFft], 0);
+  EXPECT_EQ(stft_stats.frames_processed, 0);
+#endif
+}
+
+TEST(Profiling, MultiStreamOnlineFbank) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+
+  std::vector<float> wave(16000);
+  for (int32_t i = 0; i != static_cast<int32_t>(wave.size()); ++i) {
+    wave[i] = std::sin(0.01f * i);
+  }
+
+  MultiStreamOnlineFbank fbank(opts, 2);
+  fbank.AcceptWaveform(0, 16000, wave.data(), wave.size());
+  fbank.AcceptWaveform(1, 16000, wave.data(), 1000);
+  fbank.ComputeReady();
+
+  int32_t num_frames = fbank.NumFramesReady(0) + fbank.NumFramesReady(1);
+  ProfileStats stats = fbank.GetStats();
+
+#if KNF_ENABLE_PROFILING
+  EXPECT_EQ(stats.frames_processed, num_frames);
+  EXPECT_EQ(stats.calls[kProfileFft], num_frames);
+  EXPECT_EQ(stats.calls[kProfileWindow], num_frames);
+  EXPECT_GT(stats.bytes_allocated, 0);
+  EXPECT_GT(stats.samples_buffered, 0);
+#else
+  EXPECT_GT(num_frames, 0);
+  EXPECT_EQ(stats.frames_processed, 0);
+#endif
+}
+
+}  // namespace knf
@@ -0,0 +1,135 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/resample.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/kaldi-math.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+static std::vector<float> GetSine(int32_t samp_rate, float freq,
+                                  int32_t num_samples) {
+  std::vector<float> ans(num_samples);
+  for (int32_t i = 0; i != num_samples; ++i) {
+    ans[i] = std::sin(M_2PI * freq * i / samp_rate);
+  }
+  return ans;
+}
+
+static void TestSine(int32_t samp_rate_in, int32_t samp_rate_out) {
+  float freq = 440;
+  int32_t n = samp_rate_in;  // 1 second
+  std::vector<float> in = GetSine(samp_rate_in, freq, n);
+
+  // The same cutoff as ResampleWaveform() in Kaldi
+  float cutoff = 0.99f * 0.5f * std::min(samp_rate_in, samp_rate_out);
+  LinearResample resampler(samp_rate_in, samp_rate_out, cutoff, 6);
+
+  std::vector<float> out;
+  resampler.Resample(in.data(), in.size(), true, &out);
+
+  // ceil(n * samp_rate_out / samp_rate_in)
+  EXPECT_EQ(out.size(), samp_rate_out);
+
+  std::vector<float> expected = GetSine(samp_rate_out, freq, out.size());
+
+  // Skip the edges, where the input is padded with zeros
+  for (int32_t i = 100; i + 100 < static_cast<int32_t>(out.size()); ++i) {
+    EXPECT_NEAR(out[i], expected[i], 5e-3) << i;
+  }
+}
+
+TEST(LinearResample, Sine) {
+  TestSine(8000, 16000);
+  TestSine(22050, 16000);
+  TestSine(44100, 16000);
+  TestSine(48000, 16000);
+  TestSine(16000, 8000);
+}
+
+TEST(LinearResample, Streaming) {
+  int32_t samp_rate_in = 44100;
+  int32_t samp_rate_out = 16000;
+  std::vector<float> in = GetSine(samp_rate_in, 1000, 20000);
+
+  LinearResample a(samp_rate_in, samp_rate_out, 8000, 6);
+  std::vector<float> expected;
+  a.Resample(in.data(), in.size(), true, &expected);
+
+  LinearResample b(samp_rate_in, samp_rate_out, 8000, 6);
+  std::vector<float> out;
+  int32_t n = in.size();
+  for (int32_t start = 0, chunk = 1; start < n; start += chunk, chunk += 97) {
+    int32_t k = std::min(chunk, n - start);
+    b.Resample(in.data() + start, k, false, &out);
+  }
+  b.Resample(nullptr, 0, true, &out);
+
+  ASSERT_EQ(out.size(), expected.size());
+  for (int32_t i = 0; i != static_cast<int32_t>(out.size()); ++i) {
+    EXPECT_NEAR(out[i], expected[i], 1e-5) << i;
+  }
+
+  // It is reset after flushing
+  std::vector<float> again;
+  b.Resample(in.data(), in.size(), true, &again);
+  EXPECT_EQ(again, expected);
+}
+
+TEST(LinearResample, OnlineFbank) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+  opts.frame_opts.allow_downsample = true;
+
+  std::vector<float> wave = GetSine(48000, 440, 48000);
+
+  OnlineFbank fbank(opts);
+  for (int32_t start = 0; start < 48000; start += 4800) {
+    fbank.AcceptWaveform(48000, wave.data() + start, 4800);
+  }
+  fbank.InputFinished();
+
+  // See CreateResamplerIfNeeded()
+  LinearResample resampler(48000, 16000, 0.99f * 0.5f * 16000, 6);
+  std::vector<float> resampled;
+  resampler.Resample(wave.data(), wave.size(), true, &resampled);
+
+  opts.frame_opts.allow_downsample = false;
+  OnlineFbank expected(opts);
+  expected.AcceptWaveform(16000, resampled.data(), resampled.size());
+  expected.InputFinished();
+
+  ASSERT_EQ(fbank.NumFramesReady(), expected.NumFramesReady());
+  EXPECT_EQ(fbank.NumFramesReady(), 98);
+
+  for (int32_t i = 0; i != fbank.NumFramesReady(); ++i) {
+    const float *p = fbank.GetFrame(i);
+    const float *q = expected.GetFrame(i);
+    for (int32_t k = 0; k != fbank.Dim(); ++k) {
+      EXPECT_NEAR(p[k], q[k], 1e-3) << i << " " << k;
+    }
+  }
+}
+
+}  // namespace knf
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/shared-cache.h"
+
+#include <memory>
+#include <string>
+#include <thread>  // NOLINT
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace knf {
+
+TEST(SharedCache, Share) {
+  SharedCache<std::string, int32_t> cache;
+  int32_t num_created = 0;
+  auto create = [&num_created]() {
+    ++num_created;
+    return std::make_shared<const int32_t>(num_created);
+  };
+
+  auto a = cache.Get("a", create);
+  auto a2 = cache.Get("a", create);
+  auto b = cache.Get("b", create);
+  EXPECT_EQ(a, a2);
+  EXPECT_NE(a, b);
+  EXPECT_EQ(num_created, 2);
+  EXPECT_EQ(cache.Size(), 2);
+
+  // The cache does not own the objects
+  a.reset();
+  a2.reset();
+  EXPECT_EQ(cache.Size(), 1);
+
+  a = cache.Get("a", create);
+  EXPECT_EQ(*a, 3);
+  EXPECT_EQ(cache.Size(), 2);
+}
+
+TEST(SharedCache, Threads) {
+  SharedCache<int32_t, std::vector<float>> cache;
+
+  std::vector<std::shared_ptr<const std::vector<float>>> results(8);
+  std::vector<std::thread> threads;
+  for (int32_t i = 0; i != static_cast<int32_t>(results.size()); ++i) {
+    threads.emplace_back([&cache, &results, i]() {
+      results[i] = cache.Get(
+          1, []() { return std::make_shared<const std::vector<float>>(10); });
+    });
+  }
+
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  // All threads get the same instance even if several of them created one
+  for (const auto &r : results) {
+    EXPECT_EQ(r, results[0]);
+  }
+  EXPECT_EQ(cache.Size(), 1);
+}
+
+}  // namespace knf
@@ -0,0 +1,266 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/simd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/kaldi-math.h"
+
+namespace knf {
+
+static std::vector<float> RandomVector(int32_t n, std::mt19937 *gen) {
+  std::uniform_real_distribution<float> dist(-1, 1);
+  std::vector<float> ans(n);
+  for (auto &f : ans) {
+    f = dist(*gen);
+  }
+  return ans;
+}
+
+// Check that every supported level gives the same results as the scalar
+// reference. Sizes cover the vectorized body and all tail lengths.
+class SimdTest : public ::testing::TestWithParam<SimdLevel> {};
+
+TEST_P(SimdTest, CompareWithScalar) {
+  const SimdKernels *kernels = GetSimdKernels(GetParam());
+  if (kernels == nullptr) {
+    GTEST_SKIP() << SimdLevelName(GetParam()) << " is not supported";
+  }
+
+  const SimdKernels *ref = GetSimdKernels(SimdLevel::kScalar);
+  ASSERT_NE(ref, nullptr);
+
+  std::mt19937 gen(20260);
+
+  for (int32_t n = 0; n != 100; ++n) {
+    std::vector<float> a = RandomVector(n, &gen);
+    std::vector<float> b = RandomVector(n, &gen);
+
+    // Reductions may differ in rounding
+    EXPECT_NEAR(kernels->inner_product(a.data(), b.data(), n),
+                ref->inner_product(a.data(), b.data(), n), 1e-5 * (n + 1));
+
+    EXPECT_NEAR(kernels->sum(a.data(), n), ref->sum(a.data(), n),
+                1e-5 * (n + 1));
+
+    // Element-wise kernels are exact
+    std::vector<float> x = a;
+    std::vector<float> y = a;
+    kernels->add_scalar(0.25f, x.data(), n);
+    ref->add_scalar(0.25f, y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    x = a;
+    y = a;
+    kernels->multiply(b.data(), x.data(), n);
+    ref->multiply(b.data(), y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    x = a;
+    y = a;
+    kernels->axpy(-0.75f, b.data(), x.data(), n);
+    ref->axpy(-0.75f, b.data(), y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    for (int32_t i = 0; i != n; ++i) {
+      x[i] = std::abs(a[i]);
+    }
+    y = x;
+    kernels->sqrt(x.data(), n);
+    ref->sqrt(y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    // From 1e-35 to 1e35. The first one is below the floor.
+    for (int32_t i = 0; i != n; ++i) {
+      x[i] = i == 0 ? 0 : std::exp(a[i] * 80);
+    }
+    y = x;
+    kernels->log(1e-30f, x.data(), n);
+    ref->log(1e-30f, y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    // The fast kernels are identical at all levels
+    for (int32_t i = 0; i != n; ++i) {
+      x[i] = i == 0 ? 0 : std::exp(a[i] * 80);
+    }
+    y = x;
+    std::vector<float> z = x;
+    kernels->log_fast(1e-30f, x.data(), n);
+    ref->log_fast(1e-30f, y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    ref->log(1e-30f, z.data(), n);
+    for (int32_t i = 0; i != n; ++i) {
+      EXPECT_NEAR(x[i], z[i], 1e-4f * std::abs(z[i])) << n << " " << i;
+    }
+
+    // Uniform numbers in (0, 1)
+    std::vector<float> u = RandomVector(2 * n, &gen);
+    for (auto &f : u) {
+      f = f * 0.499f + 0.5f;
+    }
+    x.assign(2 * n, 0);
+    y.assign(2 * n, 0);
+    kernels->gauss(u.data(), u.data() + n, x.data(), n);
+    ref->gauss(u.data(), u.data() + n, y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    for (int32_t i = 0; i != n; ++i) {
+      double r = std::sqrt(-2 * std::log(static_cast<double>(u[i])));
+      double t = 2 * M_PI * u[n + i] - M_PI;
+      EXPECT_NEAR(x[i], r * std::cos(t), 1e-4 * r) << n << " " << i;
+      EXPECT_NEAR(x[n + i], r * std::sin(t), 1e-4 * r) << n << " " << i;
+    }
+
+    std::vector<float> c = RandomVector(2 * n, &gen);
+    x.assign(n, 0);
+    y.assign(n, 0);
+    kernels->complex_squared_norm(c.data(), x.data(), n);
+    ref->complex_squared_norm(c.data(), y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    // In place, as used by ComputePowerSpectrum()
+    std::vector<float> d = RandomVector(2 * n + 2, &gen);
+    std::vector<float> e = d;
+    kernels->complex_squared_norm(d.data() + 2, d.data() + 1, n);
+    ref->complex_squared_norm(e.data() + 2, e.data() + 1, n);
+    EXPECT_EQ(d, e) << n;
+
+    std::vector<int16_t> i16(n);
+    std::vector<int32_t> i32(n);
+    std::vector<double> f64(n);
+    for (int32_t i = 0; i != n; ++i) {
+      i16[i] = static_cast<int16_t>(a[i] * 32767);
+      i32[i] = static_cast<int32_t>(b[i] * 2147483647.0);
+      f64[i] = a[i] * 1.000001;
+    }
+
+    kernels->int16_to_float(i16.data(), 1.0f / 32768, x.data(), n);
+    ref->int16_to_float(i16.data(), 1.0f / 32768, y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    kernels->int32_to_float(i32.data(), 1.0f / 2147483648.0f, x.data(), n);
+    ref->int32_to_float(i32.data(), 1.0f / 2147483648.0f, y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    kernels->double_to_float(f64.data(), 0.5f, x.data(), n);
+    ref->double_to_float(f64.data(), 0.5f, y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    x = a;
+    y = a;
+    kernels->preemphasize_and_window(b.data(), 0.125f, 0.97f, x.data(), n);
+    ref->preemphasize_and_window(b.data(), 0.125f, 0.97f, y.data(), n);
+    EXPECT_EQ(x, y) << n;
+
+    // All of the 3 pieces are covered
+    std::vector<uint8_t> u8(n);
+    for (int32_t i = 0; i != n; ++i) {
+      u8[i] = static_cast<uint8_t>((i * 37 + 11) % 256);
+    }
+    float base[3] = {-1.5f, 0.25f, 2};
+    float scale[3] = {0.01f, 0.03f, -0.125f};
+    float offset[3] = {0, 64, 192};
+    kernels->piecewise_uint8_to_float(u8.data(), base, scale, offset,
+                                      x.data(), n);
+    ref->piecewise_uint8_to_float(u8.data(), base, scale, offset, y.data(),
+                                  n);
+    EXPECT_EQ(x, y) << n;
+
+    // Cover overflow, subnormals and NaN
+    x = a;
+    for (int32_t i = 0; i < n; i += 7) {
+      x[i] = i % 2 ? x[i] * 1e5f : x[i] * 1e-6f;
+    }
+    if (n > 3) {
+      x[3] = std::nanf("");
+    }
+    std::vector<uint16_t> h(n);
+    std::vector<uint16_t> g(n);
+    kernels->float_to_half(x.data(), h.data(), n);
+    ref->float_to_half(x.data(), g.data(), n);
+    EXPECT_EQ(h, g) << n;
+
+    kernels->float_to_bfloat16(x.data(), h.data(), n);
+    ref->float_to_bfloat16(x.data(), g.data(), n);
+    EXPECT_EQ(h, g) << n;
+  }
+}
+
+TEST(Simd, FloatToHalf) {
+  std::vector<float> in = {
+      0,      -0.0f,     1,     -2,     0.1f,
+      65504,  65519,     65520, 1e10f,  -INFINITY,
+      6.103515625e-05f,      // 2^-14, the smallest normal
+      5.9604644775390625e-08f,  // 2^-24, the smallest subnormal
+      2.98023223876953125e-08f,  // 2^-25, a tie that is rounded to 0
+      4.4703483581542969e-08f,  // 1.5 * 2^-25
+      1.00048828125f,            // 1 + 2^-11, a tie that is rounded to 1
+      1.00146484375f,            // 1 + 3 * 2^-11
+      std::nanf(""),
+  };
+  std::vector<uint16_t> expected = {
+      0x0000, 0x8000, 0x3c00, 0xc000, 0x2e66, 0x7bff, 0x7bff,
+      0x7c00, 0x7c00, 0xfc00, 0x0400, 0x0001, 0x0000, 0x0001,
+      0x3c00, 0x3c02, 0x7e00,
+  };
+
+  std::vector<uint16_t> out(in.size());
+  GetSimdKernels(SimdLevel::kScalar)
+      ->float_to_half(in.data(), out.data(), in.size());
+  EXPECT_EQ(out, expected);
+}
+
+TEST(Simd, FloatToBFloat16) {
+  std::vector<float> in = {
+      0,          -0.0f, 1, -2, 3.0e38f, INFINITY,
+      1.00390625f,       // 1 + 2^-8, a tie that is rounded to 1
+      1.01171875f,       // 1 + 3 * 2^-8
+      std::nanf(""),
+  };
+  std::vector<uint16_t> expected = {
+      0x0000, 0x8000, 0x3f80, 0xc000, 0x7f62, 0x7f80, 0x3f80, 0x3f82, 0x7fc0,
+  };
+
+  std::vector<uint16_t> out(in.size());
+  GetSimdKernels(SimdLevel::kScalar)
+      ->float_to_bfloat16(in.data(), out.data(), in.size());
+  EXPECT_EQ(out, expected);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllLevels, SimdTest,
+                         ::testing::Values(SimdLevel::kScalar,
+                                           SimdLevel::kSse2, SimdLevel::kAvx2,
+                                           SimdLevel::kAvx512,
+                                           SimdLevel::kNeon));
+
+TEST(Simd, Dispatch) {
+  SimdLevel level = GetSimdLevel();
+  EXPECT_NE(GetSimdKernels(level), nullptr);
+  EXPECT_EQ(&GetSimdKernels(), GetSimdKernels(level));
+  EXPECT_NE(std::string(SimdLevelName(level)), "unknown");
+}
+
+}  // namespace knf
@@ -0,0 +1,60 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Helpers shared by the tests. It is not installed.
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_TEST_UTILS_H_
+#define KALDI_NATIVE_FBANK_CSRC_TEST_UTILS_H_
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/feature-fbank.h"
+
+namespace knf {
+
+// Return n samples of an amplitude modulated sine of the given angular
+// frequency in radians per sample, so that the features change from frame
+// to frame. If noise is not 0, uniform noise in [-noise / 2, noise / 2)
+// from a fixed seed is added.
+inline std::vector<float> GetTestWave(int32_t n, float noise = 0,
+                                      float freq = 0.01f) {
+  std::vector<float> wave(n);
+  uint32_t seed = 20260101;
+  for (int32_t i = 0; i != n; ++i) {
+    wave[i] = std::sin(freq * i) * (1 + 0.5f * std::cos(0.0013f * i));
+    if (noise != 0) {
+      seed = seed * 1664525u + 1013904223u;
+      wave[i] += noise * ((seed >> 8) / 16777216.0f - 0.5f);
+    }
+  }
+  return wave;
+}
+
+// Fbank options without dither, so that the output is deterministic
+inline FbankOptions GetTestFbankOptions(int32_t num_bins) {
+  FbankOptions opts;
+  opts.frame_opts.dither = 0;
+  opts.mel_opts.num_bins = num_bins;
+  return opts;
+}
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_TEST_UTILS_H_
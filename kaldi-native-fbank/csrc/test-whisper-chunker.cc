@@ -0,0 +1,135 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/whisper-chunker.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/kaldi-math.h"
+
+namespace knf {
+
+// Low-level noise with a loud tone from 4 to 6 seconds in every 10 seconds,
+// so that the max of a chunk starting at a multiple of 10 seconds is not at
+// its boundary.
+static std::vector<float> GetWave(int32_t num_samples) {
+  std::mt19937 gen(20260);
+  std::uniform_real_distribution<float> dist(-0.01, 0.01);
+  std::vector<float> wave(num_samples);
+  for (int32_t i = 0; i != num_samples; ++i) {
+    int32_t k = i % 160000;
+    float s = (k >= 64000 && k < 96000) ? std::sin(M_2PI * 440 * i / 16000)
+                                        : 0;
+    wave[i] = s * 0.5f + dist(gen);
+  }
+  return wave;
+}
+
+static void AcceptInPieces(const std::vector<float> &wave,
+                           WhisperChunker *chunker) {
+  int32_t n = wave.size();
+  for (int32_t start = 0, k = 1000; start < n; start += k, k += 3331) {
+    chunker->AcceptWaveform(wave.data() + start, std::min(k, n - start));
+  }
+}
+
+TEST(WhisperChunker, ShortAudio) {
+  std::vector<float> wave = GetWave(16000 * 5 + 123);
+
+  WhisperFeatureOptions opts;
+  WhisperChunker chunker(opts);
+  AcceptInPieces(wave, &chunker);
+  EXPECT_EQ(chunker.NumChunksReady(), 0);
+
+  chunker.InputFinished();
+  ASSERT_EQ(chunker.NumChunksReady(), 1);
+
+  std::vector<float> expected;
+  ComputeWhisperLogMel(opts, wave.data(), wave.size(), &expected);
+
+  std::vector<float> chunk;
+  chunker.GetChunk(0, &chunk);
+  EXPECT_EQ(chunk, expected);
+}
+
+TEST(WhisperChunker, Empty) {
+  WhisperChunker chunker;
+  chunker.InputFinished();
+  ASSERT_EQ(chunker.NumChunksReady(), 1);
+
+  std::vector<float> chunk;
+  chunker.GetChunk(0, &chunk);
+  ASSERT_EQ(chunk.size(), chunker.Dim() * kWhisperNumFrames);
+  for (float x : chunk) {
+    EXPECT_NEAR(x, -1.5f, 1e-5);
+  }
+}
+
+TEST(WhisperChunker, Overlap) {
+  // 10 seconds
+  int32_t stride = 1000;
+  int32_t num_samples = 16000 * 42;
+  std::vector<float> wave = GetWave(num_samples);
+
+  WhisperFeatureOptions opts;
+  opts.dim = 128;
+  WhisperChunker chunker(opts, stride);
+  AcceptInPieces(wave, &chunker);
+
+  // Chunks 0 and 1 are complete, i.e., they cover frames [0, 4000)
+  EXPECT_EQ(chunker.NumChunksReady(), 2);
+
+  std::vector<float> first;
+  chunker.GetChunk(0, &first);
+
+  chunker.InputFinished();
+
+  // 4200 frames
+  ASSERT_EQ(chunker.NumChunksReady(), 3);
+
+  std::vector<float> chunk;
+  chunker.GetChunk(0, &chunk);
+  EXPECT_EQ(chunk, first);
+
+  // Frames of chunk 0 are discarded except those shared with chunk 1
+  chunker.Pop(1);
+
+  for (int32_t i = 1; i != chunker.NumChunksReady(); ++i) {
+    chunker.GetChunk(i, &chunk);
+
+    int32_t offset = i * stride * 160;
+    std::vector<float> expected;
+    ComputeWhisperLogMel(opts, wave.data() + offset, num_samples - offset,
+                         &expected);
+
+    // The first and the last frames see the neighboring audio instead of
+    // the reflection of the chunk
+    for (int32_t d = 0; d != opts.dim; ++d) {
+      for (int32_t t = 1; t + 1 < kWhisperNumFrames; ++t) {
+        int32_t k = d * kWhisperNumFrames + t;
+        ASSERT_EQ(chunk[k], expected[k]) << i << " " << d << " " << t;
+      }
+    }
+  }
+}
+
+}  // namespace knf
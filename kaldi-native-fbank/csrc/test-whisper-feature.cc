@@ -0,0 +1,140 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/whisper-feature.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+// What users do in Python: pad the audio with zeros to 30 seconds, compute
+// the mel energies of all frames and post-process them.
+static std::vector<float> ComputeReference(const WhisperFeatureOptions &opts,
+                                           std::vector<float> wave) {
+  wave.resize(kWhisperNumSamples);
+
+  OnlineWhisperFbank whisper(opts);
+  whisper.AcceptWaveform(16000, wave.data(), wave.size());
+  whisper.InputFinished();
+  EXPECT_EQ(whisper.NumFramesReady(), kWhisperNumFrames);
+
+  int32_t dim = opts.dim;
+  std::vector<float> log_mel(kWhisperNumFrames * dim);
+  float max_value = -1e30f;
+  for (int32_t f = 0; f != kWhisperNumFrames; ++f) {
+    const float *p = whisper.GetFrame(f);
+    for (int32_t d = 0; d != dim; ++d) {
+      float x = std::log10(std::max(p[d], 1e-10f));
+      log_mel[d * kWhisperNumFrames + f] = x;
+      max_value = std::max(max_value, x);
+    }
+  }
+
+  for (auto &x : log_mel) {
+    x = (std::max(x, max_value - 8) + 4) / 4;
+  }
+  return log_mel;
+}
+
+static void TestComputeWhisperLogMel(int32_t num_samples, int32_t dim) {
+  std::mt19937 gen(20260);
+  std::uniform_real_distribution<float> dist(-0.5, 0.5);
+  std::vector<float> wave(num_samples);
+  for (auto &f : wave) {
+    f = dist(gen);
+  }
+
+  WhisperFeatureOptions opts;
+  opts.dim = dim;
+
+  std::vector<float> expected = ComputeReference(
+      opts, std::vector<float>(
+                wave.begin(),
+                wave.begin() + std::min(num_samples, kWhisperNumSamples)));
+
+  std::vector<float> out;
+  ComputeWhisperLogMel(opts, wave.data(), wave.size(), &out);
+
+  ASSERT_EQ(out.size(), expected.size());
+  for (int32_t i = 0; i != static_cast<int32_t>(out.size()); ++i) {
+    // log10 is computed differently
+    ASSERT_NEAR(out[i], expected[i], 1e-5)
+        << num_samples << " " << i / kWhisperNumFrames << " "
+        << i % kWhisperNumFrames;
+  }
+
+  std::vector<float> transposed;
+  ComputeWhisperLogMel(opts, wave.data(), wave.size(), &transposed,
+                       FeatureLayout::kFrameMajor);
+  ASSERT_EQ(transposed.size(), out.size());
+  for (int32_t t = 0; t != kWhisperNumFrames; ++t) {
+    for (int32_t d = 0; d != dim; ++d) {
+      ASSERT_EQ(transposed[t * dim + d], out[d * kWhisperNumFrames + t]);
+    }
+  }
+}
+
+TEST(ComputeWhisperLogMel, CompareWithPadding) {
+  TestComputeWhisperLogMel(16000 * 5 + 123, 80);
+
+  // The last frames see the reflection of the end of the audio
+  TestComputeWhisperLogMel(kWhisperNumSamples - 50, 128);
+}
+
+TEST(ComputeWhisperLogMel, Empty) {
+  WhisperFeatureOptions opts;
+  std::vector<float> out;
+  ComputeWhisperLogMel(opts, nullptr, 0, &out);
+  ASSERT_EQ(out.size(), opts.dim * kWhisperNumFrames);
+
+  // log10(1e-10) = -10 is also the max
+  for (float x : out) {
+    EXPECT_NEAR(x, -1.5f, 1e-5);
+  }
+}
+
+TEST(WhisperLogMelNormalizer, Streaming) {
+  WhisperLogMelNormalizer normalizer;
+  EXPECT_EQ(normalizer.Max(), -std::numeric_limits<float>::infinity());
+
+  std::vector<float> a = {-3, -1, -12};
+  normalizer.Accept(a.data(), a.size());
+  EXPECT_EQ(normalizer.Max(), -1);
+
+  normalizer.Normalize(a.data(), a.size());
+  EXPECT_EQ(a, (std::vector<float>{0.25f, 0.75f, -1.25f}));
+
+  // The max is running
+  std::vector<float> b = {2, -7};
+  normalizer.Accept(b.data(), b.size());
+  EXPECT_EQ(normalizer.Max(), 2);
+  normalizer.Normalize(b.data(), b.size());
+  EXPECT_EQ(b, (std::vector<float>{1.5f, -0.5f}));
+
+  normalizer.Reset();
+  EXPECT_EQ(normalizer.Max(), -std::numeric_limits<float>::infinity());
+}
+
+}  // namespace knf
@@ -0,0 +1,64 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_THREAD_POOL_H_
+#define KALDI_NATIVE_FBANK_CSRC_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace knf {
+
+// A fixed-size pool of worker threads running tasks in FIFO order.
+class ThreadPool {
+ public:
+  // @param num_threads If it is <= 0, std::thread::hardware_concurrency()
+  //                    threads are used.
+  explicit ThreadPool(int32_t num_threads = 1);
+
+  // It waits for all submitted tasks to finish.
+  ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  int32_t NumThreads() const { return static_cast<int32_t>(threads_.size()); }
+
+  // Thread-safe
+  void Submit(std::function<void()> task);
+
+ private:
+  void Run();
+
+ private:
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<std::function<void()>> tasks_;
+  bool stop_ = false;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_THREAD_POOL_H_
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/csrc/whisper-chunker.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/log.h"
+
+namespace knf {
+
+static WhisperFeatureOptions GetLogMelOptions(WhisperFeatureOptions opts) {
+  opts.log_mel = true;
+  opts.frame_opts.output_dtype = "float32";
+  return opts;
+}
+
+WhisperChunker::WhisperChunker(const WhisperFeatureOptions &opts /*= {}*/,
+                               int32_t stride /*= kWhisperNumFrames*/)
+    : fbank_(GetLogMelOptions(opts)), dim_(opts.dim), stride_(stride) {
+  KNF_CHECK_GT(stride, 0);
+  KNF_CHECK_LE(stride, kWhisperNumFrames);
+
+  WhisperFeatureComputer computer(GetLogMelOptions(opts));
+  frame_opts_ = computer.GetFrameOptions();
+
+  std::vector<float> window(frame_opts_.PaddedWindowSize());
+  silence_.resize(dim_);
+  computer.Compute(0, 1.0f, &window, silence_.data());
+}
+
+void WhisperChunker::AcceptWaveform(const float *samples, int32_t n) {
+  KNF_CHECK(!input_finished_);
+  num_samples_ += n;
+  fbank_.AcceptWaveform(frame_opts_.samp_freq, samples, n);
+}
+
+void WhisperChunker::InputFinished() {
+  if (input_finished_) {
+    return;
+  }
+
+  // Frames computed so far lie inside the audio. At most a few more frames
+  // overlap with it.
+  num_audio_frames_ = fbank_.NumFramesReady();
+  while (FirstSampleOfFrame(num_audio_frames_, frame_opts_) < num_samples_) {
+    ++num_audio_frames_;
+  }
+
+  // The audio is followed by zeros, so the last frames must not see the
+  // reflection of the audio at the end. Frames after num_audio_frames_,
+  // which see only zeros, are not used.
+  std::vector<float> zeros(frame_opts_.WindowSize());
+  fbank_.AcceptWaveform(frame_opts_.samp_freq, zeros.data(), zeros.size());
+  fbank_.InputFinished();
+
+  input_finished_ = true;
+}
+
+int32_t WhisperChunker::NumAudioFramesReady() const {
+  return input_finished_ ? num_audio_frames_ : fbank_.NumFramesReady();
+}
+
+int32_t WhisperChunker::NumChunksReady() const {
+  int32_t num_frames = NumAudioFramesReady();
+  if (num_frames < kWhisperNumFrames) {
+    return input_finished_ ? 1 : 0;
+  }
+
+  int32_t n = num_frames - kWhisperNumFrames;
+  if (input_finished_) {
+    // The last chunk may be partial
+    return (n + stride_ - 1) / stride_ + 1;
+  }
+
+  return n / stride_ + 1;
+}
+
+void WhisperChunker::GetChunk(
+    int32_t i, std::vector<float> *out,
+    FeatureLayout layout /*= FeatureLayout::kFeatureMajor*/) const {
+  KNF_CHECK_GE(i, num_popped_chunks_);
+  KNF_CHECK_LT(i, NumChunksReady());
+
+  int32_t start = i * stride_;
+  int32_t num_frames = NumAudioFramesReady();
+
+  std::vector<const float *> frames(kWhisperNumFrames);
+  WhisperLogMelNormalizer normalizer;
+  for (int32_t t = 0; t != kWhisperNumFrames; ++t) {
+    int32_t f = start + t;
+    frames[t] = f < num_frames ? fbank_.GetFrame(f) : silence_.data();
+    normalizer.Accept(frames[t], dim_);
+  }
+
+  out->resize(dim_ * kWhisperNumFrames);
+  WriteFrames(frames.data(), kWhisperNumFrames, dim_, layout, 0, out->data());
+  normalizer.Normalize(out->data(), out->size());
+}
+
+void WhisperChunker::Pop(int32_t n) {
+  num_popped_chunks_ += n;
+
+  // Frames that are not computed yet are popped by a later call
+  int32_t num_frames =
+      std::min(num_popped_chunks_ * stride_, fbank_.NumFramesReady());
+
+  fbank_.Pop(num_frames - num_popped_frames_);
+  num_popped_frames_ = num_frames;
+}
+
+}  // namespace knf
@@ -0,0 +1,120 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef KALDI_NATIVE_FBANK_CSRC_WHISPER_CHUNKER_H_
+#define KALDI_NATIVE_FBANK_CSRC_WHISPER_CHUNKER_H_
+
+#include <cstdint>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/feature-layout.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/whisper-feature.h"
+
+namespace knf {
+
+/**
+ * It splits audio of any length into chunks of kWhisperNumFrames frames,
+ * i.e., the input of the Whisper encoder.
+ *
+ * Chunk i covers frames [i * stride, i * stride + kWhisperNumFrames). Each
+ * frame is computed only once, even if it belongs to several chunks. Frames
+ * after the end of the audio are filled with the features of silence, which
+ * are computed only once in the constructor.
+ *
+ * Each chunk is normalized with its own max. See WhisperLogMelNormalizer.
+ * If the audio has fewer than kWhisperNumSamples - 400 samples, chunk 0 is
+ * the same as the output of ComputeWhisperLogMel(). Otherwise, frames at the
+ * boundary of a chunk see the neighboring audio instead of the padding.
+ *
+ * Usage:
+ *
+ *   WhisperChunker chunker(opts, 1500);
+ *   chunker.AcceptWaveform(samples, n);  // can be called many times
+ *   chunker.InputFinished();
+ *   std::vector<float> chunk;
+ *   for (int32_t i = 0; i != chunker.NumChunksReady(); ++i) {
+ *     chunker.GetChunk(i, &chunk);  // [opts.dim, kWhisperNumFrames]
+ *   }
+ */
+class WhisperChunker {
+ public:
+  /**
+   * @param opts  opts.log_mel and opts.frame_opts.output_dtype are ignored.
+   * @param stride  Number of frames between the start of two successive
+   *                chunks. It should be in the range (0, kWhisperNumFrames].
+   *                Chunks overlap if it is less than kWhisperNumFrames.
+   */
+  explicit WhisperChunker(const WhisperFeatureOptions &opts = {},
+                          int32_t stride = kWhisperNumFrames);
+
+  int32_t Dim() const { return dim_; }
+
+  int32_t Stride() const { return stride_; }
+
+  /// @param samples  Pointer to n samples at 16 kHz, normalized to [-1, 1].
+  void AcceptWaveform(const float *samples, int32_t n);
+
+  /// Tell the chunker that no more audio is coming. It flushes the last,
+  /// partial chunk.
+  void InputFinished();
+
+  /// Number of chunks that GetChunk() accepts. A chunk is ready once all of
+  /// its frames are computed. After InputFinished(), it is the number of
+  /// chunks needed to cover the audio, which is at least 1.
+  int32_t NumChunksReady() const;
+
+  /**
+   * @param i  Index of the chunk. It should be less than NumChunksReady()
+   *           and it should not have been discarded by Pop().
+   * @param out  On return, a row-major matrix of shape
+   *             [Dim(), kWhisperNumFrames], or [kWhisperNumFrames, Dim()]
+   *             if layout is kFrameMajor.
+   */
+  void GetChunk(int32_t i, std::vector<float> *out,
+                FeatureLayout layout = FeatureLayout::kFeatureMajor) const;
+
+  /// Discard the frames used only by the first n remaining chunks.
+  /// Chunk indexes passed to GetChunk() are not changed.
+  void Pop(int32_t n);
+
+ private:
+  // Number of frames that overlap with the audio and are computed
+  int32_t NumAudioFramesReady() const;
+
+  OnlineWhisperFbank fbank_;  // with log_mel == true
+  FrameExtractionOptions frame_opts_;
+  int32_t dim_;
+  int32_t stride_;
+
+  // Stage-1 features of a frame containing only zeros
+  std::vector<float> silence_;
+
+  int64_t num_samples_ = 0;
+
+  // Valid only after InputFinished()
+  int32_t num_audio_frames_ = 0;
+  bool input_finished_ = false;
+
+  int32_t num_popped_chunks_ = 0;
+  int32_t num_popped_frames_ = 0;
+};
+
+}  // namespace knf
+
+#endif  // KALDI_NATIVE_FBANK_CSRC_WHISPER_CHUNKER_H_
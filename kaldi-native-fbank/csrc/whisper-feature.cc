@@ -18,12 +18,15 @@
 
 #include "kaldi-native-fbank/csrc/whisper-feature.h"
 
+#include <algorithm>
 #include <cmath>
 #include <string>
 #include <vector>
 
 #include "kaldi-native-fbank/csrc/log.h"
 #include "kaldi-native-fbank/csrc/mel-computations.h"
+#include "kaldi-native-fbank/csrc/profiling.h"
+#include "kaldi-native-fbank/csrc/simd.h"
 
 #ifndef M_2PI
 #define M_2PI 6.283185307179586476925286766559005
@@ -35,10 +38,14 @@ std::string WhisperFeatureOptions::ToString() const {
   std::ostringstream os;
   os << "WhisperFeatureOptions(";
   os << "frame_opts=" << frame_opts.ToString() << ", ";
-  os << "dim=" << dim << ")";
+  os << "dim=" << dim << ", ";
+  os << "log_mel=" << (log_mel ? "True" : "False") << ")";
   return os.str();
 }
 
+// log10(x) = log(x) * log10(e)
+static constexpr float kLog10E = 0.434294481903251827651f;
+
 static void dft(const std::vector<float> &in, std::vector<float> *out) {
   // this function is modified from
   // https://github.com/ggerganov/whisper.cpp/blob/master/whisper.cpp#L2353
@@ -135,35 +142,176 @@ WhisperFeatureComputer::WhisperFeatureComputer(
   opts_.frame_opts.window_type = "hann";
   opts_.frame_opts.round_to_power_of_two = false;
   opts_.frame_opts.snip_edges = false;
+  fast_math_ = opts_.frame_opts.UseFastMath();
 
   MelBanksOptions mel_opts;
   mel_opts.num_bins = opts_.dim;
   mel_opts.low_freq = 0;
   mel_opts.is_librosa = true;
 
-  mel_banks_ = std::make_unique<MelBanks>(mel_opts, opts_.frame_opts, 1.0f);
+  mel_banks_ = MelBanksCache::Get(mel_opts, opts_.frame_opts, 1.0f);
 }
 
 void WhisperFeatureComputer::Compute(float /*signal_raw_log_energy*/,
                                      float /*vtln_warp*/,
                                      std::vector<float> *signal_frame,
                                      float *feature) {
-  KNF_CHECK_EQ(signal_frame->size(), frame_opts_.PaddedWindowSize());
+  KNF_CHECK_EQ(signal_frame->size(), opts_.frame_opts.PaddedWindowSize());
   // we have already applied window function to signal_frame before
   // calling this method
   std::vector<float> fft_out;
-  fft(*signal_frame, &fft_out);
+  {
+    KNF_PROFILE_SCOPE(kProfileFft);
+    fft(*signal_frame, &fft_out);
+  }
 
   int32_t num_fft = signal_frame->size();
   std::vector<float> power(num_fft / 2 + 1);
-  for (int32_t i = 0; i <= num_fft / 2; ++i) {
-    float re = fft_out[2 * i + 0];
-    float im = fft_out[2 * i + 1];
-    power[i] = re * re + im * im;
+  {
+    KNF_PROFILE_SCOPE(kProfilePowerSpectrum);
+    for (int32_t i = 0; i <= num_fft / 2; ++i) {
+      float re = fft_out[2 * i + 0];
+      float im = fft_out[2 * i + 1];
+      power[i] = re * re + im * im;
+    }
   }
 
   // feature is pre-allocated by the user
-  mel_banks_->Compute(power.data(), feature);
+  {
+    KNF_PROFILE_SCOPE(kProfileMel);
+    mel_banks_->Compute(power.data(), feature);
+  }
+
+  if (opts_.log_mel) {
+    KNF_PROFILE_SCOPE(kProfileLog);
+    const SimdKernels &kernels = GetSimdKernels();
+    auto log = fast_math_ ? kernels.log_fast : kernels.log;
+    log(1e-10f, feature, opts_.dim);
+
+    for (int32_t i = 0; i != opts_.dim; ++i) {
+      feature[i] *= kLog10E;
+    }
+  }
+}
+
+void WhisperFeatureComputer::ComputeBatch(
+    const float * /*raw_log_energies*/, float /*vtln_warp*/,
+    std::vector<float> *frames, int32_t n, float *const *features) {
+  int32_t padded_window_size = opts_.frame_opts.PaddedWindowSize();
+  std::vector<float> fft_out;
+  for (int32_t i = 0; i != n; ++i) {
+    KNF_CHECK_EQ(frames[i].size(), padded_window_size);
+    {
+      KNF_PROFILE_SCOPE(kProfileFft);
+      fft(frames[i], &fft_out);
+    }
+
+    // The power spectrum of size padded_window_size / 2 + 1 is written
+    // back to frames[i]
+    KNF_PROFILE_SCOPE(kProfilePowerSpectrum);
+    float *power = frames[i].data();
+    for (int32_t k = 0; k <= padded_window_size / 2; ++k) {
+      float re = fft_out[2 * k + 0];
+      float im = fft_out[2 * k + 1];
+      power[k] = re * re + im * im;
+    }
+  }
+
+  for (int32_t i = 0; i != n; ++i) {
+    KNF_PROFILE_SCOPE(kProfileMel);
+    mel_banks_->Compute(frames[i].data(), features[i]);
+  }
+
+  if (opts_.log_mel) {
+    const SimdKernels &kernels = GetSimdKernels();
+    auto log = fast_math_ ? kernels.log_fast : kernels.log;
+    for (int32_t i = 0; i != n; ++i) {
+      KNF_PROFILE_SCOPE(kProfileLog);
+      float *feature = features[i];
+      log(1e-10f, feature, opts_.dim);
+      for (int32_t k = 0; k != opts_.dim; ++k) {
+        feature[k] *= kLog10E;
+      }
+    }
+  }
+}
+
+void WhisperLogMelNormalizer::Accept(const float *x, int32_t n) {
+  float m = max_;
+  for (int32_t i = 0; i != n; ++i) {
+    m = std::max(m, x[i]);
+  }
+  max_ = m;
+}
+
+void WhisperLogMelNormalizer::Normalize(float *x, int32_t n) const {
+  float floor = max_ - 8.0f;
+  for (int32_t i = 0; i != n; ++i) {
+    x[i] = (std::max(x[i], floor) + 4.0f) / 4.0f;
+  }
+}
+
+void ComputeWhisperLogMel(
+    const WhisperFeatureOptions &opts, const float *samples, int32_t n,
+    std::vector<float> *out,
+    FeatureLayout layout /*= FeatureLayout::kFeatureMajor*/) {
+  WhisperFeatureOptions log_opts = opts;
+  log_opts.log_mel = true;
+  WhisperFeatureComputer computer(log_opts);
+
+  const FrameExtractionOptions &frame_opts = computer.GetFrameOptions();
+  FeatureWindowFunction window_function(frame_opts);
+  int32_t frame_length = frame_opts.WindowSize();
+  int32_t dim = opts.dim;
+
+  // The audio is padded with zeros to 30 seconds. Only the part of the
+  // padding that is read by the computed frames is materialized.
+  int32_t num_samples = std::min(std::max(n, 0), kWhisperNumSamples);
+  int32_t padded = std::min(num_samples + frame_length, kWhisperNumSamples);
+  std::vector<float> wave(padded);
+  std::copy(samples, samples + num_samples, wave.begin());
+
+  std::vector<float> window(frame_opts.PaddedWindowSize());
+  std::vector<float> scratch;  // for dithering
+  std::vector<float> silence(dim);
+  computer.Compute(0, 1.0f, &window, silence.data());
+
+  // [kWhisperNumFrames, dim]
+  std::vector<float> log_mel(kWhisperNumFrames * dim);
+  for (int32_t f = 0; f != kWhisperNumFrames; ++f) {
+    float *p = log_mel.data() + f * dim;
+    int64_t first = FirstSampleOfFrame(f, frame_opts);
+
+    // The last frames of a full chunk also see the reflection of the end of
+    // the audio
+    bool need = first < num_samples ||
+                (padded == kWhisperNumSamples && first + frame_length > padded);
+    if (!need) {
+      std::copy(silence.begin(), silence.end(), p);
+      continue;
+    }
+
+    ExtractWindow(0, wave, f, frame_opts, window_function, &window, nullptr,
+                  &scratch);
+    computer.Compute(0, 1.0f, &window, p);
+  }
+
+  WhisperLogMelNormalizer normalizer;
+  normalizer.Accept(log_mel.data(), log_mel.size());
+  normalizer.Normalize(log_mel.data(), log_mel.size());
+
+  if (layout == FeatureLayout::kFrameMajor) {
+    out->swap(log_mel);
+    return;
+  }
+
+  std::vector<const float *> frames(kWhisperNumFrames);
+  for (int32_t f = 0; f != kWhisperNumFrames; ++f) {
+    frames[f] = log_mel.data() + f * dim;
+  }
+
+  out->resize(dim * kWhisperNumFrames);
+  WriteFrames(frames.data(), kWhisperNumFrames, dim, layout, 0, out->data());
 }
 
 }  // namespace knf
@@ -20,10 +20,12 @@
 #define KALDI_NATIVE_FBANK_CSRC_WHISPER_FEATURE_H_
 
 #include <cstdint>
+#include <limits>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include "kaldi-native-fbank/csrc/feature-layout.h"
 #include "kaldi-native-fbank/csrc/feature-window.h"
 #include "kaldi-native-fbank/csrc/mel-computations.h"
 
@@ -37,9 +39,18 @@ struct WhisperFeatureOptions {
   FrameExtractionOptions frame_opts;
   int32_t dim = 80;
 
+  // If true, Compute() outputs log10(max(mel_energies, 1e-10)) instead of
+  // the mel energies, i.e., the first stage of the log-mel features of
+  // Whisper. See WhisperLogMelNormalizer for the second stage.
+  bool log_mel = false;
+
   std::string ToString() const;
 };
 
+// Whisper processes audio in chunks of 30 seconds, i.e., 3000 frames
+constexpr int32_t kWhisperNumSamples = 480000;
+constexpr int32_t kWhisperNumFrames = 3000;
+
 class WhisperFeatureComputer {
  public:
   // note: opts.frame_opts is ignored and we reset it inside
@@ -54,16 +65,79 @@ class WhisperFeatureComputer {
   void Compute(float /*signal_raw_log_energy*/, float /*vtln_warp*/,
                std::vector<float> *signal_frame, float *feature);
 
+  // Like Compute(), but for n frames, one stage at a time.
+  // See FbankComputer::ComputeBatch()
+  void ComputeBatch(const float * /*raw_log_energies*/, float /*vtln_warp*/,
+                    std::vector<float> *frames, int32_t n,
+                    float *const *features);
+
   // if true, compute log_energy_pre_window but after dithering and dc removal
   bool NeedRawLogEnergy() const { return false; }
 
   using Options = WhisperFeatureOptions;
 
  private:
-  std::unique_ptr<MelBanks> mel_banks_;
+  // shared with other computers through MelBanksCache
+  std::shared_ptr<const MelBanks> mel_banks_;
   WhisperFeatureOptions opts_;
+  bool fast_math_ = false;  // opts_.frame_opts.accuracy is "fast"
+};
+
+/**
+ * The second stage of the log-mel features of Whisper:
+ *
+ *   y = (max(x, m - 8) + 4) / 4
+ *
+ * where x is the output of WhisperFeatureComputer with log_mel == true and m
+ * is the maximum of x over the whole utterance.
+ *
+ * For streaming, call Accept() with each new frame and then Normalize() it.
+ * The running max never decreases, so a frame normalized early may differ
+ * from the offline result if a later frame has a larger value.
+ */
+class WhisperLogMelNormalizer {
+ public:
+  /// Update the running max with n log-mel values.
+  void Accept(const float *x, int32_t n);
+
+  /// Normalize n log-mel values in place with the current max.
+  void Normalize(float *x, int32_t n) const;
+
+  /// Return -infinity if Accept() has not been called.
+  float Max() const { return max_; }
+
+  void Reset() { max_ = -std::numeric_limits<float>::infinity(); }
+
+ private:
+  float max_ = -std::numeric_limits<float>::infinity();
 };
 
+/**
+ * Compute the input of the Whisper encoder for at most 30 seconds of audio.
+ * The audio is padded with zeros to 30 seconds, the features are computed
+ * as OnlineWhisperFbank does, and then they are normalized with
+ * WhisperLogMelNormalizer. Samples after 30 seconds are ignored.
+ *
+ * Note that it is not identical to log_mel_spectrogram(pad_or_trim(audio))
+ * from openai-whisper. The frames use the framing of Kaldi with
+ * snip_edges=false, while torch.stft(center=True) starts each frame 80
+ * samples earlier and pads with a reflection of the audio.
+ *
+ * Only frames overlapping with the audio are computed. The remaining ones,
+ * which see only the zero padding, are filled with the features of silence.
+ *
+ * @param opts  opts.log_mel is ignored.
+ * @param samples  Pointer to n samples at 16 kHz, normalized to [-1, 1].
+ * @param n  Number of samples. It can be 0.
+ * @param out  On return, a row-major matrix of shape
+ *             [opts.dim, kWhisperNumFrames], as expected by Whisper, or
+ *             [kWhisperNumFrames, opts.dim] if layout is kFrameMajor.
+ */
+void ComputeWhisperLogMel(
+    const WhisperFeatureOptions &opts, const float *samples, int32_t n,
+    std::vector<float> *out,
+    FeatureLayout layout = FeatureLayout::kFeatureMajor);
+
 }  // namespace knf
 
 #endif  // KALDI_NATIVE_FBANK_CSRC_WHISPER_FEATURE_H_
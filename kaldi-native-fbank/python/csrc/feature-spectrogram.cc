@@ -0,0 +1,45 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "kaldi-native-fbank/python/csrc/feature-spectrogram.h"
+
+#include <string>
+
+#include "kaldi-native-fbank/csrc/feature-spectrogram.h"
+
+namespace knf {
+
+static void PybindSpectrogramOptions(py::module &m) {  // NOLINT
+  using PyClass = SpectrogramOptions;
+  py::class_<PyClass>(m, "SpectrogramOptions")
+      .def(py::init<>())
+      .def_readwrite("frame_opts", &PyClass::frame_opts)
+      .def_readwrite("energy_floor", &PyClass::energy_floor)
+      .def_readwrite("raw_energy", &PyClass::raw_energy)
+      .def_readwrite("use_energy", &PyClass::use_energy)
+      .def_readwrite("use_log", &PyClass::use_log)
+      .def_readwrite("high_freq", &PyClass::high_freq)
+      .def("__str__",
+           [](const PyClass &self) -> std::string { return self.ToString(); });
+}
+
+void PybindFeatureSpectrogram(py::module &m) {  // NOLINT
+  PybindSpectrogramOptions(m);
+}
+
+}  // namespace knf
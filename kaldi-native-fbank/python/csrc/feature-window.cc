@@ -40,6 +40,10 @@ static void PybindFrameExtractionOptions(py::module &m) {  // NOLINT
       .def_readwrite("round_to_power_of_two", &PyClass::round_to_power_of_two)
       .def_readwrite("blackman_coeff", &PyClass::blackman_coeff)
       .def_readwrite("snip_edges", &PyClass::snip_edges)
+      .def_readwrite("allow_downsample", &PyClass::allow_downsample)
+      .def_readwrite("allow_upsample", &PyClass::allow_upsample)
+      .def_readwrite("accuracy", &PyClass::accuracy)
+      .def_readwrite("output_dtype", &PyClass::output_dtype)
       .def("as_dict",
            [](const PyClass &self) -> py::dict { return AsDict(self); })
       .def_static("from_dict",
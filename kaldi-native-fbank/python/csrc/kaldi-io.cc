@@ -0,0 +1,163 @@
+/**
+ * Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+ *
+ * See LICENSE for clarification regarding multiple authors
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "kaldi-native-fbank/python/csrc/kaldi-io.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "kaldi-native-fbank/csrc/compressed-matrix.h"
+#include "kaldi-native-fbank/csrc/kaldi-io.h"
+#include "kaldi-native-fbank/csrc/online-feature.h"
+
+namespace knf {
+
+template <typename F>
+void DefWriteFeature(py::class_<ArkWriter> *c) {
+  c->def(
+       "write",
+       [](ArkWriter &self, const std::string &key, const F &feature) {
+         self.Write(key, feature);
+       },
+       py::arg("key"), py::arg("feature"),
+       py::call_guard<py::gil_scoped_release>())
+      .def(
+          "write_compressed",
+          [](ArkWriter &self, const std::string &key, const F &feature,
+             CompressionMethod method) {
+            self.WriteCompressed(key, feature, method);
+          },
+          py::arg("key"), py::arg("feature"),
+          py::arg("method") = CompressionMethod::kAutomatic,
+          py::call_guard<py::gil_scoped_release>());
+}
+
+static void PybindCompressionMethod(py::module &m) {  // NOLINT
+  py::enum_<CompressionMethod>(m, "CompressionMethod")
+      .value("kAutomatic", CompressionMethod::kAutomatic)
+      .value("kSpeechFeature", CompressionMethod::kSpeechFeature)
+      .value("kTwoByteAuto", CompressionMethod::kTwoByteAuto)
+      .value("kOneByteAuto", CompressionMethod::kOneByteAuto);
+}
+
+static void PybindArkWriter(py::module &m) {  // NOLINT
+  using PyClass = ArkWriter;
+  py::class_<PyClass> c(m, "ArkWriter");
+  c.def(py::init<const std::string &, const std::string &>(),
+        py::arg("ark_filename"), py::arg("scp_filename") = "")
+      .def(
+          "write",
+          [](PyClass &self, const std::string &key,
+             py::array_t<float, py::array::c_style | py::array::forcecast>
+                 m) {
+            if (m.ndim() != 2) {
+              throw py::value_error("Expect a 2-D array. Given: " +
+                                    std::to_string(m.ndim()));
+            }
+            const float *p = m.data();
+            int32_t num_rows = m.shape(0);
+            int32_t num_cols = m.shape(1);
+            py::gil_scoped_release release;
+            self.Write(key, p, num_rows, num_cols);
+          },
+          py::arg("key"), py::arg("m"))
+      .def(
+          "write_compressed",
+          [](PyClass &self, const std::string &key,
+             py::array_t<float, py::array::c_style | py::array::forcecast> m,
+             CompressionMethod method) {
+            if (m.ndim() != 2) {
+              throw py::value_error("Expect a 2-D array. Given: " +
+                                    std::to_string(m.ndim()));
+            }
+            const float *p = m.data();
+            int32_t num_rows = m.shape(0);
+            int32_t num_cols = m.shape(1);
+            py::gil_scoped_release release;
+            self.Write(key, CompressedMatrix(p, num_rows, num_cols, method));
+          },
+          py::arg("key"), py::arg("m"),
+          py::arg("method") = CompressionMethod::kAutomatic)
+      .def("close", &PyClass::Close)
+      .def("__enter__", [](PyClass &self) -> PyClass & { return self; })
+      .def("__exit__",
+           [](PyClass &self, py::object, py::object, py::object) {
+             self.Close();
+           });
+
+  DefWriteFeature<OnlineFbank>(&c);
+  DefWriteFeature<OnlineMfcc>(&c);
+  DefWriteFeature<OnlineWhisperFbank>(&c);
+}
+
+static void PybindArkReader(py::module &m) {  // NOLINT
+  using PyClass = ArkReader;
+  py::class_<PyClass>(m, "ArkReader")
+      .def(py::init<const std::string &>(), py::arg("ark_filename"),
+           py::call_guard<py::gil_scoped_release>())
+      .def("keys", &PyClass::Keys)
+      .def("__len__",
+           [](const PyClass &self) -> int32_t { return self.Keys().size(); })
+      .def("__contains__", &PyClass::Contains, py::arg("key"))
+      .def("is_compressed", &PyClass::IsCompressed, py::arg("key"))
+      .def(
+          "__getitem__",
+          [](py::object obj, const std::string &key) {
+            const auto *self = obj.cast<const PyClass *>();
+            if (!self->Contains(key)) {
+              throw py::key_error(key);
+            }
+
+            if (self->IsCompressed(key)) {
+              FloatMatrixView m = self->Get(key);
+              py::array_t<float> ans({m.num_rows, m.num_cols});
+              std::vector<float> tmp;
+              {
+                py::gil_scoped_release release;
+                self->Read(key, &tmp, &m.num_rows, &m.num_cols);
+              }
+              std::copy(tmp.begin(), tmp.end(), ans.mutable_data());
+              return ans;
+            }
+
+            FloatMatrixView m = self->Get(key);
+
+            // It shares memory with the reader, i.e., the mapped file or
+            // an aligned copy of it, and keeps the reader alive.
+            py::array_t<float> ans(
+                {m.num_rows, m.num_cols},
+                {m.num_cols * static_cast<int32_t>(sizeof(float)),
+                 static_cast<int32_t>(sizeof(float))},
+                m.data, obj);
+            py::detail::array_proxy(ans.ptr())->flags &=
+                ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+            return ans;
+          },
+          py::arg("key"));
+}
+
+void PybindKaldiIo(py::module &m) {  // NOLINT
+  PybindCompressionMethod(m);
+  PybindArkWriter(m);
+  PybindArkReader(m);
+}
+
+}  // namespace knf
@@ -20,8 +20,10 @@
 
 #include "kaldi-native-fbank/python/csrc/feature-fbank.h"
 #include "kaldi-native-fbank/python/csrc/feature-mfcc.h"
+#include "kaldi-native-fbank/python/csrc/feature-spectrogram.h"
 #include "kaldi-native-fbank/python/csrc/feature-window.h"
 #include "kaldi-native-fbank/python/csrc/istft.h"
+#include "kaldi-native-fbank/python/csrc/kaldi-io.h"
 #include "kaldi-native-fbank/python/csrc/mel-computations.h"
 #include "kaldi-native-fbank/python/csrc/online-feature.h"
 #include "kaldi-native-fbank/python/csrc/rfft.h"
@@ -35,11 +37,13 @@ PYBIND11_MODULE(_kaldi_native_fbank, m) {
   PybindMelComputations(m);
   PybindFeatureFbank(m);
   PybindFeatureMfcc(m);
+  PybindFeatureSpectrogram(m);
   PybindRfft(m);
   PybindStft(&m);
   PybindIStft(&m);
 
   PybindOnlineFeature(m);
+  PybindKaldiIo(m);
 }
 
 }  // namespace knf
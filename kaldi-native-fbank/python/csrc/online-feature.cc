@@ -18,13 +18,24 @@
 
 #include "kaldi-native-fbank/python/csrc/online-feature.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include "kaldi-native-fbank/csrc/chunk-assembler.h"
 #include "kaldi-native-fbank/csrc/feature-fbank.h"
+#include "kaldi-native-fbank/csrc/feature-layout.h"
 #include "kaldi-native-fbank/csrc/feature-mfcc.h"
+#include "kaldi-native-fbank/csrc/feature-multi.h"
+#include "kaldi-native-fbank/csrc/feature-spectrogram.h"
+#include "kaldi-native-fbank/csrc/multi-stream-online-feature.h"
+#include "kaldi-native-fbank/csrc/online-cmvn.h"
+#include "kaldi-native-fbank/csrc/online-delta-feature.h"
 #include "kaldi-native-fbank/csrc/online-feature.h"
+#include "kaldi-native-fbank/csrc/online-lfr-feature.h"
+#include "kaldi-native-fbank/csrc/whisper-chunker.h"
 #include "kaldi-native-fbank/csrc/whisper-feature.h"
 #include "kaldi-native-fbank/python/csrc/utils.h"
 
@@ -40,6 +51,7 @@ static void PybindWhisperFeatureOptions(py::module &m) {  // NOLINT
       .def(py::init<>())
       .def_readwrite("frame_opts", &PyClass::frame_opts)
       .def_readwrite("dim", &PyClass::dim)
+      .def_readwrite("log_mel", &PyClass::log_mel)
       .def("__str__",
            [](const PyClass &self) -> std::string { return self.ToString(); })
       .def("as_dict",
@@ -55,14 +67,204 @@ static void PybindWhisperFeatureOptions(py::module &m) {  // NOLINT
           }));
 }
 
+static void PybindFeatureLayout(py::module &m) {  // NOLINT
+  py::enum_<FeatureLayout>(m, "FeatureLayout")
+      .value("kFrameMajor", FeatureLayout::kFrameMajor)
+      .value("kFeatureMajor", FeatureLayout::kFeatureMajor);
+}
+
+// Return an array of shape [num_frames, dim] or [dim, num_frames]
+static py::array_t<float> NewFeatureArray(FeatureLayout layout,
+                                          int32_t num_frames, int32_t dim) {
+  if (layout == FeatureLayout::kFrameMajor) {
+    return py::array_t<float>({num_frames, dim});
+  }
+  return py::array_t<float>({dim, num_frames});
+}
+
+static void PybindOnlineCmvnOptions(py::module &m) {  // NOLINT
+  using PyClass = OnlineCmvnOptions;
+  py::class_<PyClass>(m, "OnlineCmvnOptions")
+      .def(py::init<>())
+      .def_readwrite("mode", &PyClass::mode)
+      .def_readwrite("cmn_window", &PyClass::cmn_window)
+      .def_readwrite("normalize_variance", &PyClass::normalize_variance)
+      .def_readwrite("global_cmvn_stats", &PyClass::global_cmvn_stats)
+      .def("__str__",
+           [](const PyClass &self) -> std::string { return self.ToString(); });
+}
+
+static void PybindDeltaFeaturesOptions(py::module &m) {  // NOLINT
+  using PyClass = DeltaFeaturesOptions;
+  py::class_<PyClass>(m, "DeltaFeaturesOptions")
+      .def(py::init<>())
+      .def_readwrite("order", &PyClass::order)
+      .def_readwrite("window", &PyClass::window)
+      .def("__str__",
+           [](const PyClass &self) -> std::string { return self.ToString(); });
+}
+
+static void PybindLfrOptions(py::module &m) {  // NOLINT
+  using PyClass = LfrOptions;
+  py::class_<PyClass>(m, "LfrOptions")
+      .def(py::init<>())
+      .def_readwrite("lfr_m", &PyClass::lfr_m)
+      .def_readwrite("lfr_n", &PyClass::lfr_n)
+      .def("__str__",
+           [](const PyClass &self) -> std::string { return self.ToString(); });
+}
+
+static void PybindChunkAssemblerOptions(py::module &m) {  // NOLINT
+  using PyClass = ChunkAssemblerOptions;
+  py::class_<PyClass>(m, "ChunkAssemblerOptions")
+      .def(py::init<>())
+      .def_readwrite("chunk_size", &PyClass::chunk_size)
+      .def_readwrite("left_context", &PyClass::left_context)
+      .def_readwrite("padding_value", &PyClass::padding_value)
+      .def("__str__",
+           [](const PyClass &self) -> std::string { return self.ToString(); });
+}
+
+// Note: fbank and mfcc are returned as copies, so assign a new list to them
+// instead of appending to them
+static void PybindMultiFeatureOptions(py::module &m) {  // NOLINT
+  using PyClass = MultiFeatureOptions;
+  py::class_<PyClass>(m, "MultiFeatureOptions")
+      .def(py::init<>())
+      .def_readwrite("frame_opts", &PyClass::frame_opts)
+      .def_readwrite("fbank", &PyClass::fbank)
+      .def_readwrite("mfcc", &PyClass::mfcc)
+      .def_readwrite("use_power_spectrum", &PyClass::use_power_spectrum)
+      .def_readwrite("use_energy", &PyClass::use_energy)
+      .def_readwrite("raw_energy", &PyClass::raw_energy)
+      .def("__str__",
+           [](const PyClass &self) -> std::string { return self.ToString(); });
+}
+
+static void PybindWhisperLogMel(py::module &m) {  // NOLINT
+  using PyClass = WhisperLogMelNormalizer;
+  py::class_<PyClass>(m, "WhisperLogMelNormalizer")
+      .def(py::init<>())
+      .def(
+          "accept",
+          [](PyClass &self, py::array_t<float, py::array::c_style> x) {
+            self.Accept(x.data(), x.size());
+          },
+          py::arg("x"))
+      .def(
+          "normalize",
+          [](const PyClass &self, py::array_t<float, py::array::c_style> x)
+              -> py::array_t<float> {
+            py::array_t<float> ans(x.request().shape);
+            std::copy(x.data(), x.data() + x.size(), ans.mutable_data());
+            self.Normalize(ans.mutable_data(), ans.size());
+            return ans;
+          },
+          py::arg("x"))
+      .def("reset", &PyClass::Reset)
+      .def_property_readonly("max", &PyClass::Max);
+
+  m.def(
+      "compute_whisper_log_mel",
+      [](const WhisperFeatureOptions &opts,
+         py::array_t<float, py::array::c_style> samples,
+         FeatureLayout layout) -> py::array_t<float> {
+        std::vector<float> out;
+        {
+          py::gil_scoped_release release;
+          ComputeWhisperLogMel(opts, samples.data(), samples.size(), &out,
+                               layout);
+        }
+
+        py::array_t<float> ans =
+            NewFeatureArray(layout, kWhisperNumFrames, opts.dim);
+        std::copy(out.begin(), out.end(), ans.mutable_data());
+        return ans;
+      },
+      py::arg("opts"), py::arg("samples"),
+      py::arg("layout") = FeatureLayout::kFeatureMajor);
+}
+
+static void PybindWhisperChunker(py::module &m) {  // NOLINT
+  using PyClass = WhisperChunker;
+  py::class_<PyClass>(m, "WhisperChunker")
+      .def(py::init<const WhisperFeatureOptions &, int32_t>(),
+           py::arg("opts") = WhisperFeatureOptions{},
+           py::arg("stride") = kWhisperNumFrames)
+      .def_property_readonly("dim", &PyClass::Dim)
+      .def_property_readonly("stride", &PyClass::Stride)
+      .def_property_readonly("num_chunks_ready", &PyClass::NumChunksReady)
+      .def(
+          "accept_waveform",
+          [](PyClass &self, py::array_t<float, py::array::c_style> samples) {
+            const float *p = samples.data();
+            int32_t n = samples.size();
+            py::gil_scoped_release release;
+            self.AcceptWaveform(p, n);
+          },
+          py::arg("samples"))
+      .def("input_finished", &PyClass::InputFinished,
+           py::call_guard<py::gil_scoped_release>())
+      .def(
+          "get_chunk",
+          [](const PyClass &self, int32_t i,
+             FeatureLayout layout) -> py::array_t<float> {
+            std::vector<float> out;
+            {
+              py::gil_scoped_release release;
+              self.GetChunk(i, &out, layout);
+            }
+
+            py::array_t<float> ans =
+                NewFeatureArray(layout, kWhisperNumFrames, self.Dim());
+            std::copy(out.begin(), out.end(), ans.mutable_data());
+            return ans;
+          },
+          py::arg("i"), py::arg("layout") = FeatureLayout::kFeatureMajor)
+      .def("pop", &PyClass::Pop, py::arg("n"),
+           py::call_guard<py::gil_scoped_release>());
+}
+
+// float32 and float16 frames are returned as arrays of that dtype. bfloat16
+// has no numpy dtype, so its bits are returned as uint16. The array shares
+// memory with the frame and keeps base alive.
+static py::array FrameToArray(FeatureDtype dtype, const void *p, int32_t dim,
+                              py::object base) {
+  if (dtype == FeatureDtype::kFloat32) {
+    return py::array_t<float>({dim}, {sizeof(float)},
+                              static_cast<const float *>(p), base);
+  }
+
+  py::dtype t = dtype == FeatureDtype::kFloat16 ? py::dtype("float16")
+                                                : py::dtype::of<uint16_t>();
+  return py::array(t, {dim}, {sizeof(uint16_t)}, p, base);
+}
+
 template <typename C>
-void PybindOnlineFeatureTpl(py::module &m,  // NOLINT
-                            const std::string &class_name,
-                            const std::string &class_help_doc = "") {
-  using PyClass = OnlineGenericBaseFeature<C>;
+void PybindFeatureExtractorConfigTpl(py::module &m,  // NOLINT
+                                     const std::string &class_name,
+                                     const std::string &class_help_doc = "") {
+  using PyClass = FeatureExtractorConfig<C>;
   using Options = typename C::Options;
   py::class_<PyClass>(m, class_name.c_str(), class_help_doc.c_str())
-      .def(py::init<const Options &>(), py::arg("opts"))
+      .def(py::init<const Options &, const OnlineCmvnOptions &>(),
+           py::arg("opts"), py::arg("cmvn_opts") = OnlineCmvnOptions{});
+}
+
+// It returns the class so that computer specific methods can be added
+template <typename C>
+py::class_<OnlineGenericBaseFeature<C>> PybindOnlineFeatureTpl(
+    py::module &m,  // NOLINT
+    const std::string &class_name, const std::string &class_help_doc = "") {
+  using PyClass = OnlineGenericBaseFeature<C>;
+  using Options = typename C::Options;
+  return py::class_<PyClass>(m, class_name.c_str(), class_help_doc.c_str())
+      .def(py::init<const Options &, const OnlineCmvnOptions &>(),
+           py::arg("opts"), py::arg("cmvn_opts") = OnlineCmvnOptions{})
+      .def(py::init<const FeatureExtractorConfig<C> &>(), py::arg("config"))
+      .def(py::init<const FeatureExtractorConfig<C> &,
+                    const OnlineCmvnOptions &>(),
+           py::arg("config"), py::arg("cmvn_opts"))
       .def_property_readonly("dim", &PyClass::Dim)
       .def_property_readonly("frame_shift_in_seconds",
                              &PyClass::FrameShiftInSeconds)
@@ -72,14 +274,73 @@ void PybindOnlineFeatureTpl(py::module &m,  // NOLINT
           "get_frame",
           [](py::object obj, int32_t frame) {
             auto *self = obj.cast<PyClass *>();
-            const float *f = self->GetFrame(frame);
-            return py::array_t<float>({self->Dim()},    // shape
-                                      {sizeof(float)},  // stride in bytes
-                                      f,                // ptr
-                                      obj);  // it will increase the reference
-                                             // count of **this** vector
+            FeatureDtype dtype = self->OutputDtype();
+            const void *p = dtype == FeatureDtype::kFloat32
+                                ? static_cast<const void *>(
+                                      self->GetFrame(frame))
+                                : self->GetHalfFrame(frame);
+            // it will increase the reference count of **this** vector
+            return FrameToArray(dtype, p, self->Dim(), obj);
           },
           py::arg("frame"))
+      .def(
+          "get_frames",
+          [](const PyClass &self, int32_t frame, int32_t n,
+             FeatureLayout layout) -> py::array_t<float> {
+            py::array_t<float> ans = NewFeatureArray(layout, n, self.Dim());
+            float *p = ans.mutable_data();
+            py::gil_scoped_release release;
+            self.GetFrames(frame, n, p, layout);
+            return ans;
+          },
+          py::arg("frame"), py::arg("n"),
+          py::arg("layout") = FeatureLayout::kFrameMajor)
+      // numpy arrays are accepted without a copy. Overloads are tried in
+      // order, so they must be registered before the one for lists.
+      .def(
+          "accept_waveform",
+          [](PyClass &self, float sampling_rate,
+             py::array_t<float, py::array::c_style> waveform) {
+            const float *p = waveform.data();
+            int32_t n = waveform.size();
+            py::gil_scoped_release release;
+            self.AcceptWaveform(sampling_rate, p, n);
+          },
+          py::arg("sampling_rate"), py::arg("waveform"))
+      .def(
+          "accept_waveform",
+          [](PyClass &self, float sampling_rate,
+             py::array_t<int16_t, py::array::c_style> waveform,
+             bool normalize) {
+            const int16_t *p = waveform.data();
+            int32_t n = waveform.size();
+            py::gil_scoped_release release;
+            self.AcceptWaveform(sampling_rate, p, n, normalize);
+          },
+          py::arg("sampling_rate"), py::arg("waveform"),
+          py::arg("normalize") = true)
+      .def(
+          "accept_waveform",
+          [](PyClass &self, float sampling_rate,
+             py::array_t<int32_t, py::array::c_style> waveform,
+             bool normalize) {
+            const int32_t *p = waveform.data();
+            int32_t n = waveform.size();
+            py::gil_scoped_release release;
+            self.AcceptWaveform(sampling_rate, p, n, normalize);
+          },
+          py::arg("sampling_rate"), py::arg("waveform"),
+          py::arg("normalize") = true)
+      .def(
+          "accept_waveform",
+          [](PyClass &self, float sampling_rate,
+             py::array_t<double, py::array::c_style> waveform) {
+            const double *p = waveform.data();
+            int32_t n = waveform.size();
+            py::gil_scoped_release release;
+            self.AcceptWaveform(sampling_rate, p, n);
+          },
+          py::arg("sampling_rate"), py::arg("waveform"))
       .def(
           "accept_waveform",
           [](PyClass &self, float sampling_rate,
@@ -95,13 +356,252 @@ void PybindOnlineFeatureTpl(py::module &m,  // NOLINT
            py::call_guard<py::gil_scoped_release>());
 }
 
+template <typename C>
+void PybindOnlineDeltaFeatureTpl(py::module &m,  // NOLINT
+                                 const std::string &class_name,
+                                 const std::string &class_help_doc = "") {
+  using PyClass = OnlineDeltaFeature<C>;
+  py::class_<PyClass>(m, class_name.c_str(), class_help_doc.c_str())
+      // src is kept alive as long as this object
+      .def(py::init<const DeltaFeaturesOptions &,
+                    const OnlineGenericBaseFeature<C> *>(),
+           py::arg("opts"), py::arg("src"), py::keep_alive<1, 3>())
+      .def_property_readonly("dim", &PyClass::Dim)
+      .def_property_readonly("frame_shift_in_seconds",
+                             &PyClass::FrameShiftInSeconds)
+      .def_property_readonly("num_frames_ready", &PyClass::NumFramesReady)
+      .def("is_last_frame", &PyClass::IsLastFrame, py::arg("frame"))
+      .def(
+          "get_frame",
+          [](py::object obj, int32_t frame) {
+            auto *self = obj.cast<PyClass *>();
+            return FrameToArray(FeatureDtype::kFloat32, self->GetFrame(frame),
+                                self->Dim(), obj);
+          },
+          py::arg("frame"))
+      .def("update", &PyClass::Update,
+           py::call_guard<py::gil_scoped_release>())
+      .def("pop", &PyClass::Pop, py::arg("n"),
+           py::call_guard<py::gil_scoped_release>());
+}
+
+template <typename C>
+void PybindOnlineLfrFeatureTpl(py::module &m,  // NOLINT
+                               const std::string &class_name,
+                               const std::string &class_help_doc = "") {
+  using PyClass = OnlineLfrFeature<C>;
+  py::class_<PyClass>(m, class_name.c_str(), class_help_doc.c_str())
+      // src is kept alive as long as this object
+      .def(py::init<const LfrOptions &, const OnlineGenericBaseFeature<C> *>(),
+           py::arg("opts"), py::arg("src"), py::keep_alive<1, 3>())
+      .def_property_readonly("dim", &PyClass::Dim)
+      .def_property_readonly("frame_shift_in_seconds",
+                             &PyClass::FrameShiftInSeconds)
+      .def_property_readonly("num_frames_ready", &PyClass::NumFramesReady)
+      .def("is_last_frame", &PyClass::IsLastFrame, py::arg("frame"))
+      .def("set_cmvn", &PyClass::SetCmvn, py::arg("neg_mean"),
+           py::arg("inv_stddev"))
+      // The frames are copied since they are moved by update() and pop()
+      .def(
+          "get_frames",
+          [](const PyClass &self, int32_t frame) -> py::array_t<float> {
+            int32_t n = self.NumFramesReady() - frame;
+            py::array_t<float> ans({n, self.Dim()});
+            const float *p = self.GetFrames(frame);
+            std::copy(p, p + static_cast<int64_t>(n) * self.Dim(),
+                      ans.mutable_data());
+            return ans;
+          },
+          py::arg("frame") = 0)
+      .def(
+          "get_frame",
+          [](const PyClass &self, int32_t frame) -> py::array_t<float> {
+            py::array_t<float> ans(self.Dim());
+            const float *p = self.GetFrame(frame);
+            std::copy(p, p + self.Dim(), ans.mutable_data());
+            return ans;
+          },
+          py::arg("frame"))
+      .def("update", &PyClass::Update,
+           py::call_guard<py::gil_scoped_release>())
+      .def("pop", &PyClass::Pop, py::arg("n"),
+           py::call_guard<py::gil_scoped_release>());
+}
+
+template <typename C>
+void PybindChunkAssemblerTpl(py::module &m,  // NOLINT
+                             const std::string &class_name,
+                             const std::string &class_help_doc = "") {
+  using PyClass = ChunkAssembler<C>;
+  py::class_<PyClass>(m, class_name.c_str(), class_help_doc.c_str())
+      // src is kept alive as long as this object
+      .def(py::init<const ChunkAssemblerOptions &,
+                    const OnlineGenericBaseFeature<C> *>(),
+           py::arg("opts"), py::arg("src"), py::keep_alive<1, 3>())
+      .def_property_readonly("dim", &PyClass::Dim)
+      .def_property_readonly("chunk_frames", &PyClass::ChunkFrames)
+      .def_property_readonly("num_chunks_ready", &PyClass::NumChunksReady)
+      .def("update", &PyClass::Update,
+           py::call_guard<py::gil_scoped_release>())
+      .def(
+          "get_chunk",
+          [](const PyClass &self, int32_t i,
+             FeatureLayout layout) -> py::array_t<float> {
+            py::array_t<float> ans =
+                NewFeatureArray(layout, self.ChunkFrames(), self.Dim());
+            float *p = ans.mutable_data();
+            py::gil_scoped_release release;
+            self.GetChunk(i, p, 0, layout);
+            return ans;
+          },
+          py::arg("i"), py::arg("layout") = FeatureLayout::kFrameMajor)
+      // Write into an existing float32 array of shape
+      // [chunk_frames, dim] or [dim, chunk_frames], e.g., a view of a
+      // larger, aligned array. Its rows need not be contiguous.
+      .def(
+          "get_chunk",
+          [](const PyClass &self, int32_t i, py::array out,
+             FeatureLayout layout) {
+            int32_t rows = self.ChunkFrames();
+            int32_t cols = self.Dim();
+            if (layout == FeatureLayout::kFeatureMajor) {
+              std::swap(rows, cols);
+            }
+
+            if (!out.dtype().is(py::dtype::of<float>()) || out.ndim() != 2 ||
+                out.shape(0) != rows || out.shape(1) != cols ||
+                out.strides(1) != sizeof(float) ||
+                out.strides(0) % sizeof(float) != 0 || !out.writeable()) {
+              throw py::value_error(
+                  "Expect a writeable float32 array of shape [" +
+                  std::to_string(rows) + ", " + std::to_string(cols) +
+                  "] with contiguous rows");
+            }
+
+            float *p = static_cast<float *>(out.mutable_data());
+            int32_t stride = out.strides(0) / sizeof(float);
+            py::gil_scoped_release release;
+            self.GetChunk(i, p, stride, layout);
+          },
+          py::arg("i"), py::arg("out"),
+          py::arg("layout") = FeatureLayout::kFrameMajor)
+      .def("pop", &PyClass::Pop, py::arg("n"),
+           py::call_guard<py::gil_scoped_release>());
+}
+
+template <typename C>
+void PybindMultiStreamOnlineFeatureTpl(py::module &m,  // NOLINT
+                                       const std::string &class_name,
+                                       const std::string &class_help_doc = "") {
+  using PyClass = MultiStreamOnlineFeature<C>;
+  using Options = typename C::Options;
+  py::class_<PyClass>(m, class_name.c_str(), class_help_doc.c_str())
+      .def(py::init<const Options &, int32_t>(), py::arg("opts"),
+           py::arg("num_streams") = 0)
+      .def(py::init<const FeatureExtractorConfig<C> &, int32_t>(),
+           py::arg("config"), py::arg("num_streams") = 0)
+      .def_property_readonly("dim", &PyClass::Dim)
+      .def_property_readonly("frame_shift_in_seconds",
+                             &PyClass::FrameShiftInSeconds)
+      .def_property_readonly("num_streams", &PyClass::NumStreams)
+      .def("add_stream", &PyClass::AddStream)
+      .def("remove_stream", &PyClass::RemoveStream, py::arg("stream_id"))
+      .def("num_frames_ready", &PyClass::NumFramesReady, py::arg("stream_id"))
+      .def("is_last_frame", &PyClass::IsLastFrame, py::arg("stream_id"),
+           py::arg("frame"))
+      .def(
+          "get_frame",
+          [](py::object obj, int32_t stream_id, int32_t frame) {
+            auto *self = obj.cast<PyClass *>();
+            FeatureDtype dtype = self->OutputDtype();
+            const void *p = dtype == FeatureDtype::kFloat32
+                                ? static_cast<const void *>(
+                                      self->GetFrame(stream_id, frame))
+                                : self->GetHalfFrame(stream_id, frame);
+            return FrameToArray(dtype, p, self->Dim(), obj);
+          },
+          py::arg("stream_id"), py::arg("frame"))
+      .def(
+          "accept_waveform",
+          [](PyClass &self, int32_t stream_id, float sampling_rate,
+             const std::vector<float> &waveform) {
+            self.AcceptWaveform(stream_id, sampling_rate, waveform.data(),
+                                waveform.size());
+          },
+          py::arg("stream_id"), py::arg("sampling_rate"), py::arg("waveform"))
+      .def("input_finished", &PyClass::InputFinished, py::arg("stream_id"))
+      .def("compute_ready", &PyClass::ComputeReady,
+           py::call_guard<py::gil_scoped_release>())
+      .def("pop", &PyClass::Pop, py::arg("stream_id"), py::arg("n"));
+}
+
 void PybindOnlineFeature(py::module &m) {  // NOLINT
+  PybindFeatureLayout(m);
+  PybindOnlineCmvnOptions(m);
+
+  PybindFeatureExtractorConfigTpl<FbankComputer>(m, "FbankExtractorConfig");
+  PybindFeatureExtractorConfigTpl<MfccComputer>(m, "MfccExtractorConfig");
+  PybindFeatureExtractorConfigTpl<SpectrogramComputer>(
+      m, "SpectrogramExtractorConfig");
+
   PybindOnlineFeatureTpl<FbankComputer>(m, "OnlineFbank");
   PybindOnlineFeatureTpl<MfccComputer>(m, "OnlineMfcc");
+  PybindOnlineFeatureTpl<SpectrogramComputer>(m, "OnlineSpectrogram");
+
+  PybindDeltaFeaturesOptions(m);
+  PybindOnlineDeltaFeatureTpl<FbankComputer>(m, "OnlineDeltaFbank");
+  PybindOnlineDeltaFeatureTpl<MfccComputer>(m, "OnlineDeltaMfcc");
+
+  PybindLfrOptions(m);
+  PybindOnlineLfrFeatureTpl<FbankComputer>(m, "OnlineLfrFbank");
+  PybindOnlineLfrFeatureTpl<MfccComputer>(m, "OnlineLfrMfcc");
+
+  PybindChunkAssemblerOptions(m);
+  PybindChunkAssemblerTpl<FbankComputer>(m, "FbankChunkAssembler");
+  PybindChunkAssemblerTpl<MfccComputer>(m, "MfccChunkAssembler");
 
   PybindWhisperFeatureOptions(m);
+  PybindWhisperLogMel(m);
+  PybindWhisperChunker(m);
 
+  PybindFeatureExtractorConfigTpl<WhisperFeatureComputer>(
+      m, "WhisperFbankExtractorConfig");
   PybindOnlineFeatureTpl<WhisperFeatureComputer>(m, "OnlineWhisperFbank");
+
+  PybindMultiFeatureOptions(m);
+  PybindFeatureExtractorConfigTpl<MultiFeatureComputer>(
+      m, "MultiFeatureExtractorConfig");
+  using PyClass = OnlineMultiFeature;
+  PybindOnlineFeatureTpl<MultiFeatureComputer>(m, "OnlineMultiFeature")
+      .def_property_readonly("num_heads",
+                             [](const PyClass &self) {
+                               return self.GetComputer().NumHeads();
+                             })
+      .def(
+          "head_offset",
+          [](const PyClass &self, int32_t i) {
+            if (i < 0 || i >= self.GetComputer().NumHeads()) {
+              throw py::index_error("Invalid head index: " +
+                                    std::to_string(i));
+            }
+            return self.GetComputer().HeadOffset(i);
+          },
+          py::arg("i"))
+      .def(
+          "head_dim",
+          [](const PyClass &self, int32_t i) {
+            if (i < 0 || i >= self.GetComputer().NumHeads()) {
+              throw py::index_error("Invalid head index: " +
+                                    std::to_string(i));
+            }
+            return self.GetComputer().HeadDim(i);
+          },
+          py::arg("i"));
+
+  PybindMultiStreamOnlineFeatureTpl<FbankComputer>(m, "MultiStreamOnlineFbank");
+  PybindMultiStreamOnlineFeatureTpl<MfccComputer>(m, "MultiStreamOnlineMfcc");
+  PybindMultiStreamOnlineFeatureTpl<WhisperFeatureComputer>(
+      m, "MultiStreamOnlineWhisperFbank");
 }
 
 }  // namespace knf
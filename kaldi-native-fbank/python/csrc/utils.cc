@@ -47,6 +47,10 @@ FrameExtractionOptions FrameExtractionOptionsFromDict(py::dict dict) {
   FROM_DICT(bool_, round_to_power_of_two);
   FROM_DICT(float_, blackman_coeff);
   FROM_DICT(bool_, snip_edges);
+  FROM_DICT(bool_, allow_downsample);
+  FROM_DICT(bool_, allow_upsample);
+  FROM_DICT(str, accuracy);
+  FROM_DICT(str, output_dtype);
 
   return opts;
 }
@@ -64,6 +68,10 @@ py::dict AsDict(const FrameExtractionOptions &opts) {
   AS_DICT(round_to_power_of_two);
   AS_DICT(blackman_coeff);
   AS_DICT(snip_edges);
+  AS_DICT(allow_downsample);
+  AS_DICT(allow_upsample);
+  AS_DICT(accuracy);
+  AS_DICT(output_dtype);
 
   return dict;
 }
@@ -184,6 +192,7 @@ WhisperFeatureOptions WhisperFeatureOptionsFromDict(py::dict dict) {
   }
 
   FROM_DICT(int_, dim);
+  FROM_DICT(bool_, log_mel);
 
   return opts;
 }
@@ -193,6 +202,7 @@ py::dict AsDict(const WhisperFeatureOptions &opts) {
 
   dict["frame_opts"] = AsDict(opts.frame_opts);
   AS_DICT(dim);
+  AS_DICT(log_mel);
 
   return dict;
 }
@@ -1,17 +1,46 @@
 from _kaldi_native_fbank import (
+    ArkReader,
+    ArkWriter,
+    ChunkAssemblerOptions,
+    CompressionMethod,
+    DeltaFeaturesOptions,
+    FbankChunkAssembler,
+    FbankExtractorConfig,
     FbankOptions,
+    FeatureLayout,
     FeatureWindowFunction,
     FrameExtractionOptions,
     IStft,
+    LfrOptions,
     MelBanks,
     MelBanksOptions,
+    MfccChunkAssembler,
+    MfccExtractorConfig,
     MfccOptions,
+    MultiFeatureExtractorConfig,
+    MultiFeatureOptions,
+    MultiStreamOnlineFbank,
+    MultiStreamOnlineMfcc,
+    MultiStreamOnlineWhisperFbank,
+    OnlineCmvnOptions,
+    OnlineDeltaFbank,
+    OnlineDeltaMfcc,
     OnlineFbank,
+    OnlineLfrFbank,
+    OnlineLfrMfcc,
     OnlineMfcc,
+    OnlineMultiFeature,
+    OnlineSpectrogram,
     OnlineWhisperFbank,
     Rfft,
     Stft,
+    SpectrogramExtractorConfig,
+    SpectrogramOptions,
     StftConfig,
     StftResult,
+    WhisperChunker,
+    WhisperFbankExtractorConfig,
     WhisperFeatureOptions,
+    WhisperLogMelNormalizer,
+    compute_whisper_log_mel,
 )
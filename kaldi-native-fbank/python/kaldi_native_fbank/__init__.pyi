@@ -4,7 +4,7 @@ Type stubs for kaldi-native-fbank
 # Copyright (c) 2025 (authors: Bangwen He)
 """
 
-from typing import Dict, List, Union
+from typing import Dict, List, Union, overload
 import numpy as np
 
 class FbankOptions:
@@ -63,6 +63,10 @@ class FrameExtractionOptions:
     round_to_power_of_two: bool
     blackman_coeff: float
     snip_edges: bool
+    allow_downsample: bool
+    allow_upsample: bool
+    accuracy: str
+    output_dtype: str
 
     def __str__(self) -> str: ...
     def as_dict(self) -> Dict[str, Union[float, bool, str]]: ...
@@ -108,6 +112,12 @@ class MelBanksOptions:
     @staticmethod
     def from_dict(d: Dict[str, Union[int, float, bool, str]]) -> "MelBanksOptions": ...
 
+class FeatureLayout:
+    """Layout of a matrix of features."""
+
+    kFrameMajor: "FeatureLayout"  # (num_frames, dim)
+    kFeatureMajor: "FeatureLayout"  # (dim, num_frames)
+
 class WhisperFeatureOptions:
     """Whisper feature extraction options."""
 
@@ -116,16 +126,91 @@ class WhisperFeatureOptions:
     # Properties
     frame_opts: FrameExtractionOptions
     dim: int
+    log_mel: bool
 
     def __str__(self) -> str: ...
-    def as_dict(self) -> Dict[str, Union[Dict, int]]: ...
+    def as_dict(self) -> Dict[str, Union[Dict, int, bool]]: ...
     @staticmethod
-    def from_dict(d: Dict[str, Union[Dict, int]]) -> "WhisperFeatureOptions": ...
+    def from_dict(d: Dict[str, Union[Dict, int, bool]]) -> "WhisperFeatureOptions": ...
+
+class WhisperLogMelNormalizer:
+    """Second stage of Whisper log-mel features: (max(x, max - 8) + 4) / 4.
+
+    The max is updated by accept(), so it can be used for streaming.
+    """
+
+    def __init__(self) -> None: ...
+    def accept(self, x: np.ndarray) -> None: ...
+    def normalize(self, x: np.ndarray) -> np.ndarray: ...
+    def reset(self) -> None: ...
+    @property
+    def max(self) -> float: ...
+
+def compute_whisper_log_mel(
+    opts: WhisperFeatureOptions,
+    samples: np.ndarray,
+    layout: FeatureLayout = FeatureLayout.kFeatureMajor,
+) -> np.ndarray:
+    """Return Whisper's input features of shape (opts.dim, 3000) for at most
+    30 seconds of 16 kHz audio, padded with silence. The shape is
+    (3000, opts.dim) if layout is kFrameMajor."""
+    ...
+
+class WhisperChunker:
+    """Split audio of any length into chunks of shape (dim, 3000).
+
+    Chunk i covers frames [i * stride, i * stride + 3000). Frames shared by
+    overlapping chunks are computed once. Each chunk is normalized with its
+    own max.
+    """
+
+    def __init__(
+        self, opts: WhisperFeatureOptions = WhisperFeatureOptions(), stride: int = 3000
+    ) -> None: ...
+    @property
+    def dim(self) -> int: ...
+    @property
+    def stride(self) -> int: ...
+    @property
+    def num_chunks_ready(self) -> int: ...
+    def accept_waveform(self, samples: np.ndarray) -> None: ...
+    def input_finished(self) -> None: ...
+    def get_chunk(
+        self, i: int, layout: FeatureLayout = FeatureLayout.kFeatureMajor
+    ) -> np.ndarray: ...
+    def pop(self, n: int) -> None: ...
+
+class OnlineCmvnOptions:
+    """Online CMVN applied to each frame before it is stored."""
+
+    def __init__(self) -> None: ...
+
+    # Properties
+    mode: str  # none, global, prefix or sliding
+    cmn_window: int
+    normalize_variance: bool
+    global_cmvn_stats: str
+
+    def __str__(self) -> str: ...
+
+class FbankExtractorConfig:
+    """Precomputed tables shared by OnlineFbank instances created from it."""
+
+    def __init__(
+        self, opts: FbankOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
 
 class OnlineFbank:
     """Online filter bank feature extractor."""
 
-    def __init__(self, opts: FbankOptions) -> None: ...
+    @overload
+    def __init__(
+        self, opts: FbankOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+    @overload
+    def __init__(
+        self, config: FbankExtractorConfig, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
 
     @property
     def dim(self) -> int: ...
@@ -137,15 +222,48 @@ class OnlineFbank:
     def num_frames_ready(self) -> int: ...
 
     def is_last_frame(self, frame: int) -> bool: ...
-    def get_frame(self, frame: int) -> np.ndarray: ...
-    def accept_waveform(self, sampling_rate: float, waveform: List[float]) -> None: ...
+    def get_frame(self, frame: int) -> np.ndarray:
+        """The dtype is float32 or float16 following opts.frame_opts.output_dtype.
+        For bfloat16, the bits are returned as uint16."""
+    def get_frames(
+        self,
+        frame: int,
+        n: int,
+        layout: FeatureLayout = FeatureLayout.kFrameMajor,
+    ) -> np.ndarray:
+        """Frames [frame, frame + n) of shape (n, dim), or (dim, n) if layout
+        is kFeatureMajor. Only for output_dtype float32."""
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: Union[List[float], np.ndarray]
+    ) -> None: ...
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: np.ndarray, normalize: bool = True
+    ) -> None:
+        """waveform is an int16 or int32 array. If normalize is True, it is
+        divided by 32768 or 2147483648."""
     def input_finished(self) -> None: ...
     def pop(self, n: int) -> None: ...
 
+class MfccExtractorConfig:
+    """Precomputed tables shared by OnlineMfcc instances created from it."""
+
+    def __init__(
+        self, opts: MfccOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+
 class OnlineMfcc:
     """Online MFCC feature extractor."""
 
-    def __init__(self, opts: MfccOptions) -> None: ...
+    @overload
+    def __init__(
+        self, opts: MfccOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+    @overload
+    def __init__(
+        self, config: MfccExtractorConfig, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
 
     @property
     def dim(self) -> int: ...
@@ -157,15 +275,370 @@ class OnlineMfcc:
     def num_frames_ready(self) -> int: ...
 
     def is_last_frame(self, frame: int) -> bool: ...
-    def get_frame(self, frame: int) -> np.ndarray: ...
-    def accept_waveform(self, sampling_rate: float, waveform: List[float]) -> None: ...
+    def get_frame(self, frame: int) -> np.ndarray:
+        """The dtype is float32 or float16 following opts.frame_opts.output_dtype.
+        For bfloat16, the bits are returned as uint16."""
+    def get_frames(
+        self,
+        frame: int,
+        n: int,
+        layout: FeatureLayout = FeatureLayout.kFrameMajor,
+    ) -> np.ndarray:
+        """Frames [frame, frame + n) of shape (n, dim), or (dim, n) if layout
+        is kFeatureMajor. Only for output_dtype float32."""
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: Union[List[float], np.ndarray]
+    ) -> None: ...
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: np.ndarray, normalize: bool = True
+    ) -> None:
+        """waveform is an int16 or int32 array. If normalize is True, it is
+        divided by 32768 or 2147483648."""
+    def input_finished(self) -> None: ...
+    def pop(self, n: int) -> None: ...
+
+class SpectrogramOptions:
+    """Spectrogram feature extraction options."""
+
+    def __init__(self) -> None: ...
+
+    # Properties
+    frame_opts: FrameExtractionOptions
+    energy_floor: float
+    raw_energy: bool
+    use_energy: bool
+    """If True, the zeroth bin is replaced by the log energy of the frame."""
+    use_log: bool
+    high_freq: float
+    """Bins above it are not computed. 0 means the Nyquist frequency;
+    a negative value is added to the Nyquist frequency."""
+
+    def __str__(self) -> str: ...
+
+class SpectrogramExtractorConfig:
+    """Precomputed tables shared by OnlineSpectrogram instances created from it."""
+
+    def __init__(
+        self, opts: SpectrogramOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+
+class OnlineSpectrogram:
+    """Online power or log-power spectrogram, like compute-spectrogram-feats
+    of Kaldi."""
+
+    @overload
+    def __init__(
+        self, opts: SpectrogramOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+    @overload
+    def __init__(
+        self, config: SpectrogramExtractorConfig, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+
+    @property
+    def dim(self) -> int: ...
+
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+
+    @property
+    def num_frames_ready(self) -> int: ...
+
+    def is_last_frame(self, frame: int) -> bool: ...
+    def get_frame(self, frame: int) -> np.ndarray:
+        """The dtype is float32 or float16 following opts.frame_opts.output_dtype.
+        For bfloat16, the bits are returned as uint16."""
+    def get_frames(
+        self,
+        frame: int,
+        n: int,
+        layout: FeatureLayout = FeatureLayout.kFrameMajor,
+    ) -> np.ndarray:
+        """Frames [frame, frame + n) of shape (n, dim), or (dim, n) if layout
+        is kFeatureMajor. Only for output_dtype float32."""
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: Union[List[float], np.ndarray]
+    ) -> None: ...
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: np.ndarray, normalize: bool = True
+    ) -> None:
+        """waveform is an int16 or int32 array. If normalize is True, it is
+        divided by 32768 or 2147483648."""
+    def input_finished(self) -> None: ...
+    def pop(self, n: int) -> None: ...
+
+class MultiFeatureOptions:
+    """Options for OnlineMultiFeature. The heads share frame_opts; the
+    frame_opts of each element of fbank and mfcc are ignored."""
+
+    def __init__(self) -> None: ...
+
+    # Properties
+    frame_opts: FrameExtractionOptions
+    fbank: List[FbankOptions]
+    """Returned as a copy. Assign a new list instead of appending to it."""
+    mfcc: List[MfccOptions]
+    """Returned as a copy. Assign a new list instead of appending to it."""
+    use_power_spectrum: bool
+    use_energy: bool
+    raw_energy: bool
+
+    def __str__(self) -> str: ...
+
+class MultiFeatureExtractorConfig:
+    """Precomputed tables shared by OnlineMultiFeature instances created from it."""
+
+    def __init__(
+        self, opts: MultiFeatureOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+
+class OnlineMultiFeature:
+    """Several features from one window and FFT per frame.
+
+    A frame is the concatenation of the heads in the order opts.fbank,
+    opts.mfcc, the power spectrum and the energy."""
+
+    @overload
+    def __init__(
+        self, opts: MultiFeatureOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+    @overload
+    def __init__(
+        self, config: MultiFeatureExtractorConfig, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+
+    @property
+    def dim(self) -> int: ...
+
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+
+    @property
+    def num_frames_ready(self) -> int: ...
+
+    @property
+    def num_heads(self) -> int: ...
+
+    def head_offset(self, i: int) -> int: ...
+    def head_dim(self, i: int) -> int: ...
+
+    def is_last_frame(self, frame: int) -> bool: ...
+    def get_frame(self, frame: int) -> np.ndarray:
+        """The dtype is float32 or float16 following opts.frame_opts.output_dtype.
+        For bfloat16, the bits are returned as uint16."""
+    def get_frames(
+        self,
+        frame: int,
+        n: int,
+        layout: FeatureLayout = FeatureLayout.kFrameMajor,
+    ) -> np.ndarray:
+        """Frames [frame, frame + n) of shape (n, dim), or (dim, n) if layout
+        is kFeatureMajor. Only for output_dtype float32."""
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: Union[List[float], np.ndarray]
+    ) -> None: ...
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: np.ndarray, normalize: bool = True
+    ) -> None:
+        """waveform is an int16 or int32 array. If normalize is True, it is
+        divided by 32768 or 2147483648."""
     def input_finished(self) -> None: ...
     def pop(self, n: int) -> None: ...
 
+class DeltaFeaturesOptions:
+    """Options for delta features, like add-deltas in Kaldi."""
+
+    def __init__(self) -> None: ...
+
+    # Properties
+    order: int
+    window: int
+
+    def __str__(self) -> str: ...
+
+class OnlineDeltaFbank:
+    """Appends deltas to the frames of an OnlineFbank."""
+
+    def __init__(self, opts: DeltaFeaturesOptions, src: OnlineFbank) -> None: ...
+    @property
+    def dim(self) -> int: ...
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+    @property
+    def num_frames_ready(self) -> int: ...
+    def is_last_frame(self, frame: int) -> bool: ...
+    def get_frame(self, frame: int) -> np.ndarray: ...
+    def update(self) -> None:
+        """Read the new frames of src. Call it after src.accept_waveform()
+        and src.input_finished()."""
+    def pop(self, n: int) -> None: ...
+
+class OnlineDeltaMfcc:
+    """Appends deltas to the frames of an OnlineMfcc."""
+
+    def __init__(self, opts: DeltaFeaturesOptions, src: OnlineMfcc) -> None: ...
+    @property
+    def dim(self) -> int: ...
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+    @property
+    def num_frames_ready(self) -> int: ...
+    def is_last_frame(self, frame: int) -> bool: ...
+    def get_frame(self, frame: int) -> np.ndarray: ...
+    def update(self) -> None:
+        """Read the new frames of src. Call it after src.accept_waveform()
+        and src.input_finished()."""
+    def pop(self, n: int) -> None: ...
+
+class LfrOptions:
+    """Options for low frame rate features, e.g., for Paraformer."""
+
+    def __init__(self) -> None: ...
+
+    # Properties
+    lfr_m: int
+    lfr_n: int
+
+    def __str__(self) -> str: ...
+
+class OnlineLfrFbank:
+    """Stacks the frames of an OnlineFbank."""
+
+    def __init__(self, opts: LfrOptions, src: OnlineFbank) -> None: ...
+    @property
+    def dim(self) -> int: ...
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+    @property
+    def num_frames_ready(self) -> int: ...
+    def is_last_frame(self, frame: int) -> bool: ...
+    def set_cmvn(self, neg_mean: List[float], inv_stddev: List[float]) -> None:
+        """x = (x + neg_mean) * inv_stddev for each output frame."""
+    def get_frames(self, frame: int = 0) -> np.ndarray:
+        """Frames [frame, num_frames_ready) as a 2-D array."""
+    def get_frame(self, frame: int) -> np.ndarray: ...
+    def update(self) -> None:
+        """Read the new frames of src. Call it after src.accept_waveform()
+        and src.input_finished()."""
+    def pop(self, n: int) -> None: ...
+
+class OnlineLfrMfcc:
+    """Stacks the frames of an OnlineMfcc."""
+
+    def __init__(self, opts: LfrOptions, src: OnlineMfcc) -> None: ...
+    @property
+    def dim(self) -> int: ...
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+    @property
+    def num_frames_ready(self) -> int: ...
+    def is_last_frame(self, frame: int) -> bool: ...
+    def set_cmvn(self, neg_mean: List[float], inv_stddev: List[float]) -> None:
+        """x = (x + neg_mean) * inv_stddev for each output frame."""
+    def get_frames(self, frame: int = 0) -> np.ndarray:
+        """Frames [frame, num_frames_ready) as a 2-D array."""
+    def get_frame(self, frame: int) -> np.ndarray: ...
+    def update(self) -> None:
+        """Read the new frames of src. Call it after src.accept_waveform()
+        and src.input_finished()."""
+    def pop(self, n: int) -> None: ...
+
+class ChunkAssemblerOptions:
+    """Options for the input chunks of a streaming model."""
+
+    def __init__(self) -> None: ...
+
+    # Properties
+    chunk_size: int
+    left_context: int
+    padding_value: float
+
+    def __str__(self) -> str: ...
+
+class FbankChunkAssembler:
+    """Assembles the frames of an OnlineFbank into chunks."""
+
+    def __init__(self, opts: ChunkAssemblerOptions, src: OnlineFbank) -> None: ...
+    @property
+    def dim(self) -> int: ...
+    @property
+    def chunk_frames(self) -> int: ...
+    @property
+    def num_chunks_ready(self) -> int: ...
+    def update(self) -> None:
+        """Read the new frames of src. Call it after src.accept_waveform()
+        and src.input_finished()."""
+    @overload
+    def get_chunk(
+        self, i: int, layout: FeatureLayout = FeatureLayout.kFrameMajor
+    ) -> np.ndarray:
+        """Return chunk i of shape [chunk_frames, dim], or [dim, chunk_frames]
+        if layout is kFeatureMajor."""
+    @overload
+    def get_chunk(
+        self,
+        i: int,
+        out: np.ndarray,
+        layout: FeatureLayout = FeatureLayout.kFrameMajor,
+    ) -> None:
+        """Write chunk i into a float32 array of the shape above. Its rows
+        need not be contiguous."""
+    def pop(self, n: int) -> None: ...
+
+class MfccChunkAssembler:
+    """Assembles the frames of an OnlineMfcc into chunks."""
+
+    def __init__(self, opts: ChunkAssemblerOptions, src: OnlineMfcc) -> None: ...
+    @property
+    def dim(self) -> int: ...
+    @property
+    def chunk_frames(self) -> int: ...
+    @property
+    def num_chunks_ready(self) -> int: ...
+    def update(self) -> None:
+        """Read the new frames of src. Call it after src.accept_waveform()
+        and src.input_finished()."""
+    @overload
+    def get_chunk(
+        self, i: int, layout: FeatureLayout = FeatureLayout.kFrameMajor
+    ) -> np.ndarray:
+        """Return chunk i of shape [chunk_frames, dim], or [dim, chunk_frames]
+        if layout is kFeatureMajor."""
+    @overload
+    def get_chunk(
+        self,
+        i: int,
+        out: np.ndarray,
+        layout: FeatureLayout = FeatureLayout.kFrameMajor,
+    ) -> None:
+        """Write chunk i into a float32 array of the shape above. Its rows
+        need not be contiguous."""
+    def pop(self, n: int) -> None: ...
+
+class WhisperFbankExtractorConfig:
+    """Precomputed tables shared by OnlineWhisperFbank instances created from it."""
+
+    def __init__(
+        self, opts: WhisperFeatureOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+
 class OnlineWhisperFbank:
     """Online Whisper filter bank feature extractor."""
 
-    def __init__(self, opts: WhisperFeatureOptions) -> None: ...
+    @overload
+    def __init__(
+        self, opts: WhisperFeatureOptions, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
+    @overload
+    def __init__(
+        self, config: WhisperFbankExtractorConfig, cmvn_opts: OnlineCmvnOptions = ...
+    ) -> None: ...
 
     @property
     def dim(self) -> int: ...
@@ -177,11 +650,120 @@ class OnlineWhisperFbank:
     def num_frames_ready(self) -> int: ...
 
     def is_last_frame(self, frame: int) -> bool: ...
-    def get_frame(self, frame: int) -> np.ndarray: ...
-    def accept_waveform(self, sampling_rate: float, waveform: List[float]) -> None: ...
+    def get_frame(self, frame: int) -> np.ndarray:
+        """The dtype is float32 or float16 following opts.frame_opts.output_dtype.
+        For bfloat16, the bits are returned as uint16."""
+    def get_frames(
+        self,
+        frame: int,
+        n: int,
+        layout: FeatureLayout = FeatureLayout.kFrameMajor,
+    ) -> np.ndarray:
+        """Frames [frame, frame + n) of shape (n, dim), or (dim, n) if layout
+        is kFeatureMajor. Only for output_dtype float32."""
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: Union[List[float], np.ndarray]
+    ) -> None: ...
+    @overload
+    def accept_waveform(
+        self, sampling_rate: float, waveform: np.ndarray, normalize: bool = True
+    ) -> None:
+        """waveform is an int16 or int32 array. If normalize is True, it is
+        divided by 32768 or 2147483648."""
     def input_finished(self) -> None: ...
     def pop(self, n: int) -> None: ...
 
+class MultiStreamOnlineFbank:
+    """Online feature extractor for many streams computed in batches."""
+
+    @overload
+    def __init__(self, opts: FbankOptions, num_streams: int = 0) -> None: ...
+    @overload
+    def __init__(self, config: FbankExtractorConfig, num_streams: int = 0) -> None: ...
+
+    @property
+    def dim(self) -> int: ...
+
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+
+    @property
+    def num_streams(self) -> int: ...
+
+    def add_stream(self) -> int: ...
+    def remove_stream(self, stream_id: int) -> None: ...
+    def num_frames_ready(self, stream_id: int) -> int: ...
+    def is_last_frame(self, stream_id: int, frame: int) -> bool: ...
+    def get_frame(self, stream_id: int, frame: int) -> np.ndarray:
+        """See OnlineFbank.get_frame()."""
+    def accept_waveform(
+        self, stream_id: int, sampling_rate: float, waveform: List[float]
+    ) -> None: ...
+    def input_finished(self, stream_id: int) -> None: ...
+    def compute_ready(self) -> int: ...
+    def pop(self, stream_id: int, n: int) -> None: ...
+
+class MultiStreamOnlineMfcc:
+    """Online feature extractor for many streams computed in batches."""
+
+    @overload
+    def __init__(self, opts: MfccOptions, num_streams: int = 0) -> None: ...
+    @overload
+    def __init__(self, config: MfccExtractorConfig, num_streams: int = 0) -> None: ...
+
+    @property
+    def dim(self) -> int: ...
+
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+
+    @property
+    def num_streams(self) -> int: ...
+
+    def add_stream(self) -> int: ...
+    def remove_stream(self, stream_id: int) -> None: ...
+    def num_frames_ready(self, stream_id: int) -> int: ...
+    def is_last_frame(self, stream_id: int, frame: int) -> bool: ...
+    def get_frame(self, stream_id: int, frame: int) -> np.ndarray:
+        """See OnlineFbank.get_frame()."""
+    def accept_waveform(
+        self, stream_id: int, sampling_rate: float, waveform: List[float]
+    ) -> None: ...
+    def input_finished(self, stream_id: int) -> None: ...
+    def compute_ready(self) -> int: ...
+    def pop(self, stream_id: int, n: int) -> None: ...
+
+class MultiStreamOnlineWhisperFbank:
+    """Online feature extractor for many streams computed in batches."""
+
+    @overload
+    def __init__(self, opts: WhisperFeatureOptions, num_streams: int = 0) -> None: ...
+    @overload
+    def __init__(self, config: WhisperFbankExtractorConfig, num_streams: int = 0) -> None: ...
+
+    @property
+    def dim(self) -> int: ...
+
+    @property
+    def frame_shift_in_seconds(self) -> float: ...
+
+    @property
+    def num_streams(self) -> int: ...
+
+    def add_stream(self) -> int: ...
+    def remove_stream(self, stream_id: int) -> None: ...
+    def num_frames_ready(self, stream_id: int) -> int: ...
+    def is_last_frame(self, stream_id: int, frame: int) -> bool: ...
+    def get_frame(self, stream_id: int, frame: int) -> np.ndarray:
+        """See OnlineFbank.get_frame()."""
+    def accept_waveform(
+        self, stream_id: int, sampling_rate: float, waveform: List[float]
+    ) -> None: ...
+    def input_finished(self, stream_id: int) -> None: ...
+    def compute_ready(self) -> int: ...
+    def pop(self, stream_id: int, n: int) -> None: ...
+
 class Rfft:
     """Real-valued Fast Fourier Transform."""
 
@@ -237,3 +819,56 @@ class Stft:
     def compute(self, input: List[float]) -> StftResult: ...
     def __call__(self, input: List[float]) -> StftResult: ...
 
+
+class CompressionMethod:
+    """Lossy compression methods of Kaldi's CompressedMatrix."""
+
+    kAutomatic: "CompressionMethod"
+    kSpeechFeature: "CompressionMethod"
+    kTwoByteAuto: "CompressionMethod"
+    kOneByteAuto: "CompressionMethod"
+
+class ArkWriter:
+    """Write features in the binary ark format of Kaldi, with an optional
+    scp index."""
+
+    def __init__(self, ark_filename: str, scp_filename: str = "") -> None: ...
+    @overload
+    def write(self, key: str, m: np.ndarray) -> None: ...
+    @overload
+    def write(
+        self, key: str, feature: Union[OnlineFbank, OnlineMfcc, OnlineWhisperFbank]
+    ) -> None: ...
+    @overload
+    def write_compressed(
+        self,
+        key: str,
+        m: np.ndarray,
+        method: CompressionMethod = CompressionMethod.kAutomatic,
+    ) -> None: ...
+    @overload
+    def write_compressed(
+        self,
+        key: str,
+        feature: Union[OnlineFbank, OnlineMfcc, OnlineWhisperFbank],
+        method: CompressionMethod = CompressionMethod.kAutomatic,
+    ) -> None: ...
+    def close(self) -> None: ...
+    def __enter__(self) -> "ArkWriter": ...
+    def __exit__(self, *args) -> None: ...
+
+class ArkReader:
+    """Memory-mapped reader of a binary ark file of float matrices.
+
+    reader[key] returns a read-only view of the mapped file without a copy.
+    A matrix that is not aligned to 4 bytes in the file is copied once
+    into a buffer owned by the reader and the view points there.
+    A compressed matrix is decompressed into a new array instead.
+    """
+
+    def __init__(self, ark_filename: str) -> None: ...
+    def keys(self) -> List[str]: ...
+    def __len__(self) -> int: ...
+    def __contains__(self, key: str) -> bool: ...
+    def is_compressed(self, key: str) -> bool: ...
+    def __getitem__(self, key: str) -> np.ndarray: ...
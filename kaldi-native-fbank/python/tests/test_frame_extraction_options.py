@@ -19,6 +19,9 @@ def test_default():
     assert opts.round_to_power_of_two is True
     assert abs(opts.blackman_coeff - 0.42) < 1e-6
     assert opts.snip_edges is True
+    assert opts.allow_downsample is False
+    assert opts.allow_upsample is False
+    assert opts.accuracy == "exact"
 
 
 def test_set_get():
@@ -53,6 +56,18 @@ def test_set_get():
     opts.snip_edges = False
     assert opts.snip_edges is False
 
+    opts.allow_downsample = True
+    assert opts.allow_downsample is True
+
+    opts.allow_upsample = True
+    assert opts.allow_upsample is True
+
+    opts.accuracy = "fast"
+    assert opts.accuracy == "fast"
+
+    opts.output_dtype = "float16"
+    assert opts.output_dtype == "float16"
+
 
 def test_from_empty_dict():
     opts = knf.FrameExtractionOptions.from_dict({})
@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+#
+# Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+
+import os
+import tempfile
+
+import numpy as np
+
+import kaldi_native_fbank as knf
+
+
+def test_round_trip():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+    fbank = knf.OnlineFbank(opts)
+    samples = np.sin(np.arange(16000, dtype=np.float32) * 0.01)
+    fbank.accept_waveform(sampling_rate=16000, waveform=samples)
+    fbank.input_finished()
+
+    m = np.arange(6, dtype=np.float32).reshape(3, 2)
+
+    with tempfile.TemporaryDirectory() as d:
+        ark = os.path.join(d, "feats.ark")
+        scp = os.path.join(d, "feats.scp")
+        with knf.ArkWriter(ark, scp) as writer:
+            writer.write("m", m)
+            writer.write("fbank", fbank)
+
+        with open(scp) as f:
+            lines = f.read().splitlines()
+        # "m " is 2 bytes. The header is 15 bytes and m has 24 bytes.
+        assert lines == [f"m {ark}:2", f"fbank {ark}:{2 + 15 + 24 + 6}"], lines
+
+        reader = knf.ArkReader(ark)
+        assert reader.keys() == ["m", "fbank"], reader.keys()
+        assert len(reader) == 2
+        assert "m" in reader
+        assert "n" not in reader
+
+        assert np.array_equal(reader["m"], m)
+        assert not reader["m"].flags.writeable
+
+        expected = np.stack(
+            [fbank.get_frame(i) for i in range(fbank.num_frames_ready)]
+        )
+        assert np.array_equal(reader["fbank"], expected)
+
+        try:
+            reader["n"]
+            assert False, "Expect a KeyError"
+        except KeyError:
+            pass
+
+        del reader
+
+
+def test_compressed():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+    fbank = knf.OnlineFbank(opts)
+    samples = np.sin(np.arange(16000, dtype=np.float32) * 0.01)
+    fbank.accept_waveform(sampling_rate=16000, waveform=samples)
+    fbank.input_finished()
+
+    m = np.arange(6, dtype=np.float32).reshape(3, 2)
+
+    with tempfile.TemporaryDirectory() as d:
+        ark = os.path.join(d, "feats.ark")
+        with knf.ArkWriter(ark) as writer:
+            writer.write_compressed("fbank", fbank)
+            writer.write_compressed("m", m, knf.CompressionMethod.kTwoByteAuto)
+            writer.write("n", m)
+
+        reader = knf.ArkReader(ark)
+        assert reader.is_compressed("fbank")
+        assert reader.is_compressed("m")
+        assert not reader.is_compressed("n")
+
+        expected = np.stack(
+            [fbank.get_frame(i) for i in range(fbank.num_frames_ready)]
+        )
+        assert reader["fbank"].shape == expected.shape
+        assert np.abs(reader["fbank"] - expected).max() < 0.5
+
+        assert np.abs(reader["m"] - m).max() < 5 / 65535 + 1e-6
+        assert np.array_equal(reader["n"], m)
+
+        del reader
+
+
+def main():
+    test_round_trip()
+    test_compressed()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+#
+# Copyright (c)  2026  Xiaomi Corporation (authors: Fangjun Kuang)
+
+import math
+
+import kaldi_native_fbank as knf
+
+
+def generate_wave(n, freq):
+    return [math.sin(freq * i) + 0.3 * math.cos(0.37 * i) for i in range(n)]
+
+
+def main():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+    opts.mel_opts.num_bins = 80
+
+    config = knf.FbankExtractorConfig(opts)
+
+    num_streams = 3
+    waves = [generate_wave(8000 + 1000 * i, 0.01 * (i + 1)) for i in range(3)]
+
+    multi = knf.MultiStreamOnlineFbank(config, num_streams)
+    assert multi.num_streams == num_streams
+
+    for start in range(0, 10000, 1600):
+        for i in range(num_streams):
+            chunk = waves[i][start : start + 1600]
+            if chunk:
+                multi.accept_waveform(i, 16000, chunk)
+        multi.compute_ready()
+
+    for i in range(num_streams):
+        multi.input_finished(i)
+    multi.compute_ready()
+
+    for i in range(num_streams):
+        fbank = knf.OnlineFbank(config)
+        fbank.accept_waveform(16000, waves[i])
+        fbank.input_finished()
+
+        assert multi.num_frames_ready(i) == fbank.num_frames_ready
+        for f in range(fbank.num_frames_ready):
+            a = fbank.get_frame(f)
+            b = multi.get_frame(i, f)
+            assert (a == b).all(), (i, f)
+
+
+if __name__ == "__main__":
+    main()
+    print("success")
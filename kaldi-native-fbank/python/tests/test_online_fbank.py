@@ -9,6 +9,7 @@ except:
     sys.exit(0)
 
 import kaldi_native_fbank as knf
+import numpy as np
 import torch
 
 
@@ -42,7 +43,332 @@ def main():
         assert torch.allclose(f1, f2, atol=1e-3), (i, (f1 - f2).abs().max())
 
 
+def test_accept_waveform_int16():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+
+    samples = (np.random.randn(16000) * 3000).astype(np.int16)
+
+    a = knf.OnlineFbank(opts)
+    a.accept_waveform(16000, samples)
+    a.input_finished()
+
+    b = knf.OnlineFbank(opts)
+    b.accept_waveform(16000, samples.astype(np.float32) / 32768)
+    b.input_finished()
+
+    c = knf.OnlineFbank(opts)
+    c.accept_waveform(16000, samples, normalize=False)
+    c.input_finished()
+
+    d = knf.OnlineFbank(opts)
+    d.accept_waveform(16000, samples.astype(np.float64))
+    d.input_finished()
+
+    assert a.num_frames_ready == b.num_frames_ready > 0
+    for i in range(a.num_frames_ready):
+        assert np.array_equal(a.get_frame(i), b.get_frame(i)), i
+        assert np.array_equal(c.get_frame(i), d.get_frame(i)), i
+
+
+def test_output_dtype():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+
+    samples = np.random.randn(16000).astype(np.float32) * 0.1
+
+    a = knf.OnlineFbank(opts)
+    a.accept_waveform(16000, samples)
+    a.input_finished()
+
+    opts.frame_opts.output_dtype = "float16"
+    b = knf.OnlineFbank(opts)
+    b.accept_waveform(16000, samples)
+    b.input_finished()
+
+    opts.frame_opts.output_dtype = "bfloat16"
+    c = knf.OnlineFbank(opts)
+    c.accept_waveform(16000, samples)
+    c.input_finished()
+
+    assert a.num_frames_ready == b.num_frames_ready == c.num_frames_ready > 0
+    for i in range(a.num_frames_ready):
+        f = a.get_frame(i)
+        h = b.get_frame(i)
+        assert h.dtype == np.float16, h.dtype
+        assert np.array_equal(h, f.astype(np.float16)), i
+
+        # bfloat16 is returned as uint16. Decode it to float32
+        g = c.get_frame(i)
+        assert g.dtype == np.uint16, g.dtype
+        g = (g.astype(np.uint32) << 16).view(np.float32)
+        assert np.allclose(g, f, rtol=1 / 128), i
+
+
+def test_online_cmvn():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+
+    samples = np.random.randn(16000).astype(np.float32) * 0.1
+
+    a = knf.OnlineFbank(opts)
+    a.accept_waveform(16000, samples)
+    a.input_finished()
+
+    cmvn_opts = knf.OnlineCmvnOptions()
+    cmvn_opts.mode = "prefix"
+    b = knf.OnlineFbank(opts, cmvn_opts)
+    b.accept_waveform(16000, samples)
+    b.input_finished()
+
+    assert a.num_frames_ready == b.num_frames_ready > 0
+    features = np.stack([a.get_frame(i) for i in range(a.num_frames_ready)])
+
+    # Frame t minus the mean of frames [0, t]
+    for i in range(b.num_frames_ready):
+        expected = features[i] - features[: i + 1].mean(axis=0)
+        assert np.allclose(b.get_frame(i), expected, atol=1e-4), i
+
+    # Streams created from a config use its CMVN options
+    config = knf.FbankExtractorConfig(opts, cmvn_opts)
+    c = knf.OnlineFbank(config)
+    c.accept_waveform(16000, samples)
+    c.input_finished()
+    for i in range(b.num_frames_ready):
+        assert np.array_equal(c.get_frame(i), b.get_frame(i)), i
+
+
+def test_online_delta():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+
+    samples = np.random.randn(16000).astype(np.float32) * 0.1
+
+    fbank = knf.OnlineFbank(opts)
+    delta = knf.OnlineDeltaFbank(knf.DeltaFeaturesOptions(), fbank)
+    assert delta.dim == 3 * fbank.dim
+
+    features = []
+    for i in range(0, samples.size, 3200):
+        fbank.accept_waveform(16000, samples[i : i + 3200])
+        delta.update()
+        # Frames of fbank can be discarded once they are read
+        while len(features) < fbank.num_frames_ready:
+            features.append(fbank.get_frame(len(features)))
+        fbank.pop(fbank.num_frames_ready)
+    fbank.input_finished()
+    delta.update()
+
+    # Kaldi's add-deltas with order 2 and window 2
+    x = np.stack(features)
+    padded = np.pad(x, ((4, 4), (0, 0)), mode="edge")
+    w1 = np.array([-2, -1, 0, 1, 2]) / 10
+    w2 = np.convolve(w1, w1)
+    n = x.shape[0]
+    d1 = sum(w1[j] * padded[j + 2 : j + 2 + n] for j in range(5))
+    d2 = sum(w2[j] * padded[j : j + n] for j in range(9))
+    expected = np.concatenate([x, d1, d2], axis=1)
+
+    assert delta.num_frames_ready == n
+    assert delta.is_last_frame(n - 1)
+    for i in range(n):
+        assert np.allclose(delta.get_frame(i), expected[i], atol=1e-4), i
+
+
+def test_online_lfr():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+
+    samples = np.random.randn(16000).astype(np.float32) * 0.1
+
+    fbank = knf.OnlineFbank(opts)
+    lfr = knf.OnlineLfrFbank(knf.LfrOptions(), fbank)
+    assert lfr.dim == 7 * fbank.dim
+
+    features = []
+    for i in range(0, samples.size, 3200):
+        fbank.accept_waveform(16000, samples[i : i + 3200])
+        lfr.update()
+        while len(features) < fbank.num_frames_ready:
+            features.append(fbank.get_frame(len(features)))
+        fbank.pop(fbank.num_frames_ready)
+    fbank.input_finished()
+    lfr.update()
+
+    # apply_lfr() of FunASR with lfr_m 7 and lfr_n 6
+    x = np.stack(features)
+    n = x.shape[0]
+    padded = np.pad(x, ((3, 6), (0, 0)), mode="edge")
+    expected = np.stack(
+        [padded[i : i + 7].reshape(-1) for i in range(0, n, 6)]
+    )
+
+    y = lfr.get_frames()
+    assert y.shape == expected.shape, (y.shape, expected.shape)
+    assert np.array_equal(y, expected)
+    assert lfr.is_last_frame(y.shape[0] - 1)
+
+
+def test_chunk_assembler():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+
+    samples = np.random.randn(16000).astype(np.float32) * 0.1
+
+    chunk_opts = knf.ChunkAssemblerOptions()
+    chunk_opts.chunk_size = 16
+    chunk_opts.left_context = 5
+    chunk_opts.padding_value = -23
+
+    fbank = knf.OnlineFbank(opts)
+    assembler = knf.FbankChunkAssembler(chunk_opts, fbank)
+    assert assembler.chunk_frames == 21
+
+    # Rows padded to 96 floats
+    buf = np.zeros((assembler.chunk_frames, 96), dtype=np.float32)
+    out = buf[:, : assembler.dim]
+
+    features = []
+    chunks = []
+    for i in range(0, samples.size, 3200):
+        fbank.accept_waveform(16000, samples[i : i + 3200])
+        assembler.update()
+        while len(features) < fbank.num_frames_ready:
+            features.append(fbank.get_frame(len(features)))
+        fbank.pop(fbank.num_frames_ready)
+
+        while len(chunks) < assembler.num_chunks_ready:
+            assembler.get_chunk(len(chunks), out)
+            assert np.array_equal(out, assembler.get_chunk(len(chunks)))
+            chunks.append(out.copy())
+            assembler.pop(1)
+    fbank.input_finished()
+    assembler.update()
+    while len(chunks) < assembler.num_chunks_ready:
+        chunks.append(assembler.get_chunk(len(chunks)))
+        assembler.pop(1)
+
+    x = np.stack(features)
+    n = x.shape[0]
+    assert len(chunks) == (n + 15) // 16
+    padded = np.full((5 + len(chunks) * 16, x.shape[1]), -23, np.float32)
+    padded[5 : 5 + n] = x
+    for i, c in enumerate(chunks):
+        assert np.array_equal(c, padded[i * 16 : i * 16 + 21]), i
+    assert np.all(buf[:, assembler.dim :] == 0)
+
+
+def test_feature_layout():
+    opts = knf.FbankOptions()
+    opts.frame_opts.dither = 0
+
+    samples = np.random.randn(16000).astype(np.float32) * 0.1
+
+    fbank = knf.OnlineFbank(opts)
+    fbank.accept_waveform(16000, samples)
+    fbank.input_finished()
+
+    n = fbank.num_frames_ready - 2
+    x = np.stack([fbank.get_frame(i) for i in range(2, 2 + n)])
+
+    a = fbank.get_frames(2, n)
+    assert np.array_equal(a, x)
+
+    b = fbank.get_frames(2, n, knf.FeatureLayout.kFeatureMajor)
+    assert b.shape == (fbank.dim, n), b.shape
+    assert np.array_equal(b, x.T)
+
+    chunk_opts = knf.ChunkAssemblerOptions()
+    chunk_opts.chunk_size = 20
+    assembler = knf.FbankChunkAssembler(chunk_opts, fbank)
+    assembler.update()
+
+    # Rows padded to 32 floats
+    buf = np.zeros((fbank.dim, 32), dtype=np.float32)
+    assembler.get_chunk(1, buf[:, :20], knf.FeatureLayout.kFeatureMajor)
+    assert np.array_equal(buf[:, :20], x[18:38].T)
+    assert np.all(buf[:, 20:] == 0)
+
+
+def test_multi_feature():
+    samples = np.random.randn(16000).astype(np.float32) * 0.1
+
+    fbank_opts = knf.FbankOptions()
+    fbank_opts.frame_opts.dither = 0
+    fbank_opts.mel_opts.num_bins = 80
+
+    mfcc_opts = knf.MfccOptions()
+    mfcc_opts.frame_opts.dither = 0
+
+    opts = knf.MultiFeatureOptions()
+    opts.frame_opts.dither = 0
+    opts.fbank = [fbank_opts]
+    opts.mfcc = [mfcc_opts]
+    opts.use_power_spectrum = True
+
+    multi = knf.OnlineMultiFeature(opts)
+    multi.accept_waveform(16000, samples)
+    multi.input_finished()
+    assert multi.num_heads == 3
+    assert multi.dim == 80 + 13 + 257, multi.dim
+
+    for h, cls, o in [(0, knf.OnlineFbank, fbank_opts), (1, knf.OnlineMfcc, mfcc_opts)]:
+        f = cls(o)
+        f.accept_waveform(16000, samples)
+        f.input_finished()
+        assert f.num_frames_ready == multi.num_frames_ready > 0
+        assert multi.head_dim(h) == f.dim
+
+        a = multi.get_frames(0, multi.num_frames_ready)
+        offset = multi.head_offset(h)
+        for i in range(f.num_frames_ready):
+            assert np.array_equal(a[i, offset : offset + f.dim], f.get_frame(i)), (h, i)
+
+
+def test_online_spectrogram():
+    opts = knf.SpectrogramOptions()
+    opts.frame_opts.dither = 0
+    opts.use_energy = False
+    opts.use_log = False
+
+    samples = np.random.randn(16000).astype(np.float32) * 0.1
+
+    spectrogram = knf.OnlineSpectrogram(opts)
+    spectrogram.accept_waveform(16000, samples)
+    spectrogram.input_finished()
+    assert spectrogram.dim == 257, spectrogram.dim
+
+    # Bins up to 4000 Hz
+    opts.high_freq = 4000
+    limited = knf.OnlineSpectrogram(opts)
+    limited.accept_waveform(16000, samples)
+    limited.input_finished()
+    assert limited.dim == 129, limited.dim
+
+    window = np.hanning(400) ** 0.85  # povey window
+    shift = 160
+    for i in range(spectrogram.num_frames_ready):
+        x = samples[i * shift : i * shift + 400].astype(np.float64)
+        x = x - x.mean()
+        x = np.append(x[0] - 0.97 * x[0], x[1:] - 0.97 * x[:-1]) * window
+        expected = np.abs(np.fft.rfft(x, n=512)) ** 2
+
+        y = spectrogram.get_frame(i)
+        assert np.allclose(y, expected, rtol=1e-3, atol=1e-5 * expected.max()), i
+        assert np.array_equal(limited.get_frame(i), y[:129]), i
+
+
 if __name__ == "__main__":
     torch.manual_seed(20220825)
+    np.random.seed(20220825)
     main()
+    test_accept_waveform_int16()
+    test_output_dtype()
+    test_online_cmvn()
+    test_online_delta()
+    test_online_lfr()
+    test_chunk_assembler()
+    test_feature_layout()
+    test_multi_feature()
+    test_online_spectrogram()
     print("success")
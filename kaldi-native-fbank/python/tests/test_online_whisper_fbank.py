@@ -5,6 +5,7 @@
 import pickle
 
 import kaldi_native_fbank as knf
+import numpy as np
 import torch
 
 
@@ -43,8 +44,76 @@ def test():
     # Now you can input 'mel' to whisper.encoder model
 
 
+def test_compute_whisper_log_mel():
+    opts = knf.WhisperFeatureOptions()
+    opts.dim = 80
+
+    audio = torch.rand(100000) - 0.5
+
+    # Reference: pad to 30 seconds and post-process in torch
+    padded = torch.nn.functional.pad(audio, (0, 480000 - audio.numel()))
+    online_whisper_fbank = knf.OnlineWhisperFbank(opts)
+    online_whisper_fbank.accept_waveform(sampling_rate=16000, waveform=padded.numpy())
+    online_whisper_fbank.input_finished()
+    assert online_whisper_fbank.num_frames_ready == 3000
+
+    features = [
+        torch.from_numpy(online_whisper_fbank.get_frame(i)) for i in range(3000)
+    ]
+    features = torch.stack(features)
+    log_spec = torch.clamp(features, min=1e-10).log10()
+    log_spec = torch.maximum(log_spec, log_spec.max() - 8.0)
+    expected = ((log_spec + 4.0) / 4.0).t()
+
+    mel = torch.from_numpy(knf.compute_whisper_log_mel(opts, audio.numpy()))
+    assert mel.shape == (opts.dim, 3000), mel.shape
+    assert torch.allclose(mel, expected, atol=1e-5), (mel - expected).abs().max()
+
+    # Streaming, with log_mel = True
+    opts.log_mel = True
+    online_whisper_fbank = knf.OnlineWhisperFbank(opts)
+    online_whisper_fbank.accept_waveform(sampling_rate=16000, waveform=padded.numpy())
+    online_whisper_fbank.input_finished()
+
+    normalizer = knf.WhisperLogMelNormalizer()
+    frames = []
+    for i in range(online_whisper_fbank.num_frames_ready):
+        f = online_whisper_fbank.get_frame(i)
+        normalizer.accept(f)
+        frames.append(f)
+
+    streaming = torch.from_numpy(normalizer.normalize(np.stack(frames))).t()
+    assert torch.allclose(streaming, expected, atol=1e-5)
+
+
+def test_whisper_chunker():
+    opts = knf.WhisperFeatureOptions()
+    opts.dim = 80
+
+    # 35 seconds with a stride of 10 seconds
+    audio = (torch.rand(16000 * 35) - 0.5).numpy()
+    chunker = knf.WhisperChunker(opts, stride=1000)
+    chunker.accept_waveform(audio[:100000])
+    assert chunker.num_chunks_ready == 0
+
+    chunker.accept_waveform(audio[100000:])
+    chunker.input_finished()
+    assert chunker.num_chunks_ready == 2
+
+    chunk = chunker.get_chunk(0)
+    assert chunk.shape == (opts.dim, 3000), chunk.shape
+
+    # Frame 0 of chunk 1 sees the audio before 10 seconds instead of the
+    # reflection
+    expected = knf.compute_whisper_log_mel(opts, audio[160000:])
+    chunk = chunker.get_chunk(1)
+    assert np.allclose(chunk[:, 1:], expected[:, 1:], atol=1e-5)
+
+
 def main():
     test()
+    test_compute_whisper_log_mel()
+    test_whisper_chunker()
 
 
 if __name__ == "__main__":